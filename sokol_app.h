@@ -53,6 +53,9 @@
     On Linux, SOKOL_GLCORE33 can use either GLX or EGL.
     GLX is default, set SOKOL_FORCE_EGL to override.
 
+    On Linux, define SOKOL_LINUX_FORCE_HEADLESS to always run in headless
+    mode without a window (see HEADLESS MODE below).
+
     For example code, see https://github.com/floooh/sokol-samples/tree/master/sapp
 
     Portions of the Windows and Linux GL initialization, event-, icon- etc... code
@@ -123,8 +126,8 @@
     RESTORED            | YES     | YES   | YES   | ---   | ---     | YES  | ---
     FOCUSED             | YES     | YES   | YES   | ---   | ---     | ---  | YES
     UNFOCUSED           | YES     | YES   | YES   | ---   | ---     | ---  | YES
-    SUSPENDED           | ---     | ---   | ---   | YES   | YES     | YES  | TODO
-    RESUMED             | ---     | ---   | ---   | YES   | YES     | YES  | TODO
+    SUSPENDED           | ---     | ---   | YES(3)| YES   | YES     | YES  | TODO
+    RESUMED             | ---     | ---   | YES(3)| YES   | YES     | YES  | TODO
     QUIT_REQUESTED      | YES     | YES   | YES   | ---   | ---     | ---  | YES
     IME                 | TODO    | TODO? | TODO  | ???   | TODO    | ---  | ???
     key repeat flag     | YES     | YES   | YES   | ---   | ---     | YES  | YES
@@ -143,6 +146,7 @@
 
     (1) macOS has no regular window icons, instead the dock icon is changed
     (2) supported with EGL only (not GLX)
+    (3) only with sapp_desc.suspend_when_hidden (see SUSPEND WHEN HIDDEN)
 
     STEP BY STEP
     ============
@@ -255,6 +259,11 @@
             Returns the frame duration in seconds averaged over a number of
             frames to smooth out any jittering spikes.
 
+        sapp_frame_stats sapp_query_frame_stats(void)
+            Returns statistics over the raw, unfiltered frame durations
+            (percentiles, hitch counters and the most recent durations),
+            see FRAME STATISTICS below.
+
         int sapp_color_format(void)
         int sapp_depth_format(void)
             The color and depth-stencil pixelformats of the default framebuffer,
@@ -1010,6 +1019,224 @@
             doesn't matter if the application is started from the command
             line or via double-click.
 
+    FRAME STATISTICS
+    ================
+    sapp_frame_duration() returns a smoothed average which ignores outliers,
+    this is the right value for animations, but it hides frame time spikes.
+    To find out about hitches, call sapp_query_frame_stats(), this returns
+    a sapp_frame_stats struct with statistics over all measured frame
+    durations (in seconds) since the application started:
+
+        - num_frames: the number of measured frame durations
+        - avg, min, max: the unfiltered average, shortest and longest frame duration
+        - p50, p95, p99: the median, 95th and 99th percentile frame duration,
+          these are computed from a histogram and are accurate to about 1%
+        - num_hitches_1_5x, num_hitches_2x: the number of frames which took
+          longer than 1.5x and 2x the smoothed frame duration at that time
+          (for instance a frame which took 2x the smoothed duration
+          missed at least one display refresh)
+        - num_hitches_100ms: the number of frames which took longer than
+          100 milliseconds
+        - num_recent and recent[]: the most recent raw frame durations (up to
+          SAPP_MAX_FRAME_STATS_SAMPLES), oldest first, for instance to draw
+          a frame time graph
+
+    Call sapp_reset_frame_stats() to start over, for instance after loading
+    a level, or to measure a specific part of a benchmark.
+
+    The statistics are recorded on all platforms where sapp_frame_duration()
+    measures the frame time. Since the sapp_frame_stats struct is fairly
+    big (about 1.1 KBytes), don't call sapp_query_frame_stats() more often
+    than needed.
+
+    COALESCED MOUSE EVENTS
+    ======================
+    High-frequency mice and touchpads can generate dozens of mouse-move
+    and scroll events per frame. On Linux, set sapp_desc.coalesce_mouse_events
+    to true to merge them into fewer events:
+
+        - consecutive SAPP_EVENTTYPE_MOUSE_MOVE events with the same modifier
+          keys are merged into a single event, the mouse_dx/mouse_dy values
+          of the merged event are the sum of all merged events, and
+          mouse_x/mouse_y is the latest mouse position
+        - consecutive SAPP_EVENTTYPE_MOUSE_SCROLL events with the same
+          modifier keys are merged into a single event with the sum of
+          all scroll_x/scroll_y values
+        - sapp_event.num_coalesced contains the number of merged input samples
+
+    The relative order of events is preserved. Any other event (for instance
+    a mouse button, key or resize event) first sends the pending merged
+    event. All pending events are sent at the latest before the frame
+    callback is called, so there is at most one merged mouse move or scroll
+    event between two other events.
+
+    RENDER ON DEMAND
+    ================
+    By default, sokol_app.h calls the frame callback continuously, usually
+    synchronized with the display refresh rate. Tool-style applications
+    which only need to update their display when something happens can
+    set sapp_desc.render_on_demand to true (currently only on Linux/X11,
+    ignored on other platforms and in headless mode). In this mode the
+    application thread goes to sleep after the frame callback, and a new
+    frame is only rendered when:
+
+        - any window system event arrives (input, resize, expose, focus, ...)
+        - sapp_request_redraw() is called, this function may be called from
+          any thread (for instance from a thread which finished loading data)
+        - the delay given to sapp_request_redraw_after(seconds) has elapsed,
+          this is useful for animations or blinking text cursors, and must
+          be called from the main thread
+
+    A pending sapp_request_redraw_after() is cleared when the next frame
+    is rendered for any other reason. If an animation is still running, call
+    sapp_request_redraw_after() again from the frame callback.
+    The first frame is always rendered. While the application sleeps,
+    the time isn't included in the frame duration returned by
+    sapp_frame_duration().
+
+    The benchmark tests/bench/sokol_app_ondemand_bench.c measures the CPU
+    time and the number of context switches of an idle application with and
+    without render-on-demand (for instance under Xvfb).
+
+    SUSPEND WHEN HIDDEN
+    ===================
+    By default, sokol_app.h keeps rendering at full speed while the window is
+    minimized or covered by other windows. On Linux/X11, set
+    sapp_desc.suspend_when_hidden to true to stop wasting CPU and GPU time
+    in that case (for instance when many application instances run on the
+    same machine). The window is considered hidden when it is:
+
+        - iconified (minimized)
+        - unmapped (for instance moved to another virtual desktop by some
+          window managers)
+        - fully obscured by other windows (note that with a compositing
+          window manager, windows are usually never reported as obscured)
+
+    When the window becomes hidden, a SAPP_EVENTTYPE_SUSPENDED event is sent,
+    and the frame callback is no longer called. When the window becomes
+    visible again, a SAPP_EVENTTYPE_RESUMED event is sent, and rendering
+    continues. Set sapp_desc.background_frame_rate to a value in Hz to
+    keep calling the frame callback at a low rate while suspended (for
+    instance to keep network connections alive), the default (0) means
+    that no frame callbacks are called at all. Window system events are
+    still handled while suspended. The time spent suspended isn't included
+    in the frame duration returned by sapp_frame_duration(). Redraw requests
+    (see RENDER ON DEMAND) are ignored while suspended.
+
+    EVENT RECORDING AND REPLAY
+    ==========================
+    To reproduce problems (or performance measurements) which depend on
+    user input, sokol_app.h can record all events into a file and replay
+    them later:
+
+        - set sapp_desc.record_events_path to a file path, and every event
+          which is passed to the event callback is written to that file,
+          together with the frame index (sapp_event.frame_count) and a
+          timestamp
+        - set sapp_desc.replay_events_path to a previously recorded file,
+          and the recorded events are passed to the event callback right
+          before the frame callback of the same frame index as during
+          recording. Live input events are ignored during replay (except
+          SAPP_EVENTTYPE_QUIT_REQUESTED). Replay ends with the last recorded
+          frame, after that live input events are passed through again.
+          sapp_is_replaying() returns true while replay is in progress.
+        - set sapp_desc.fixed_frame_duration to a value in seconds to pin the
+          return value of sapp_frame_duration(), so that animations which
+          depend on the frame duration advance the same way in every run
+
+    Replay is only deterministic if the application behaves deterministically
+    for the same sequence of events and frame durations. Together with
+    headless mode (see HEADLESS MODE) or Xvfb this allows repeatable
+    benchmarks of interactive workloads. In render-on-demand mode, frames
+    are rendered continuously during replay.
+
+    The file format is a simple binary format in native byte order: an 8-byte
+    magic number 'SAPPEVT1', followed by one fixed-size record per event, touch
+    events are followed by their touch points. A record of type
+    SAPP_EVENTTYPE_INVALID marks the end of a recording and contains the
+    number of recorded frames. Files aren't supported on the web
+    platform, both paths are ignored there.
+
+    RENDER THREAD
+    =============
+    On Linux/X11, set sapp_desc.render_thread to true to separate event
+    handling from rendering. The main thread only runs the X11 event loop, and
+    translates X11 events into sapp_event structs. It pushes those
+    into a lock-free queue. A separate render thread owns the GL context.
+    It calls the init-, frame- and cleanup-callbacks and swaps
+    the buffers. Before each frame it pops all queued events from the
+    queue and calls the event callback with them. The
+    order of events is preserved. A blocking buffer swap doesn't delay event
+    handling, and a burst of X11 events doesn't delay rendering.
+
+    Things to keep in mind:
+
+        - all callbacks (init, frame, event, cleanup) are called on the
+          render thread, so from the application's point of view, the
+          render thread is the 'main thread'
+        - the sapp_* functions which change window state may be called
+          from the render thread. Most of them (for instance
+          sapp_set_window_title() or sapp_set_clipboard_string()) call into
+          the X11 library right away, which is initialized with XInitThreads().
+          sapp_lock_mouse(), sapp_show_mouse() and sapp_toggle_fullscreen()
+          share state with the X11 event handling, those requests are handed
+          over to the main thread and executed there. This means that
+          sapp_mouse_locked(), sapp_mouse_shown() and sapp_is_fullscreen()
+          may return the old state for a short time after the call
+        - values which are changed by X11 events (for instance the window
+          size returned by sapp_width()/sapp_height()) may change while
+          the frame callback is running. Use the values stored in the
+          sapp_event struct if you need the state at the time of an event
+        - if the event queue is full (256 events), the main thread wakes
+          up the render thread and waits until it catches up
+        - the file paths of a drag'n'drop operation are handed over to the
+          render thread together with the SAPP_EVENTTYPE_FILES_DROPPED event,
+          a following drop operation waits until the render thread has
+          received the previous one
+        - render-on-demand mode works as usual, window system events
+          wake up the render thread
+        - while the window is hidden in suspend-when-hidden mode, the
+          render thread doesn't render but keeps calling the event callback
+        - the option is ignored in headless mode
+
+    HEADLESS MODE
+    =============
+    On Linux, sokol_app.h can run without any display connection and without
+    a window, for instance on GPU-less servers or in CI pipelines. The
+    init-, frame-, event- and cleanup-callbacks are called exactly like
+    in a windowed application, so that the same sokol_main() code can be
+    used for interactive and headless runs.
+
+    Headless mode is activated by setting sapp_desc.headless to true, or
+    for all applications by compiling the sokol_app.h implementation with
+    SOKOL_LINUX_FORCE_HEADLESS defined (in that case sapp_desc.headless
+    doesn't need to be set).
+
+    In headless mode:
+
+        - With EGL (SOKOL_GLES2, SOKOL_GLES3 or SOKOL_GLCORE33 with
+          SOKOL_FORCE_EGL), an offscreen GL context is created which
+          renders into an EGL pbuffer surface of the size sapp_desc.width
+          and sapp_desc.height (default 640 x 480). The EGL display is
+          obtained via the EGL_MESA_platform_surfaceless extension if
+          available (e.g. Mesa's llvmpipe software rasterizer or a
+          render-node GPU driver), otherwise from EGL_DEFAULT_DISPLAY.
+        - With GLX (SOKOL_GLCORE33 without SOKOL_FORCE_EGL), no GL context
+          is created, this is only useful together with sokol_gfx.h's
+          dummy backend (SOKOL_DUMMY_BACKEND).
+        - No input events are generated, functions which manipulate the
+          window or mouse cursor are silently ignored, sapp_dpi_scale()
+          returns 1.0. Quitting works as usual via sapp_request_quit() or
+          sapp_quit().
+        - By default, frames run as fast as possible. Set
+          sapp_desc.headless_frame_rate to a frame rate in Hz to pace the
+          frame loop at a fixed rate instead (for instance to emulate
+          a 60Hz display). If a frame takes longer than the frame duration,
+          the frame loop doesn't try to catch up.
+
+    Note that the X11 libraries still need to be linked, but no X server
+    is required.
+
     MEMORY ALLOCATION OVERRIDE
     ==========================
     You can override the memory allocation functions at initialization time
@@ -1104,6 +1331,7 @@ enum {
     SAPP_MAX_MOUSEBUTTONS = 3,
     SAPP_MAX_KEYCODES = 512,
     SAPP_MAX_ICONIMAGES = 8,
+    SAPP_MAX_FRAME_STATS_SAMPLES = 128,
 };
 
 /*
@@ -1341,6 +1569,7 @@ typedef struct sapp_event {
     float mouse_dy;                     // relative vertical mouse movement since last frame, always valid
     float scroll_x;                     // horizontal mouse wheel scroll distance, valid in MOUSE_SCROLL events
     float scroll_y;                     // vertical mouse wheel scroll distance, valid in MOUSE_SCROLL events
+    int num_coalesced;                  // number of input samples merged into this event, valid in MOUSE_MOVE and MOUSE_SCROLL with sapp_desc.coalesce_mouse_events
     int num_touches;                    // number of valid items in the touches[] array
     sapp_touchpoint touches[SAPP_MAX_TOUCHPOINTS];  // current touch points, valid in TOUCHES_BEGIN, TOUCHES_MOVED, TOUCHES_ENDED
     int window_width;                   // current window- and framebuffer sizes in pixels, always valid
@@ -1424,6 +1653,28 @@ typedef struct sapp_allocator {
     void* user_data;
 } sapp_allocator;
 
+/*
+    sapp_frame_stats
+
+    Statistics over the raw frame durations, returned by sapp_query_frame_stats().
+    All durations are in seconds. See the documentation section
+    FRAME STATISTICS for details.
+*/
+typedef struct sapp_frame_stats {
+    uint64_t num_frames;            // number of measured frame durations since start or sapp_reset_frame_stats()
+    double avg;                     // unfiltered average frame duration
+    double min;                     // shortest frame duration
+    double max;                     // longest frame duration
+    double p50;                     // median frame duration
+    double p95;                     // 95th percentile frame duration
+    double p99;                     // 99th percentile frame duration
+    uint64_t num_hitches_1_5x;      // number of frames longer than 1.5x the smoothed frame duration
+    uint64_t num_hitches_2x;        // number of frames longer than 2x the smoothed frame duration (at least one missed refresh)
+    uint64_t num_hitches_100ms;     // number of frames longer than 100 milliseconds
+    int num_recent;                 // number of valid items in recent[]
+    double recent[SAPP_MAX_FRAME_STATS_SAMPLES];    // the most recent raw frame durations, oldest first
+} sapp_frame_stats;
+
 typedef struct sapp_desc {
     void (*init_cb)(void);                  // these are the user-provided callbacks without user data
     void (*frame_cb)(void);
@@ -1467,6 +1718,16 @@ typedef struct sapp_desc {
     bool html5_premultiplied_alpha;     // HTML5 only: whether the rendered pixels use premultiplied alpha convention
     bool html5_ask_leave_site;          // initial state of the internal html5_ask_leave_site flag (see sapp_html5_ask_leave_site())
     bool ios_keyboard_resizes_canvas;   // if true, showing the iOS keyboard shrinks the canvas
+    bool headless;                      // Linux only: run without a window and display (see HEADLESS MODE)
+    bool coalesce_mouse_events;         // Linux only: merge consecutive mouse move and scroll events within a frame (see COALESCED MOUSE EVENTS)
+    bool render_on_demand;              // Linux only: only call the frame callback after events or redraw requests (see RENDER ON DEMAND)
+    bool render_thread;                 // Linux only: call the init, frame, event and cleanup callbacks on a separate render thread (see RENDER THREAD)
+    bool suspend_when_hidden;           // Linux only: throttle frame callbacks while the window is minimized or obscured (see SUSPEND WHEN HIDDEN)
+    int background_frame_rate;          // frame rate in Hz while suspended, 0 means no frame callbacks at all (default)
+    const char* record_events_path;     // if set, record all events into this file (see EVENT RECORDING AND REPLAY)
+    const char* replay_events_path;     // if set, replay the events from this file instead of live input events
+    double fixed_frame_duration;        // if > 0.0, sapp_frame_duration() always returns this value (in seconds)
+    int headless_frame_rate;            // headless mode: fixed frame rate in Hz, 0 means free-running (default)
 } sapp_desc;
 
 /* HTML5 specific: request and response structs for
@@ -1575,6 +1836,16 @@ SOKOL_APP_API_DECL void sapp_consume_event(void);
 SOKOL_APP_API_DECL uint64_t sapp_frame_count(void);
 /* get an averaged/smoothed frame duration in seconds */
 SOKOL_APP_API_DECL double sapp_frame_duration(void);
+/* get statistics over the raw frame durations (percentiles, hitches, recent samples) */
+SOKOL_APP_API_DECL sapp_frame_stats sapp_query_frame_stats(void);
+/* reset the frame statistics */
+SOKOL_APP_API_DECL void sapp_reset_frame_stats(void);
+/* return true while events are replayed from sapp_desc.replay_events_path */
+SOKOL_APP_API_DECL bool sapp_is_replaying(void);
+/* render-on-demand mode: request a new frame (may be called from any thread) */
+SOKOL_APP_API_DECL void sapp_request_redraw(void);
+/* render-on-demand mode: request a new frame after a delay in seconds */
+SOKOL_APP_API_DECL void sapp_request_redraw_after(double seconds);
 /* write string into clipboard */
 SOKOL_APP_API_DECL void sapp_set_clipboard_string(const char* str);
 /* read string from clipboard (usually during SAPP_EVENTTYPE_CLIPBOARD_PASTED) */
@@ -1672,6 +1943,7 @@ inline void sapp_run(const sapp_desc& desc) { return sapp_run(&desc); }
 #include <string.h> // memset
 #include <stddef.h> // size_t
 #include <math.h>   /* roundf() */
+#include <stdio.h>  /* FILE, fopen(), used for event recording and replay */
 
 /* check if the config defines are alright */
 #if defined(__APPLE__)
@@ -1917,9 +2189,12 @@ inline void sapp_run(const sapp_desc& desc) { return sapp_run(&desc); }
         #include <EGL/egl.h>
     #endif
     #include <dlfcn.h> /* dlopen, dlsym, dlclose */
-    #include <limits.h> /* LONG_MAX */
+    #include <limits.h> /* LONG_MAX, INT_MAX */
     #include <pthread.h>    /* only used a linker-guard, search for _sapp_linux_run() and see first comment */
     #include <time.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <sys/eventfd.h>
 #endif
 
 /*== frame timing helpers ===================================================*/
@@ -2053,6 +2328,34 @@ _SOKOL_PRIVATE double _sapp_timestamp_now(_sapp_timestamp_t* ts) {
     #endif
 }
 
+/*
+    Raw frame duration statistics (see sapp_query_frame_stats()), these are
+    recorded before the outlier filter of the averaged frame duration.
+
+    Percentiles are computed from a log-linear histogram with microsecond
+    resolution: durations below 64us have one bucket per microsecond,
+    each power-of-two range above that is split into 64 linear buckets
+    (so the bucket width is at most 1/64 of its value), durations above
+    16 seconds go into the last bucket.
+*/
+#define _SAPP_FRAME_STATS_SUB_BITS (6)
+#define _SAPP_FRAME_STATS_SUB_BUCKETS (1<<_SAPP_FRAME_STATS_SUB_BITS)
+#define _SAPP_FRAME_STATS_MAX_EXP (23)
+#define _SAPP_FRAME_STATS_NUM_BUCKETS ((_SAPP_FRAME_STATS_MAX_EXP - _SAPP_FRAME_STATS_SUB_BITS + 2) * _SAPP_FRAME_STATS_SUB_BUCKETS)
+typedef struct {
+    uint64_t num;
+    double sum;
+    double min;
+    double max;
+    uint64_t num_hitches_1_5x;
+    uint64_t num_hitches_2x;
+    uint64_t num_hitches_100ms;
+    int recent_pos;
+    int num_recent;
+    double recent[SAPP_MAX_FRAME_STATS_SAMPLES];
+    uint32_t buckets[_SAPP_FRAME_STATS_NUM_BUCKETS];
+} _sapp_frame_stats_t;
+
 typedef struct {
     double last;
     double accum;
@@ -2061,8 +2364,94 @@ typedef struct {
     int num;
     _sapp_timestamp_t timestamp;
     _sapp_ring_t ring;
+    _sapp_frame_stats_t stats;
 } _sapp_timing_t;
 
+_SOKOL_PRIVATE int _sapp_frame_stats_bucket(double dur) {
+    uint64_t us = (dur > 0.0) ? (uint64_t)(dur * 1000000.0 + 0.5) : 0;
+    if (us < _SAPP_FRAME_STATS_SUB_BUCKETS) {
+        return (int)us;
+    }
+    int e = _SAPP_FRAME_STATS_SUB_BITS;
+    while (((us >> (e + 1)) != 0) && (e < _SAPP_FRAME_STATS_MAX_EXP)) {
+        e++;
+    }
+    if ((us >> (e + 1)) != 0) {
+        return _SAPP_FRAME_STATS_NUM_BUCKETS - 1;
+    }
+    const int sub = (int)((us >> (e - _SAPP_FRAME_STATS_SUB_BITS)) & (_SAPP_FRAME_STATS_SUB_BUCKETS - 1));
+    return (e - _SAPP_FRAME_STATS_SUB_BITS + 1) * _SAPP_FRAME_STATS_SUB_BUCKETS + sub;
+}
+
+/* returns the center of a histogram bucket in seconds */
+_SOKOL_PRIVATE double _sapp_frame_stats_bucket_value(int bucket) {
+    if (bucket < _SAPP_FRAME_STATS_SUB_BUCKETS) {
+        return (double)bucket * 0.000001;
+    }
+    const int e = (bucket / _SAPP_FRAME_STATS_SUB_BUCKETS) + _SAPP_FRAME_STATS_SUB_BITS - 1;
+    const int sub = bucket % _SAPP_FRAME_STATS_SUB_BUCKETS;
+    const double width = (double)(1ULL << (e - _SAPP_FRAME_STATS_SUB_BITS));
+    const double lower = (double)(_SAPP_FRAME_STATS_SUB_BUCKETS + sub) * width;
+    return (lower + 0.5 * width) * 0.000001;
+}
+
+_SOKOL_PRIVATE void _sapp_frame_stats_put(_sapp_frame_stats_t* s, double dur, double smoothed_dur) {
+    if (0 == s->num) {
+        s->min = dur;
+        s->max = dur;
+    }
+    else {
+        if (dur < s->min) {
+            s->min = dur;
+        }
+        if (dur > s->max) {
+            s->max = dur;
+        }
+    }
+    s->num++;
+    s->sum += dur;
+    if (dur > (smoothed_dur * 1.5)) {
+        s->num_hitches_1_5x++;
+    }
+    if (dur > (smoothed_dur * 2.0)) {
+        s->num_hitches_2x++;
+    }
+    if (dur > 0.1) {
+        s->num_hitches_100ms++;
+    }
+    s->recent[s->recent_pos] = dur;
+    s->recent_pos = (s->recent_pos + 1) % SAPP_MAX_FRAME_STATS_SAMPLES;
+    if (s->num_recent < SAPP_MAX_FRAME_STATS_SAMPLES) {
+        s->num_recent++;
+    }
+    s->buckets[_sapp_frame_stats_bucket(dur)]++;
+}
+
+/* returns the duration below or at which the fraction p of all samples lie */
+_SOKOL_PRIVATE double _sapp_frame_stats_percentile(const _sapp_frame_stats_t* s, double p) {
+    SOKOL_ASSERT(s->num > 0);
+    uint64_t target = (uint64_t)(p * (double)s->num + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+    uint64_t count = 0;
+    for (int i = 0; i < _SAPP_FRAME_STATS_NUM_BUCKETS; i++) {
+        count += s->buckets[i];
+        if (count >= target) {
+            /* the bucket center may lie outside the actually measured range */
+            double val = _sapp_frame_stats_bucket_value(i);
+            if (val < s->min) {
+                val = s->min;
+            }
+            if (val > s->max) {
+                val = s->max;
+            }
+            return val;
+        }
+    }
+    return s->max;
+}
+
 _SOKOL_PRIVATE void _sapp_timing_reset(_sapp_timing_t* t) {
     t->last = 0.0;
     t->accum = 0.0;
@@ -2078,6 +2467,8 @@ _SOKOL_PRIVATE void _sapp_timing_init(_sapp_timing_t* t) {
 }
 
 _SOKOL_PRIVATE void _sapp_timing_put(_sapp_timing_t* t, double dur) {
+    // the raw statistics see all frame durations, including the outliers ignored below
+    _sapp_frame_stats_put(&t->stats, dur, t->avg);
     // arbitrary upper limit to ignore outliers (e.g. during window resizing, or debugging)
     double min_dur = 0.0;
     double max_dur = 0.1;
@@ -2495,6 +2886,57 @@ typedef struct {
     Atom text_uri_list;
 } _sapp_xdnd_t;
 
+/* pending mouse move or scroll event in coalesced mode */
+typedef struct {
+    sapp_event_type type;   /* SAPP_EVENTTYPE_INVALID if nothing is pending */
+    uint32_t modifiers;
+    float dx, dy;
+    float scroll_x, scroll_y;
+    int count;
+} _sapp_x11_coalesce_t;
+
+/* single-producer/single-consumer event queue from the X11 event thread to the render thread */
+#define _SAPP_X11_EVENT_QUEUE_SIZE (256)    /* must be a power of 2 */
+typedef struct {
+    uint32_t head;          /* only written by the event thread */
+    uint32_t tail;          /* only written by the render thread */
+    sapp_event* events;
+} _sapp_x11_event_queue_t;
+
+/* single-producer/single-consumer queue for window state changes requested by
+   the render thread, which are executed on the event thread
+*/
+typedef enum {
+    _SAPP_X11_CMD_LOCK_MOUSE,
+    _SAPP_X11_CMD_SHOW_MOUSE,
+    _SAPP_X11_CMD_TOGGLE_FULLSCREEN,
+} _sapp_x11_cmd_type_t;
+
+typedef struct {
+    _sapp_x11_cmd_type_t type;
+    bool flag;
+} _sapp_x11_cmd_t;
+
+#define _SAPP_X11_CMD_QUEUE_SIZE (16)    /* must be a power of 2 */
+typedef struct {
+    uint32_t head;          /* only written by the render thread */
+    uint32_t tail;          /* only written by the event thread */
+    _sapp_x11_cmd_t cmds[_SAPP_X11_CMD_QUEUE_SIZE];
+} _sapp_x11_cmd_queue_t;
+
+typedef struct {
+    bool active;
+    pthread_t thread;
+    pthread_t main_thread;
+    int main_wakeup_fd;     /* eventfd to wake up the event thread for commands, or when the render thread has finished */
+    _sapp_x11_event_queue_t queue;
+    _sapp_x11_cmd_queue_t cmd_queue;
+    /* dropped files are parsed into this buffer, and copied into the drop buffer by the render thread */
+    char* drop_buffer;
+    int drop_num_files;
+    bool drop_pending;      /* true until the render thread has taken the dropped files */
+} _sapp_x11_render_thread_t;
+
 typedef struct {
     uint8_t mouse_buttons;
     Display* display;
@@ -2518,6 +2960,13 @@ typedef struct {
     Atom NET_WM_STATE_FULLSCREEN;
     _sapp_xi_t xi;
     _sapp_xdnd_t xdnd;
+    _sapp_x11_coalesce_t coalesce;
+    bool unmapped;          /* window has been unmapped */
+    bool obscured;          /* window is fully covered by other windows */
+    bool suspended;         /* only with sapp_desc.suspend_when_hidden: window is iconified, unmapped or obscured */
+    int wakeup_fd;          /* eventfd for sapp_request_redraw() in render-on-demand mode, -1 if unused */
+    double redraw_time;     /* time of a pending sapp_request_redraw_after(), < 0.0 if none */
+    _sapp_x11_render_thread_t render_thread;
 } _sapp_x11_t;
 
 #if defined(_SAPP_GLX)
@@ -2562,6 +3011,8 @@ typedef struct {
 
 #else
 
+#define _SAPP_EGL_PLATFORM_SURFACELESS_MESA (0x31DD)
+
 typedef struct {
     EGLDisplay display;
     EGLContext context;
@@ -2570,6 +3021,11 @@ typedef struct {
 
 #endif // _SAPP_GLX
 
+typedef struct {
+    _sapp_timestamp_t timestamp;
+    double next_frame_time;     /* in seconds, only used with sapp_desc.headless_frame_rate */
+} _sapp_headless_t;
+
 #endif // _SAPP_LINUX
 
 /*== COMMON DECLARATIONS =====================================================*/
@@ -2578,6 +3034,17 @@ typedef struct {
 #define _sapp_def(val, def) (((val) == 0) ? (def) : (val))
 #define _sapp_absf(a) (((a)<0.0f)?-(a):(a))
 
+/* state which is shared between the X11 event thread and the render thread
+   (quit flags, frame counter, window size etc, see RENDER THREAD)
+*/
+#if defined(_SAPP_LINUX)
+#define _sapp_shared_load(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define _sapp_shared_store(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#else
+#define _sapp_shared_load(ptr) (*(ptr))
+#define _sapp_shared_store(ptr, val) (*(ptr) = (val))
+#endif
+
 #define _SAPP_MAX_TITLE_LENGTH (128)
 #define _SAPP_FALLBACK_DEFAULT_WINDOW_WIDTH (640)
 #define _SAPP_FALLBACK_DEFAULT_WINDOW_HEIGHT (480)
@@ -2622,6 +3089,50 @@ typedef struct {
     sapp_mouse_cursor current_cursor;
 } _sapp_mouse_t;
 
+/* event log file layout, see EVENT RECORDING AND REPLAY */
+#define _SAPP_EVLOG_MAGIC "SAPPEVT1"
+#define _SAPP_EVLOG_MAGIC_SIZE (8)
+typedef struct {
+    uint64_t frame_count;
+    double time;
+    uint32_t type;              /* SAPP_EVENTTYPE_INVALID marks the end of the recording */
+    uint32_t key_code;
+    uint32_t char_code;
+    uint32_t modifiers;
+    int32_t mouse_button;
+    uint32_t key_repeat;
+    float mouse_x;
+    float mouse_y;
+    float mouse_dx;
+    float mouse_dy;
+    float scroll_x;
+    float scroll_y;
+    int32_t num_coalesced;
+    int32_t num_touches;        /* followed by num_touches _sapp_evlog_touch_t items */
+    int32_t window_width;
+    int32_t window_height;
+    int32_t framebuffer_width;
+    int32_t framebuffer_height;
+} _sapp_evlog_record_t;
+
+typedef struct {
+    uint64_t identifier;
+    float pos_x;
+    float pos_y;
+    uint32_t changed;
+    uint32_t reserved;
+} _sapp_evlog_touch_t;
+
+typedef struct {
+    FILE* record_file;
+    uint8_t* replay_data;
+    size_t replay_size;
+    size_t replay_pos;
+    uint64_t replay_end_frame;
+    bool replaying;
+    bool in_replay;             /* true while a replayed event is dispatched */
+} _sapp_evlog_t;
+
 typedef struct {
     sapp_desc desc;
     bool valid;
@@ -2648,6 +3159,7 @@ typedef struct {
     _sapp_mouse_t mouse;
     _sapp_clipboard_t clipboard;
     _sapp_drop_t drop;
+    _sapp_evlog_t evlog;
     sapp_icon_desc default_icon_desc;
     uint32_t* default_icon_pixels;
     #if defined(_SAPP_MACOS)
@@ -2672,6 +3184,7 @@ typedef struct {
         _sapp_android_t android;
     #elif defined(_SAPP_LINUX)
         _sapp_x11_t x11;
+        _sapp_headless_t headless;
         #if defined(_SAPP_GLX)
             _sapp_glx_t glx;
         #else
@@ -2732,6 +3245,238 @@ _SOKOL_PRIVATE void _sapp_fail(const char* msg) {
     SOKOL_ABORT();
 }
 
+/*== EVENT RECORDING AND REPLAY ==============================================*/
+_SOKOL_PRIVATE FILE* _sapp_evlog_fopen(const char* path, const char* mode) {
+    #if defined(_SAPP_EMSCRIPTEN)
+        _SOKOL_UNUSED(path); _SOKOL_UNUSED(mode);
+        return 0;
+    #elif defined(_MSC_VER)
+        FILE* fp = 0;
+        if (0 != fopen_s(&fp, path, mode)) {
+            return 0;
+        }
+        return fp;
+    #else
+        return fopen(path, mode);
+    #endif
+}
+
+_SOKOL_PRIVATE double _sapp_evlog_time(void) {
+    #if defined(_SAPP_EMSCRIPTEN)
+        return 0.0;
+    #else
+        return _sapp_timestamp_now(&_sapp.timing.timestamp);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sapp_evlog_load_replay(const char* path) {
+    FILE* fp = _sapp_evlog_fopen(path, "rb");
+    if (!fp) {
+        SOKOL_LOG("sokol_app.h: failed to open event replay file\n");
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    const long file_size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char magic[_SAPP_EVLOG_MAGIC_SIZE];
+    if ((file_size < _SAPP_EVLOG_MAGIC_SIZE) ||
+        (fread(magic, 1, _SAPP_EVLOG_MAGIC_SIZE, fp) != _SAPP_EVLOG_MAGIC_SIZE) ||
+        (0 != memcmp(magic, _SAPP_EVLOG_MAGIC, _SAPP_EVLOG_MAGIC_SIZE)))
+    {
+        SOKOL_LOG("sokol_app.h: not a valid event replay file\n");
+        fclose(fp);
+        return;
+    }
+    const size_t size = (size_t)file_size - _SAPP_EVLOG_MAGIC_SIZE;
+    uint8_t* data = (uint8_t*) _sapp_malloc(size > 0 ? size : 1);
+    if (fread(data, 1, size, fp) != size) {
+        SOKOL_LOG("sokol_app.h: failed to read event replay file\n");
+        _sapp_free(data);
+        fclose(fp);
+        return;
+    }
+    fclose(fp);
+    /* find the last frame of the recording, a missing end marker (for instance after a crash) is ok,
+       the scan stops at the first corrupt or truncated record, same as _sapp_evlog_replay_frame()
+    */
+    uint64_t end_frame = 0;
+    size_t pos = 0;
+    _sapp_evlog_record_t rec;
+    while ((pos + sizeof(rec)) <= size) {
+        memcpy(&rec, data + pos, sizeof(rec));
+        if ((rec.num_touches < 0) || (rec.num_touches > SAPP_MAX_TOUCHPOINTS)) {
+            break;
+        }
+        const size_t rec_size = sizeof(rec) + (size_t)rec.num_touches * sizeof(_sapp_evlog_touch_t);
+        if (rec_size > (size - pos)) {
+            break;
+        }
+        end_frame = (rec.type == SAPP_EVENTTYPE_INVALID) ? rec.frame_count : rec.frame_count + 1;
+        pos += rec_size;
+    }
+    _sapp.evlog.replay_data = data;
+    _sapp.evlog.replay_size = size;
+    _sapp.evlog.replay_pos = 0;
+    _sapp.evlog.replay_end_frame = end_frame;
+    _sapp.evlog.replaying = true;
+}
+
+_SOKOL_PRIVATE void _sapp_evlog_init(void) {
+    if (_sapp.desc.replay_events_path) {
+        _sapp_evlog_load_replay(_sapp.desc.replay_events_path);
+    }
+    if (_sapp.desc.record_events_path) {
+        _sapp.evlog.record_file = _sapp_evlog_fopen(_sapp.desc.record_events_path, "wb");
+        if (_sapp.evlog.record_file) {
+            fwrite(_SAPP_EVLOG_MAGIC, 1, _SAPP_EVLOG_MAGIC_SIZE, _sapp.evlog.record_file);
+        }
+        else {
+            SOKOL_LOG("sokol_app.h: failed to open event recording file\n");
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_evlog_write(const sapp_event* e) {
+    SOKOL_ASSERT(_sapp.evlog.record_file);
+    _sapp_evlog_record_t rec;
+    _sapp_clear(&rec, sizeof(rec));
+    rec.frame_count = e->frame_count;
+    rec.time = _sapp_evlog_time();
+    rec.type = (uint32_t)e->type;
+    rec.key_code = (uint32_t)e->key_code;
+    rec.char_code = e->char_code;
+    rec.modifiers = e->modifiers;
+    rec.mouse_button = (int32_t)e->mouse_button;
+    rec.key_repeat = e->key_repeat ? 1 : 0;
+    rec.mouse_x = e->mouse_x;
+    rec.mouse_y = e->mouse_y;
+    rec.mouse_dx = e->mouse_dx;
+    rec.mouse_dy = e->mouse_dy;
+    rec.scroll_x = e->scroll_x;
+    rec.scroll_y = e->scroll_y;
+    rec.num_coalesced = e->num_coalesced;
+    rec.num_touches = e->num_touches;
+    rec.window_width = e->window_width;
+    rec.window_height = e->window_height;
+    rec.framebuffer_width = e->framebuffer_width;
+    rec.framebuffer_height = e->framebuffer_height;
+    fwrite(&rec, sizeof(rec), 1, _sapp.evlog.record_file);
+    for (int i = 0; i < e->num_touches; i++) {
+        _sapp_evlog_touch_t touch;
+        _sapp_clear(&touch, sizeof(touch));
+        touch.identifier = (uint64_t)e->touches[i].identifier;
+        touch.pos_x = e->touches[i].pos_x;
+        touch.pos_y = e->touches[i].pos_y;
+        touch.changed = e->touches[i].changed ? 1 : 0;
+        fwrite(&touch, sizeof(touch), 1, _sapp.evlog.record_file);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_evlog_discard(void) {
+    if (_sapp.evlog.record_file) {
+        /* write the end marker with the number of recorded frames */
+        _sapp_evlog_record_t rec;
+        _sapp_clear(&rec, sizeof(rec));
+        rec.frame_count = _sapp.frame_count;
+        rec.time = _sapp_evlog_time();
+        rec.type = (uint32_t)SAPP_EVENTTYPE_INVALID;
+        fwrite(&rec, sizeof(rec), 1, _sapp.evlog.record_file);
+        fclose(_sapp.evlog.record_file);
+        _sapp.evlog.record_file = 0;
+    }
+    if (_sapp.evlog.replay_data) {
+        _sapp_free(_sapp.evlog.replay_data);
+        _sapp.evlog.replay_data = 0;
+    }
+}
+
+/* returns true if a live event should be ignored because events are replayed */
+_SOKOL_PRIVATE bool _sapp_evlog_filter_event(const sapp_event* e) {
+    return _sapp.evlog.replaying && !_sapp.evlog.in_replay && (e->type != SAPP_EVENTTYPE_QUIT_REQUESTED);
+}
+
+_SOKOL_PRIVATE bool _sapp_call_event(const sapp_event* e);
+_SOKOL_PRIVATE bool _sapp_events_enabled(void);
+
+/* dispatch all recorded events up to the current frame */
+/* check the enum values of a replayed event, so that a corrupt or foreign file can't pass undefined values to the event callback */
+_SOKOL_PRIVATE bool _sapp_evlog_valid_event(const _sapp_evlog_record_t* rec) {
+    if ((rec->type >= _SAPP_EVENTTYPE_NUM) || (rec->key_code > SAPP_KEYCODE_MENU)) {
+        return false;
+    }
+    switch (rec->mouse_button) {
+        case SAPP_MOUSEBUTTON_LEFT:
+        case SAPP_MOUSEBUTTON_RIGHT:
+        case SAPP_MOUSEBUTTON_MIDDLE:
+        case SAPP_MOUSEBUTTON_INVALID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_evlog_replay_frame(void) {
+    if (!_sapp.evlog.replaying) {
+        return;
+    }
+    if (_sapp.frame_count >= _sapp.evlog.replay_end_frame) {
+        _sapp.evlog.replaying = false;
+        return;
+    }
+    const uint8_t* data = _sapp.evlog.replay_data;
+    const size_t size = _sapp.evlog.replay_size;
+    _sapp_evlog_record_t rec;
+    while ((_sapp.evlog.replay_pos + sizeof(rec)) <= size) {
+        memcpy(&rec, data + _sapp.evlog.replay_pos, sizeof(rec));
+        if (rec.frame_count > _sapp.frame_count) {
+            break;
+        }
+        const size_t touches_pos = _sapp.evlog.replay_pos + sizeof(rec);
+        const size_t touches_size = (size_t)rec.num_touches * sizeof(_sapp_evlog_touch_t);
+        if ((rec.num_touches < 0) || (rec.num_touches > SAPP_MAX_TOUCHPOINTS) || ((touches_pos + touches_size) > size)) {
+            /* corrupt or truncated file */
+            _sapp.evlog.replay_pos = size;
+            break;
+        }
+        _sapp.evlog.replay_pos = touches_pos + touches_size;
+        if ((rec.type == SAPP_EVENTTYPE_INVALID) || !_sapp_evlog_valid_event(&rec) || !_sapp_events_enabled()) {
+            continue;
+        }
+        sapp_event e;
+        _sapp_clear(&e, sizeof(e));
+        e.frame_count = _sapp.frame_count;
+        e.type = (sapp_event_type)rec.type;
+        e.key_code = (sapp_keycode)rec.key_code;
+        e.char_code = rec.char_code;
+        e.key_repeat = 0 != rec.key_repeat;
+        e.modifiers = rec.modifiers;
+        e.mouse_button = (sapp_mousebutton)rec.mouse_button;
+        e.mouse_x = rec.mouse_x;
+        e.mouse_y = rec.mouse_y;
+        e.mouse_dx = rec.mouse_dx;
+        e.mouse_dy = rec.mouse_dy;
+        e.scroll_x = rec.scroll_x;
+        e.scroll_y = rec.scroll_y;
+        e.num_coalesced = rec.num_coalesced;
+        e.num_touches = rec.num_touches;
+        for (int i = 0; i < rec.num_touches; i++) {
+            _sapp_evlog_touch_t touch;
+            memcpy(&touch, data + touches_pos + (size_t)i * sizeof(touch), sizeof(touch));
+            e.touches[i].identifier = (uintptr_t)touch.identifier;
+            e.touches[i].pos_x = touch.pos_x;
+            e.touches[i].pos_y = touch.pos_y;
+            e.touches[i].changed = 0 != touch.changed;
+        }
+        e.window_width = rec.window_width;
+        e.window_height = rec.window_height;
+        e.framebuffer_width = rec.framebuffer_width;
+        e.framebuffer_height = rec.framebuffer_height;
+        _sapp.evlog.in_replay = true;
+        _sapp_call_event(&e);
+        _sapp.evlog.in_replay = false;
+    }
+}
+
 _SOKOL_PRIVATE void _sapp_call_init(void) {
     if (_sapp.desc.init_cb) {
         _sapp.desc.init_cb();
@@ -2739,7 +3484,7 @@ _SOKOL_PRIVATE void _sapp_call_init(void) {
     else if (_sapp.desc.init_userdata_cb) {
         _sapp.desc.init_userdata_cb(_sapp.desc.user_data);
     }
-    _sapp.init_called = true;
+    _sapp_shared_store(&_sapp.init_called, true);
 }
 
 _SOKOL_PRIVATE void _sapp_call_frame(void) {
@@ -2766,6 +3511,12 @@ _SOKOL_PRIVATE void _sapp_call_cleanup(void) {
 }
 
 _SOKOL_PRIVATE bool _sapp_call_event(const sapp_event* e) {
+    if (_sapp_evlog_filter_event(e)) {
+        return false;
+    }
+    if (_sapp.evlog.record_file && !_sapp.cleanup_called) {
+        _sapp_evlog_write(e);
+    }
     if (!_sapp.cleanup_called) {
         if (_sapp.desc.event_cb) {
             _sapp.desc.event_cb(e);
@@ -2883,6 +3634,7 @@ _SOKOL_PRIVATE void _sapp_init_state(const sapp_desc* desc) {
     _sapp.fullscreen = _sapp.desc.fullscreen;
     _sapp.mouse.shown = true;
     _sapp_timing_init(&_sapp.timing);
+    _sapp_evlog_init();
 }
 
 _SOKOL_PRIVATE void _sapp_discard_state(void) {
@@ -2897,18 +3649,19 @@ _SOKOL_PRIVATE void _sapp_discard_state(void) {
     if (_sapp.default_icon_pixels) {
         _sapp_free((void*)_sapp.default_icon_pixels);
     }
+    _sapp_evlog_discard();
     _SAPP_CLEAR_ARC_STRUCT(_sapp_t, _sapp);
 }
 
 _SOKOL_PRIVATE void _sapp_init_event(sapp_event_type type) {
     _sapp_clear(&_sapp.event, sizeof(_sapp.event));
     _sapp.event.type = type;
-    _sapp.event.frame_count = _sapp.frame_count;
+    _sapp.event.frame_count = _sapp_shared_load(&_sapp.frame_count);
     _sapp.event.mouse_button = SAPP_MOUSEBUTTON_INVALID;
-    _sapp.event.window_width = _sapp.window_width;
-    _sapp.event.window_height = _sapp.window_height;
-    _sapp.event.framebuffer_width = _sapp.framebuffer_width;
-    _sapp.event.framebuffer_height = _sapp.framebuffer_height;
+    _sapp.event.window_width = _sapp_shared_load(&_sapp.window_width);
+    _sapp.event.window_height = _sapp_shared_load(&_sapp.window_height);
+    _sapp.event.framebuffer_width = _sapp_shared_load(&_sapp.framebuffer_width);
+    _sapp.event.framebuffer_height = _sapp_shared_load(&_sapp.framebuffer_height);
     _sapp.event.mouse_x = _sapp.mouse.x;
     _sapp.event.mouse_y = _sapp.mouse.y;
     _sapp.event.mouse_dx = _sapp.mouse.dx;
@@ -2917,7 +3670,7 @@ _SOKOL_PRIVATE void _sapp_init_event(sapp_event_type type) {
 
 _SOKOL_PRIVATE bool _sapp_events_enabled(void) {
     /* only send events when an event callback is set, and the init function was called */
-    return (_sapp.desc.event_cb || _sapp.desc.event_userdata_cb) && _sapp.init_called;
+    return (_sapp.desc.event_cb || _sapp.desc.event_userdata_cb) && _sapp_shared_load(&_sapp.init_called);
 }
 
 _SOKOL_PRIVATE sapp_keycode _sapp_translate_key(int scan_code) {
@@ -2938,11 +3691,12 @@ _SOKOL_PRIVATE void _sapp_clear_drop_buffer(void) {
 
 _SOKOL_PRIVATE void _sapp_frame(void) {
     if (_sapp.first_frame) {
-        _sapp.first_frame = false;
+        _sapp_shared_store(&_sapp.first_frame, false);
         _sapp_call_init();
     }
+    _sapp_evlog_replay_frame();
     _sapp_call_frame();
-    _sapp.frame_count++;
+    _sapp_shared_store(&_sapp.frame_count, _sapp.frame_count + 1);
 }
 
 _SOKOL_PRIVATE bool _sapp_image_validate(const sapp_image_desc* desc) {
@@ -10590,6 +11344,9 @@ _SOKOL_PRIVATE void _sapp_x11_destroy_cursors(void) {
 }
 
 _SOKOL_PRIVATE void _sapp_x11_toggle_fullscreen(void) {
+    if (_sapp.desc.headless) {
+        return;
+    }
     _sapp.fullscreen = !_sapp.fullscreen;
     _sapp_x11_set_fullscreen(_sapp.fullscreen);
     _sapp_x11_query_window_size();
@@ -10597,6 +11354,9 @@ _SOKOL_PRIVATE void _sapp_x11_toggle_fullscreen(void) {
 
 _SOKOL_PRIVATE void _sapp_x11_update_cursor(sapp_mouse_cursor cursor, bool shown) {
     SOKOL_ASSERT((cursor >= 0) && (cursor < _SAPP_MOUSECURSOR_NUM));
+    if (_sapp.desc.headless) {
+        return;
+    }
     if (shown) {
         if (_sapp.x11.cursors[cursor]) {
             XDefineCursor(_sapp.x11.display, _sapp.x11.window, _sapp.x11.cursors[cursor]);
@@ -10612,7 +11372,7 @@ _SOKOL_PRIVATE void _sapp_x11_update_cursor(sapp_mouse_cursor cursor, bool shown
 }
 
 _SOKOL_PRIVATE void _sapp_x11_lock_mouse(bool lock) {
-    if (lock == _sapp.mouse.locked) {
+    if ((lock == _sapp.mouse.locked) || _sapp.desc.headless) {
         return;
     }
     _sapp.mouse.dx = 0.0f;
@@ -10654,6 +11414,9 @@ _SOKOL_PRIVATE void _sapp_x11_lock_mouse(bool lock) {
 }
 
 _SOKOL_PRIVATE void _sapp_x11_update_window_title(void) {
+    if (_sapp.desc.headless) {
+        return;
+    }
     Xutf8SetWMProperties(_sapp.x11.display,
         _sapp.x11.window,
         _sapp.window_title, _sapp.window_title,
@@ -10673,6 +11436,9 @@ _SOKOL_PRIVATE void _sapp_x11_update_window_title(void) {
 
 _SOKOL_PRIVATE void _sapp_x11_set_icon(const sapp_icon_desc* icon_desc, int num_images) {
     SOKOL_ASSERT((num_images > 0) && (num_images <= SAPP_MAX_ICONIMAGES));
+    if (_sapp.desc.headless) {
+        return;
+    }
     int long_count = 0;
     for (int i = 0; i < num_images; i++) {
         const sapp_image_desc* img_desc = &icon_desc->images[i];
@@ -10896,10 +11662,170 @@ _SOKOL_PRIVATE uint32_t _sapp_x11_mods(uint32_t x11_mods) {
     return mods;
 }
 
+/* render thread mode: push an event into the queue, waits if the queue is full */
+_SOKOL_PRIVATE void _sapp_x11_event_queue_push(const sapp_event* e) {
+    _sapp_x11_event_queue_t* q = &_sapp.x11.render_thread.queue;
+    const uint32_t head = q->head;
+    bool woken = false;
+    while ((head - __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE)) >= _SAPP_X11_EVENT_QUEUE_SIZE) {
+        if (_sapp_shared_load(&_sapp.quit_ordered)) {
+            return;
+        }
+        /* the render thread may be waiting in render-on-demand or suspended mode */
+        if (!woken) {
+            sapp_request_redraw();
+            woken = true;
+        }
+        const struct timespec req = { 0, 1000000 };
+        nanosleep(&req, NULL);
+    }
+    q->events[head & (_SAPP_X11_EVENT_QUEUE_SIZE - 1)] = *e;
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* render thread mode: pop the next event, returns false if the queue is empty */
+_SOKOL_PRIVATE bool _sapp_x11_event_queue_pop(sapp_event* out_event) {
+    _sapp_x11_event_queue_t* q = &_sapp.x11.render_thread.queue;
+    const uint32_t tail = q->tail;
+    if (tail == __atomic_load_n(&q->head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *out_event = q->events[tail & (_SAPP_X11_EVENT_QUEUE_SIZE - 1)];
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sapp_x11_event_queue_empty(void) {
+    _sapp_x11_event_queue_t* q = &_sapp.x11.render_thread.queue;
+    return q->tail == __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+}
+
+/* render thread mode: wait until the render thread has taken the files of the previous drop,
+   returns false if the application is quitting
+*/
+_SOKOL_PRIVATE bool _sapp_x11_wait_drop_taken(void) {
+    _sapp_x11_render_thread_t* rt = &_sapp.x11.render_thread;
+    bool woken = false;
+    while (_sapp_shared_load(&rt->drop_pending)) {
+        if (_sapp_shared_load(&_sapp.quit_ordered)) {
+            return false;
+        }
+        if (!woken) {
+            sapp_request_redraw();
+            woken = true;
+        }
+        const struct timespec req = { 0, 1000000 };
+        nanosleep(&req, NULL);
+    }
+    return true;
+}
+
+/* render thread mode: copy the files of a FILES_DROPPED event into the drop buffer, which only the render thread accesses */
+_SOKOL_PRIVATE void _sapp_x11_take_dropped_files(void) {
+    _sapp_x11_render_thread_t* rt = &_sapp.x11.render_thread;
+    if (_sapp_shared_load(&rt->drop_pending)) {
+        memcpy(_sapp.drop.buffer, rt->drop_buffer, (size_t)_sapp.drop.buf_size);
+        _sapp.drop.num_files = rt->drop_num_files;
+        _sapp_shared_store(&rt->drop_pending, false);
+    }
+}
+
+/* render thread mode: call the event callback with all queued events */
+_SOKOL_PRIVATE void _sapp_x11_event_queue_dispatch(void) {
+    /* events which arrive before the init callback has been called are dropped, same as without render thread */
+    sapp_event event;
+    while (_sapp_x11_event_queue_pop(&event)) {
+        if (event.type == SAPP_EVENTTYPE_FILES_DROPPED) {
+            _sapp_x11_take_dropped_files();
+        }
+        if (_sapp_events_enabled()) {
+            _sapp_call_event(&event);
+        }
+    }
+}
+
+/* render thread mode: true if called from the render thread */
+_SOKOL_PRIVATE bool _sapp_x11_on_render_thread(void) {
+    return _sapp.x11.render_thread.active && !pthread_equal(pthread_self(), _sapp.x11.render_thread.main_thread);
+}
+
+/* render thread mode: hand a window state change over to the event thread, waits if the queue is full */
+_SOKOL_PRIVATE void _sapp_x11_cmd_queue_push(_sapp_x11_cmd_type_t type, bool flag) {
+    _sapp_x11_cmd_queue_t* q = &_sapp.x11.render_thread.cmd_queue;
+    const uint32_t head = q->head;
+    while ((head - __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE)) >= _SAPP_X11_CMD_QUEUE_SIZE) {
+        if (_sapp_shared_load(&_sapp.quit_ordered)) {
+            return;
+        }
+        const struct timespec req = { 0, 1000000 };
+        nanosleep(&req, NULL);
+    }
+    q->cmds[head & (_SAPP_X11_CMD_QUEUE_SIZE - 1)].type = type;
+    q->cmds[head & (_SAPP_X11_CMD_QUEUE_SIZE - 1)].flag = flag;
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    const uint64_t one = 1;
+    if (write(_sapp.x11.render_thread.main_wakeup_fd, &one, sizeof(one)) != sizeof(one)) {
+        /* can't happen, the counter can't overflow */
+    }
+}
+
+/* render thread mode: queue a window state change if called on the render thread,
+   returns false if the caller should execute it right away
+*/
+_SOKOL_PRIVATE bool _sapp_x11_cmd_defer(_sapp_x11_cmd_type_t type, bool flag) {
+    if (_sapp_x11_on_render_thread()) {
+        _sapp_x11_cmd_queue_push(type, flag);
+        return true;
+    }
+    return false;
+}
+
+/* render thread mode: execute the window state changes requested by the render thread */
+_SOKOL_PRIVATE void _sapp_x11_cmd_queue_execute(void) {
+    _sapp_x11_cmd_queue_t* q = &_sapp.x11.render_thread.cmd_queue;
+    uint32_t tail = q->tail;
+    const uint32_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    while (tail != head) {
+        const _sapp_x11_cmd_t cmd = q->cmds[tail & (_SAPP_X11_CMD_QUEUE_SIZE - 1)];
+        __atomic_store_n(&q->tail, ++tail, __ATOMIC_RELEASE);
+        switch (cmd.type) {
+            case _SAPP_X11_CMD_LOCK_MOUSE:          _sapp_x11_lock_mouse(cmd.flag); break;
+            case _SAPP_X11_CMD_SHOW_MOUSE:          sapp_show_mouse(cmd.flag); break;
+            case _SAPP_X11_CMD_TOGGLE_FULLSCREEN:   _sapp_x11_toggle_fullscreen(); break;
+        }
+    }
+}
+
+/* send _sapp.event to the event callback, or to the render thread in render thread mode */
+_SOKOL_PRIVATE void _sapp_x11_call_event(void) {
+    if (_sapp.x11.render_thread.active) {
+        _sapp_x11_event_queue_push(&_sapp.event);
+    }
+    else {
+        _sapp_call_event(&_sapp.event);
+    }
+}
+
 _SOKOL_PRIVATE void _sapp_x11_app_event(sapp_event_type type) {
     if (_sapp_events_enabled()) {
         _sapp_init_event(type);
-        _sapp_call_event(&_sapp.event);
+        _sapp_x11_call_event();
+    }
+}
+
+/* check if the window became hidden or visible, and send SUSPENDED/RESUMED events */
+_SOKOL_PRIVATE void _sapp_x11_update_suspended(void) {
+    if (!_sapp.desc.suspend_when_hidden) {
+        return;
+    }
+    const bool hidden = (_sapp.x11.window_state == IconicState) || _sapp.x11.unmapped || _sapp.x11.obscured;
+    if (hidden != _sapp.x11.suspended) {
+        _sapp_shared_store(&_sapp.x11.suspended, hidden);
+        _sapp_x11_app_event(hidden ? SAPP_EVENTTYPE_SUSPENDED : SAPP_EVENTTYPE_RESUMED);
+        if (!hidden) {
+            /* wake up the render thread, or the main thread in render-on-demand mode */
+            sapp_request_redraw();
+        }
     }
 }
 
@@ -10917,7 +11843,7 @@ _SOKOL_PRIVATE void _sapp_x11_mouse_event(sapp_event_type type, sapp_mousebutton
         _sapp_init_event(type);
         _sapp.event.mouse_button = btn;
         _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
+        _sapp_x11_call_event();
     }
 }
 
@@ -10927,7 +11853,80 @@ _SOKOL_PRIVATE void _sapp_x11_scroll_event(float x, float y, uint32_t mods) {
         _sapp.event.modifiers = mods;
         _sapp.event.scroll_x = x;
         _sapp.event.scroll_y = y;
-        _sapp_call_event(&_sapp.event);
+        _sapp_x11_call_event();
+    }
+}
+
+/* send the pending coalesced mouse move or scroll event (if any) */
+_SOKOL_PRIVATE void _sapp_x11_flush_coalesced_event(void) {
+    _sapp_x11_coalesce_t* co = &_sapp.x11.coalesce;
+    if (co->type == SAPP_EVENTTYPE_INVALID) {
+        return;
+    }
+    if (_sapp_events_enabled()) {
+        _sapp_init_event(co->type);
+        _sapp.event.modifiers = co->modifiers;
+        if (co->type == SAPP_EVENTTYPE_MOUSE_MOVE) {
+            _sapp.event.mouse_dx = co->dx;
+            _sapp.event.mouse_dy = co->dy;
+        }
+        else {
+            _sapp.event.scroll_x = co->scroll_x;
+            _sapp.event.scroll_y = co->scroll_y;
+        }
+        _sapp.event.num_coalesced = co->count;
+        _sapp_x11_call_event();
+    }
+    _sapp_clear(co, sizeof(_sapp_x11_coalesce_t));
+}
+
+/* start a new pending event, or add to the pending event if it has the same type and modifiers */
+_SOKOL_PRIVATE _sapp_x11_coalesce_t* _sapp_x11_coalesce_begin(sapp_event_type type, uint32_t mods) {
+    _sapp_x11_coalesce_t* co = &_sapp.x11.coalesce;
+    if ((co->type != type) || (co->modifiers != mods)) {
+        _sapp_x11_flush_coalesced_event();
+        co->type = type;
+        co->modifiers = mods;
+    }
+    co->count++;
+    return co;
+}
+
+/* mouse move with _sapp.mouse.dx/dy already updated */
+_SOKOL_PRIVATE void _sapp_x11_mouse_move_event(uint32_t mods) {
+    if (_sapp.desc.coalesce_mouse_events) {
+        _sapp_x11_coalesce_t* co = _sapp_x11_coalesce_begin(SAPP_EVENTTYPE_MOUSE_MOVE, mods);
+        co->dx += _sapp.mouse.dx;
+        co->dy += _sapp.mouse.dy;
+    }
+    else {
+        _sapp_x11_mouse_event(SAPP_EVENTTYPE_MOUSE_MOVE, SAPP_MOUSEBUTTON_INVALID, mods);
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_mouse_scroll_event(float x, float y, uint32_t mods) {
+    if (_sapp.desc.coalesce_mouse_events) {
+        _sapp_x11_coalesce_t* co = _sapp_x11_coalesce_begin(SAPP_EVENTTYPE_MOUSE_SCROLL, mods);
+        co->scroll_x += x;
+        co->scroll_y += y;
+    }
+    else {
+        _sapp_x11_scroll_event(x, y, mods);
+    }
+}
+
+/* true if an X event may be merged into a pending coalesced event */
+_SOKOL_PRIVATE bool _sapp_x11_is_coalescable(const XEvent* event) {
+    switch (event->type) {
+        case MotionNotify:
+        case GenericEvent:
+            return true;
+        case ButtonPress:
+        case ButtonRelease:
+            /* scroll wheel notches (the releases are dropped in _sapp_x11_process_event) */
+            return (event->xbutton.button >= 4) && (event->xbutton.button <= 7);
+        default:
+            return false;
     }
 }
 
@@ -10937,7 +11936,7 @@ _SOKOL_PRIVATE void _sapp_x11_key_event(sapp_event_type type, sapp_keycode key,
         _sapp.event.key_code = key;
         _sapp.event.key_repeat = repeat;
         _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
+        _sapp_x11_call_event();
         /* check if a CLIPBOARD_PASTED event must be sent too */
         if (_sapp.clipboard.enabled &&
             (type == SAPP_EVENTTYPE_KEY_DOWN) &&
@@ -10945,7 +11944,7 @@ _SOKOL_PRIVATE void _sapp_x11_key_event(sapp_event_type type, sapp_keycode key,
             (_sapp.event.key_code == SAPP_KEYCODE_V))
         {
             _sapp_init_event(SAPP_EVENTTYPE_CLIPBOARD_PASTED);
-            _sapp_call_event(&_sapp.event);
+            _sapp_x11_call_event();
         }
     }
 }
@@ -10956,7 +11955,7 @@ _SOKOL_PRIVATE void _sapp_x11_char_event(uint32_t chr, bool repeat, uint32_t mod
         _sapp.event.char_code = chr;
         _sapp.event.key_repeat = repeat;
         _sapp.event.modifiers = mods;
-        _sapp_call_event(&_sapp.event);
+        _sapp_x11_call_event();
     }
 }
 
@@ -11132,12 +12131,13 @@ _SOKOL_PRIVATE int32_t _sapp_x11_keysym_to_unicode(KeySym keysym) {
     return -1;
 }
 
-_SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src) {
+/* parse the XdndSelection data into a drop buffer of _sapp.drop.buf_size bytes */
+_SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src, char* buffer, int* num_files) {
     SOKOL_ASSERT(src);
-    SOKOL_ASSERT(_sapp.drop.buffer);
+    SOKOL_ASSERT(buffer && num_files);
 
-    _sapp_clear_drop_buffer();
-    _sapp.drop.num_files = 0;
+    _sapp_clear(buffer, (size_t)_sapp.drop.buf_size);
+    *num_files = 0;
 
     /*
         src is (potentially percent-encoded) string made of one or multiple paths
@@ -11146,7 +12146,7 @@ _SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src) {
     bool err = false;
     int src_count = 0;
     char src_chr = 0;
-    char* dst_ptr = _sapp.drop.buffer;
+    char* dst_ptr = buffer;
     const char* dst_end_ptr = dst_ptr + (_sapp.drop.max_path_length - 1); // room for terminating 0
     while (0 != (src_chr = *src++)) {
         src_count++;
@@ -11171,12 +12171,12 @@ _SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src) {
         }
         else if (src_chr == '\n') {
             src_count = 0;
-            _sapp.drop.num_files++;
+            (*num_files)++;
             // too many files is not an error
-            if (_sapp.drop.num_files >= _sapp.drop.max_files) {
+            if ((*num_files) >= _sapp.drop.max_files) {
                 break;
             }
-            dst_ptr = _sapp.drop.buffer + _sapp.drop.num_files * _sapp.drop.max_path_length;
+            dst_ptr = buffer + (*num_files) * _sapp.drop.max_path_length;
             dst_end_ptr = dst_ptr + (_sapp.drop.max_path_length - 1);
         }
         else if ((src_chr == '%') && src[0] && src[1]) {
@@ -11201,8 +12201,8 @@ _SOKOL_PRIVATE bool _sapp_x11_parse_dropped_files_list(const char* src) {
         }
     }
     if (err) {
-        _sapp_clear_drop_buffer();
-        _sapp.drop.num_files = 0;
+        _sapp_clear(buffer, (size_t)_sapp.drop.buf_size);
+        *num_files = 0;
         return false;
     }
     else {
@@ -11216,6 +12216,10 @@ static bool _sapp_x11_keycodes[256];
 
 _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
     Bool filtered = XFilterEvent(event, None);
+    /* keep the order of events intact: any other event first sends the pending coalesced event */
+    if (!_sapp_x11_is_coalescable(event)) {
+        _sapp_x11_flush_coalesced_event();
+    }
     switch (event->type) {
         case GenericEvent:
             if (_sapp.mouse.locked && _sapp.x11.xi.available) {
@@ -11232,7 +12236,7 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                                 if (XIMaskIsSet(re->valuators.mask, 1)) {
                                     _sapp.mouse.dy = (float) *values;
                                 }
-                                _sapp_x11_mouse_event(SAPP_EVENTTYPE_MOUSE_MOVE, SAPP_MOUSEBUTTON_INVALID, _sapp_x11_mods(event->xmotion.state));
+                                _sapp_x11_mouse_move_event(_sapp_x11_mods(event->xmotion.state));
                             }
                         }
                         XFreeEventData(_sapp.x11.display, &event->xcookie);
@@ -11302,10 +12306,10 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                 else {
                     /* might be a scroll event */
                     switch (event->xbutton.button) {
-                        case 4: _sapp_x11_scroll_event(0.0f, 1.0f, mods); break;
-                        case 5: _sapp_x11_scroll_event(0.0f, -1.0f, mods); break;
-                        case 6: _sapp_x11_scroll_event(1.0f, 0.0f, mods); break;
-                        case 7: _sapp_x11_scroll_event(-1.0f, 0.0f, mods); break;
+                        case 4: _sapp_x11_mouse_scroll_event(0.0f, 1.0f, mods); break;
+                        case 5: _sapp_x11_mouse_scroll_event(0.0f, -1.0f, mods); break;
+                        case 6: _sapp_x11_mouse_scroll_event(1.0f, 0.0f, mods); break;
+                        case 7: _sapp_x11_mouse_scroll_event(-1.0f, 0.0f, mods); break;
                     }
                 }
             }
@@ -11344,18 +12348,30 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                 _sapp.mouse.x = new_x;
                 _sapp.mouse.y = new_y;
                 _sapp.mouse.pos_valid = true;
-                _sapp_x11_mouse_event(SAPP_EVENTTYPE_MOUSE_MOVE, SAPP_MOUSEBUTTON_INVALID, _sapp_x11_mods(event->xmotion.state));
+                _sapp_x11_mouse_move_event(_sapp_x11_mods(event->xmotion.state));
             }
             break;
         case ConfigureNotify:
             if ((event->xconfigure.width != _sapp.window_width) || (event->xconfigure.height != _sapp.window_height)) {
-                _sapp.window_width = event->xconfigure.width;
-                _sapp.window_height = event->xconfigure.height;
-                _sapp.framebuffer_width = _sapp.window_width;
-                _sapp.framebuffer_height = _sapp.window_height;
+                _sapp_shared_store(&_sapp.window_width, event->xconfigure.width);
+                _sapp_shared_store(&_sapp.window_height, event->xconfigure.height);
+                _sapp_shared_store(&_sapp.framebuffer_width, event->xconfigure.width);
+                _sapp_shared_store(&_sapp.framebuffer_height, event->xconfigure.height);
                 _sapp_x11_app_event(SAPP_EVENTTYPE_RESIZED);
             }
             break;
+        case MapNotify:
+            _sapp.x11.unmapped = false;
+            _sapp_x11_update_suspended();
+            break;
+        case UnmapNotify:
+            _sapp.x11.unmapped = true;
+            _sapp_x11_update_suspended();
+            break;
+        case VisibilityNotify:
+            _sapp.x11.obscured = (event->xvisibility.state == VisibilityFullyObscured);
+            _sapp_x11_update_suspended();
+            break;
         case PropertyNotify:
             if (event->xproperty.state == PropertyNewValue) {
                 if (event->xproperty.atom == _sapp.x11.WM_STATE) {
@@ -11368,6 +12384,7 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                         else if (state == NormalState) {
                             _sapp_x11_app_event(SAPP_EVENTTYPE_RESTORED);
                         }
+                        _sapp_x11_update_suspended();
                     }
                 }
             }
@@ -11379,7 +12396,7 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
             if (event->xclient.message_type == _sapp.x11.WM_PROTOCOLS) {
                 const Atom protocol = (Atom)event->xclient.data.l[0];
                 if (protocol == _sapp.x11.WM_DELETE_WINDOW) {
-                    _sapp.quit_requested = true;
+                    _sapp_shared_store(&_sapp.quit_requested, true);
                 }
             }
             else if (event->xclient.message_type == _sapp.x11.xdnd.XdndEnter) {
@@ -11473,10 +12490,22 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
                                                                 event->xselection.target,
                                                                 (unsigned char**) &data);
                 if (_sapp.drop.enabled && result) {
-                    if (_sapp_x11_parse_dropped_files_list(data)) {
+                    if (_sapp.x11.render_thread.active) {
+                        /* the drop buffer belongs to the render thread, the files travel in the staging buffer */
+                        _sapp_x11_render_thread_t* rt = &_sapp.x11.render_thread;
+                        if (_sapp_x11_wait_drop_taken() &&
+                            _sapp_x11_parse_dropped_files_list(data, rt->drop_buffer, &rt->drop_num_files) &&
+                            _sapp_events_enabled())
+                        {
+                            _sapp_shared_store(&rt->drop_pending, true);
+                            _sapp_init_event(SAPP_EVENTTYPE_FILES_DROPPED);
+                            _sapp_x11_call_event();
+                        }
+                    }
+                    else if (_sapp_x11_parse_dropped_files_list(data, _sapp.drop.buffer, &_sapp.drop.num_files)) {
                         if (_sapp_events_enabled()) {
                             _sapp_init_event(SAPP_EVENTTYPE_FILES_DROPPED);
-                            _sapp_call_event(&_sapp.event);
+                            _sapp_x11_call_event();
                         }
                     }
                 }
@@ -11502,7 +12531,7 @@ _SOKOL_PRIVATE void _sapp_x11_process_event(XEvent* event) {
 
 #if !defined(_SAPP_GLX)
 
-_SOKOL_PRIVATE void _sapp_egl_init(void) {
+_SOKOL_PRIVATE void _sapp_egl_bind_api(void) {
 #if defined(SOKOL_GLCORE33)
     if (!eglBindAPI(EGL_OPENGL_API)) {
         _sapp_fail("EGL: failed to bind API");
@@ -11512,21 +12541,13 @@ _SOKOL_PRIVATE void _sapp_egl_init(void) {
         _sapp_fail("EGL: failed to bind API");
     }
 #endif
+}
 
-    _sapp.egl.display = eglGetDisplay((EGLNativeDisplayType)_sapp.x11.display);
-    if (EGL_NO_DISPLAY == _sapp.egl.display) {
-        _sapp_fail("EGL: failed to get display");
-    }
-
-    EGLint major, minor;
-    if (!eglInitialize(_sapp.egl.display, &major, &minor)) {
-        _sapp_fail("EGL: failed to initialize");
-    }
-
+_SOKOL_PRIVATE EGLConfig _sapp_egl_choose_config(EGLint surface_type) {
     EGLint sample_count = _sapp.desc.sample_count > 1 ? _sapp.desc.sample_count : 0;
     EGLint alpha_size = _sapp.desc.alpha ? 8 : 0;
     const EGLint config_attrs[] = {
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_SURFACE_TYPE, surface_type,
         #if defined(SOKOL_GLCORE33)
             EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
         #elif defined(SOKOL_GLES3)
@@ -11567,6 +12588,53 @@ _SOKOL_PRIVATE void _sapp_egl_init(void) {
             break;
         }
     }
+    return config;
+}
+
+_SOKOL_PRIVATE void _sapp_egl_create_context(EGLConfig config) {
+    EGLint ctx_attrs[] = {
+        #if defined(SOKOL_GLCORE33)
+            EGL_CONTEXT_MAJOR_VERSION, _sapp.desc.gl_major_version,
+            EGL_CONTEXT_MINOR_VERSION, _sapp.desc.gl_minor_version,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        #elif defined(SOKOL_GLES3)
+            EGL_CONTEXT_CLIENT_VERSION, _sapp.desc.gl_force_gles2 ? 2 : 3,
+        #else
+            EGL_CONTEXT_CLIENT_VERSION, 2,
+        #endif
+        EGL_NONE,
+    };
+
+    _sapp.egl.context = eglCreateContext(_sapp.egl.display, config, EGL_NO_CONTEXT, ctx_attrs);
+    if (EGL_NO_CONTEXT == _sapp.egl.context) {
+        _sapp_fail("EGL: failed to create GL context");
+    }
+
+    if (!eglMakeCurrent(_sapp.egl.display, _sapp.egl.surface, _sapp.egl.surface, _sapp.egl.context)) {
+        _sapp_fail("EGL: failed to set current context");
+    }
+
+    eglSwapInterval(_sapp.egl.display, _sapp.swap_interval);
+
+#if defined(SOKOL_GLES3)
+    _sapp.gles2_fallback = _sapp.desc.gl_force_gles2;
+#endif
+}
+
+_SOKOL_PRIVATE void _sapp_egl_init(void) {
+    _sapp_egl_bind_api();
+
+    _sapp.egl.display = eglGetDisplay((EGLNativeDisplayType)_sapp.x11.display);
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        _sapp_fail("EGL: failed to get display");
+    }
+
+    EGLint major, minor;
+    if (!eglInitialize(_sapp.egl.display, &major, &minor)) {
+        _sapp_fail("EGL: failed to initialize");
+    }
+
+    EGLConfig config = _sapp_egl_choose_config(EGL_WINDOW_BIT);
 
     EGLint visual_id;
     if (!eglGetConfigAttrib(_sapp.egl.display, config, EGL_NATIVE_VISUAL_ID, &visual_id)) {
@@ -11591,33 +12659,47 @@ _SOKOL_PRIVATE void _sapp_egl_init(void) {
         _sapp_fail("EGL: failed to create EGL surface");
     }
 
-    EGLint ctx_attrs[] = {
-        #if defined(SOKOL_GLCORE33)
-            EGL_CONTEXT_MAJOR_VERSION, _sapp.desc.gl_major_version,
-            EGL_CONTEXT_MINOR_VERSION, _sapp.desc.gl_minor_version,
-            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
-        #elif defined(SOKOL_GLES3)
-            EGL_CONTEXT_CLIENT_VERSION, _sapp.desc.gl_force_gles2 ? 2 : 3,
-        #else
-            EGL_CONTEXT_CLIENT_VERSION, 2,
-        #endif
-        EGL_NONE,
-    };
+    _sapp_egl_create_context(config);
+}
 
-    _sapp.egl.context = eglCreateContext(_sapp.egl.display, config, EGL_NO_CONTEXT, ctx_attrs);
-    if (EGL_NO_CONTEXT == _sapp.egl.context) {
-        _sapp_fail("EGL: failed to create GL context");
+/* headless mode: create a GL context which renders into a pbuffer, without a display connection */
+_SOKOL_PRIVATE void _sapp_egl_headless_init(void) {
+    _sapp_egl_bind_api();
+
+    /* prefer the surfaceless platform (works without X11, Wayland or DRM master) */
+    typedef EGLDisplay (*_sapp_egl_get_platform_display_t)(EGLenum, void*, const EGLint*);
+    const char* client_exts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    _sapp.egl.display = EGL_NO_DISPLAY;
+    if (client_exts && strstr(client_exts, "EGL_MESA_platform_surfaceless")) {
+        _sapp_egl_get_platform_display_t get_platform_display = (_sapp_egl_get_platform_display_t) eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (get_platform_display) {
+            _sapp.egl.display = get_platform_display(_SAPP_EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        }
+    }
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        _sapp.egl.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (EGL_NO_DISPLAY == _sapp.egl.display) {
+        _sapp_fail("EGL: failed to get display");
     }
 
-    if (!eglMakeCurrent(_sapp.egl.display, _sapp.egl.surface, _sapp.egl.surface, _sapp.egl.context)) {
-        _sapp_fail("EGL: failed to set current context");
+    EGLint major, minor;
+    if (!eglInitialize(_sapp.egl.display, &major, &minor)) {
+        _sapp_fail("EGL: failed to initialize");
     }
 
-    eglSwapInterval(_sapp.egl.display, _sapp.swap_interval);
+    EGLConfig config = _sapp_egl_choose_config(EGL_PBUFFER_BIT);
+    const EGLint pbuffer_attrs[] = {
+        EGL_WIDTH, _sapp.framebuffer_width,
+        EGL_HEIGHT, _sapp.framebuffer_height,
+        EGL_NONE,
+    };
+    _sapp.egl.surface = eglCreatePbufferSurface(_sapp.egl.display, config, pbuffer_attrs);
+    if (EGL_NO_SURFACE == _sapp.egl.surface) {
+        _sapp_fail("EGL: failed to create pbuffer surface");
+    }
 
-#if defined(SOKOL_GLES3)
-    _sapp.gles2_fallback = _sapp.desc.gl_force_gles2;
-#endif
+    _sapp_egl_create_context(config);
 }
 
 _SOKOL_PRIVATE void _sapp_egl_destroy(void) {
@@ -11641,6 +12723,314 @@ _SOKOL_PRIVATE void _sapp_egl_destroy(void) {
 
 #endif /* _SAPP_GLX */
 
+/* headless mode: wait until the next frame is due (only if a fixed frame rate was requested) */
+_SOKOL_PRIVATE void _sapp_headless_wait_frame(void) {
+    if (_sapp.desc.headless_frame_rate <= 0) {
+        return;
+    }
+    const double frame_duration = 1.0 / (double)_sapp.desc.headless_frame_rate;
+    _sapp.headless.next_frame_time += frame_duration;
+    const double now = _sapp_timestamp_now(&_sapp.headless.timestamp);
+    const double wait = _sapp.headless.next_frame_time - now;
+    if (wait > 0.0) {
+        struct timespec req;
+        req.tv_sec = (time_t) wait;
+        req.tv_nsec = (long) ((wait - (double)req.tv_sec) * 1000000000.0);
+        while (nanosleep(&req, &req) == -1) { /* interrupted by a signal, continue sleeping */ }
+    }
+    else {
+        /* frame took too long, don't try to catch up */
+        _sapp.headless.next_frame_time = now;
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_headless_run(void) {
+    if (0 == _sapp.window_width) {
+        _sapp.window_width = 640;
+    }
+    if (0 == _sapp.window_height) {
+        _sapp.window_height = 480;
+    }
+    _sapp.framebuffer_width = _sapp.window_width;
+    _sapp.framebuffer_height = _sapp.window_height;
+    _sapp.dpi_scale = 1.0f;
+#if !defined(_SAPP_GLX)
+    _sapp_egl_headless_init();
+#endif
+    _sapp.valid = true;
+    _sapp_timestamp_init(&_sapp.headless.timestamp);
+    while (!_sapp.quit_ordered) {
+        _sapp_timing_measure(&_sapp.timing);
+        _sapp_frame();
+#if !defined(_SAPP_GLX)
+        eglSwapBuffers(_sapp.egl.display, _sapp.egl.surface);
+#endif
+        /* handle quit-requested from sapp_request_quit() */
+        if (_sapp.quit_requested && !_sapp.quit_ordered) {
+            /* give user code a chance to intervene */
+            _sapp_x11_app_event(SAPP_EVENTTYPE_QUIT_REQUESTED);
+            /* if user code hasn't intervened, quit the app */
+            if (_sapp.quit_requested) {
+                _sapp.quit_ordered = true;
+            }
+        }
+        if (!_sapp.quit_ordered) {
+            _sapp_headless_wait_frame();
+        }
+    }
+    _sapp_call_cleanup();
+#if !defined(_SAPP_GLX)
+    _sapp_egl_destroy();
+#endif
+    _sapp_discard_state();
+}
+
+/* poll() timeout for a delay in seconds, rounded up, and clamped so that the cast can't overflow */
+_SOKOL_PRIVATE int _sapp_x11_timeout_ms(double seconds) {
+    double ms = seconds * 1000.0;
+    if (ms > (double)(INT_MAX - 1)) {
+        ms = (double)(INT_MAX - 1);
+    }
+    return (int) ms + 1;
+}
+
+/* render-on-demand mode: block until X events arrive, sapp_request_redraw() was
+    called, or the sapp_request_redraw_after() time has been reached,
+    returns true if the thread actually went to sleep
+*/
+_SOKOL_PRIVATE bool _sapp_x11_wait_redraw(void) {
+    /* replayed events are dispatched in the frame loop, so keep it running */
+    if (_sapp.evlog.replaying) {
+        return false;
+    }
+    /* in render thread mode, the event thread wakes up the render thread through the eventfd */
+    const bool render_thread = _sapp.x11.render_thread.active;
+    bool waited = false;
+    for (;;) {
+        if (render_thread ? !_sapp_x11_event_queue_empty() : (XPending(_sapp.x11.display) > 0)) {
+            break;
+        }
+        int timeout_ms = -1;
+        if (_sapp.x11.redraw_time >= 0.0) {
+            const double now = _sapp_timestamp_now(&_sapp.timing.timestamp);
+            if (now >= _sapp.x11.redraw_time) {
+                break;
+            }
+            timeout_ms = _sapp_x11_timeout_ms(_sapp.x11.redraw_time - now);
+        }
+        struct pollfd fds[2];
+        fds[0].fd = _sapp.x11.wakeup_fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = ConnectionNumber(_sapp.x11.display);
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        waited = true;
+        if (poll(fds, render_thread ? 1 : 2, timeout_ms) > 0) {
+            if (fds[0].revents & POLLIN) {
+                uint64_t count;
+                if (read(_sapp.x11.wakeup_fd, &count, sizeof(count)) != sizeof(count)) {
+                    /* can't happen, the eventfd counter is non-zero if readable */
+                }
+                break;
+            }
+        }
+        /* otherwise new data on the X connection (checked by XPending()), a timeout or EINTR */
+    }
+    return waited;
+}
+
+/* suspend-when-hidden mode: sleep until the window becomes visible again, a
+    background frame is due, or the application should quit (in render thread
+    mode, X11 events are handled on the main thread, and the render thread
+    keeps dispatching the queued events so that the main thread never waits
+    on a full queue)
+*/
+_SOKOL_PRIVATE void _sapp_x11_wait_suspended(void) {
+    const bool render_thread = _sapp.x11.render_thread.active;
+    double deadline = -1.0;
+    if (_sapp.desc.background_frame_rate > 0) {
+        deadline = _sapp_timestamp_now(&_sapp.timing.timestamp) + 1.0 / (double)_sapp.desc.background_frame_rate;
+    }
+    while (_sapp_shared_load(&_sapp.x11.suspended) && !_sapp_shared_load(&_sapp.quit_requested) && !_sapp_shared_load(&_sapp.quit_ordered)) {
+        if (render_thread) {
+            _sapp_x11_event_queue_dispatch();
+        }
+        else {
+            if (XPending(_sapp.x11.display) > 0) {
+                int count = XPending(_sapp.x11.display);
+                while (count--) {
+                    XEvent event;
+                    XNextEvent(_sapp.x11.display, &event);
+                    _sapp_x11_process_event(&event);
+                }
+                _sapp_x11_flush_coalesced_event();
+                continue;
+            }
+            XFlush(_sapp.x11.display);
+        }
+        int timeout_ms = -1;
+        if (deadline >= 0.0) {
+            const double now = _sapp_timestamp_now(&_sapp.timing.timestamp);
+            if (now >= deadline) {
+                break;
+            }
+            timeout_ms = _sapp_x11_timeout_ms(deadline - now);
+        }
+        struct pollfd fds[2];
+        fds[0].fd = _sapp.x11.wakeup_fd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = render_thread ? -1 : ConnectionNumber(_sapp.x11.display);
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if ((poll(fds, 2, timeout_ms) > 0) && (fds[0].revents & POLLIN)) {
+            /* redraw requests are ignored while suspended (in render thread mode, they signal new events) */
+            uint64_t count;
+            if (read(_sapp.x11.wakeup_fd, &count, sizeof(count)) != sizeof(count)) {
+                /* can't happen, the eventfd counter is non-zero if readable */
+            }
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sapp_x11_make_current(bool current) {
+#if defined(_SAPP_GLX)
+    if (current) {
+        _sapp_glx_make_current();
+    }
+    else {
+        _sapp.glx.MakeCurrent(_sapp.x11.display, None, NULL);
+    }
+#else
+    if (current) {
+        eglMakeCurrent(_sapp.egl.display, _sapp.egl.surface, _sapp.egl.surface, _sapp.egl.context);
+    }
+    else {
+        eglMakeCurrent(_sapp.egl.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+#endif
+}
+
+/* render thread mode: the render thread owns the GL context, and calls all user callbacks */
+_SOKOL_PRIVATE void* _sapp_x11_render_thread_func(void* arg) {
+    _SOKOL_UNUSED(arg);
+    _sapp_x11_make_current(true);
+    while (!_sapp_shared_load(&_sapp.quit_ordered)) {
+        if (_sapp_shared_load(&_sapp.x11.suspended)) {
+            _sapp_x11_wait_suspended();
+            _sapp_timing_discontinuity(&_sapp.timing);
+        }
+        else if (_sapp.desc.render_on_demand && !_sapp.first_frame) {
+            if (_sapp_x11_wait_redraw()) {
+                _sapp_timing_discontinuity(&_sapp.timing);
+            }
+            _sapp.x11.redraw_time = -1.0;
+        }
+        _sapp_timing_measure(&_sapp.timing);
+        _sapp_x11_event_queue_dispatch();
+        _sapp_frame();
+#if defined(_SAPP_GLX)
+        _sapp_glx_swap_buffers();
+#else
+        eglSwapBuffers(_sapp.egl.display, _sapp.egl.surface);
+#endif
+        /* handle quit-requested, either from window or from sapp_request_quit() */
+        if (_sapp_shared_load(&_sapp.quit_requested) && !_sapp.quit_ordered) {
+            /* _sapp.event belongs to the event thread, so use a separate event struct here */
+            if (_sapp_events_enabled()) {
+                sapp_event event;
+                _sapp_clear(&event, sizeof(event));
+                event.type = SAPP_EVENTTYPE_QUIT_REQUESTED;
+                event.frame_count = _sapp.frame_count;
+                event.mouse_button = SAPP_MOUSEBUTTON_INVALID;
+                event.window_width = _sapp_shared_load(&_sapp.window_width);
+                event.window_height = _sapp_shared_load(&_sapp.window_height);
+                event.framebuffer_width = _sapp_shared_load(&_sapp.framebuffer_width);
+                event.framebuffer_height = _sapp_shared_load(&_sapp.framebuffer_height);
+                event.mouse_x = _sapp.mouse.x;
+                event.mouse_y = _sapp.mouse.y;
+                _sapp_call_event(&event);
+            }
+            if (_sapp_shared_load(&_sapp.quit_requested)) {
+                _sapp_shared_store(&_sapp.quit_ordered, true);
+            }
+        }
+    }
+    _sapp_call_cleanup();
+    _sapp_x11_make_current(false);
+    const uint64_t one = 1;
+    if (write(_sapp.x11.render_thread.main_wakeup_fd, &one, sizeof(one)) != sizeof(one)) {
+        /* can't happen, the counter can't overflow */
+    }
+    return 0;
+}
+
+/* render thread mode: run the X11 event loop on the main thread until the render thread has finished */
+_SOKOL_PRIVATE void _sapp_x11_render_thread_run(void) {
+    _sapp_x11_render_thread_t* rt = &_sapp.x11.render_thread;
+    rt->queue.events = (sapp_event*) _sapp_malloc_clear(_SAPP_X11_EVENT_QUEUE_SIZE * sizeof(sapp_event));
+    if (_sapp.drop.enabled) {
+        rt->drop_buffer = (char*) _sapp_malloc_clear((size_t)_sapp.drop.buf_size);
+    }
+    rt->main_wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (rt->main_wakeup_fd < 0) {
+        _sapp_fail("X11: failed to create eventfd for render thread");
+    }
+    rt->main_thread = pthread_self();
+    rt->active = true;
+    /* the GL context is created on the main thread, and must be handed over to the render thread */
+    _sapp_x11_make_current(false);
+    if (0 != pthread_create(&rt->thread, NULL, _sapp_x11_render_thread_func, NULL)) {
+        _sapp_fail("X11: failed to create render thread");
+    }
+    while (!_sapp_shared_load(&_sapp.quit_ordered)) {
+        if (0 == XPending(_sapp.x11.display)) {
+            struct pollfd fds[2];
+            fds[0].fd = ConnectionNumber(_sapp.x11.display);
+            fds[0].events = POLLIN;
+            fds[0].revents = 0;
+            fds[1].fd = rt->main_wakeup_fd;
+            fds[1].events = POLLIN;
+            fds[1].revents = 0;
+            poll(fds, 2, -1);
+            if (fds[1].revents & POLLIN) {
+                /* the render thread has pushed commands, or has finished (quit_ordered is set) */
+                uint64_t count;
+                if (read(rt->main_wakeup_fd, &count, sizeof(count)) != sizeof(count)) {
+                    /* spurious wakeup, the eventfd is non-blocking */
+                }
+                _sapp_x11_cmd_queue_execute();
+                continue;
+            }
+        }
+        int count = XPending(_sapp.x11.display);
+        const bool has_events = count > 0;
+        while (count--) {
+            XEvent event;
+            XNextEvent(_sapp.x11.display, &event);
+            _sapp_x11_process_event(&event);
+        }
+        _sapp_x11_flush_coalesced_event();
+        _sapp_x11_cmd_queue_execute();
+        XFlush(_sapp.x11.display);
+        /* in render-on-demand mode, any window system event triggers a new frame */
+        if (has_events) {
+            sapp_request_redraw();
+        }
+    }
+    pthread_join(rt->thread, NULL);
+    rt->active = false;
+    close(rt->main_wakeup_fd);
+    rt->main_wakeup_fd = -1;
+    _sapp_free(rt->queue.events);
+    rt->queue.events = 0;
+    if (rt->drop_buffer) {
+        _sapp_free(rt->drop_buffer);
+        rt->drop_buffer = 0;
+    }
+}
+
 _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     /* The following lines are here to trigger a linker error instead of an
         obscure runtime error if the user has forgotten to add -pthread to
@@ -11651,6 +13041,16 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     pthread_attr_destroy(&pthread_attr);
 
     _sapp_init_state(desc);
+    _sapp.x11.wakeup_fd = -1;
+    _sapp.x11.redraw_time = -1.0;
+    _sapp.x11.render_thread.main_wakeup_fd = -1;
+    #if defined(SOKOL_LINUX_FORCE_HEADLESS)
+    _sapp.desc.headless = true;
+    #endif
+    if (_sapp.desc.headless) {
+        _sapp_headless_run();
+        return;
+    }
     _sapp.x11.window_state = NormalState;
 
     XInitThreads();
@@ -11684,8 +13084,31 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
         _sapp_x11_set_fullscreen(true);
     }
 
+    if (_sapp.desc.render_on_demand || _sapp.desc.suspend_when_hidden) {
+        _sapp.x11.wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_sapp.x11.wakeup_fd < 0) {
+            _sapp_fail("X11: failed to create eventfd");
+        }
+    }
+
     XFlush(_sapp.x11.display);
+    if (_sapp.desc.render_thread) {
+        _sapp_x11_render_thread_run();
+    }
     while (!_sapp.quit_ordered) {
+        /* suspend-when-hidden mode: don't render (or render at the background frame rate) while the window isn't visible */
+        if (_sapp.x11.suspended) {
+            _sapp_x11_wait_suspended();
+            _sapp_timing_discontinuity(&_sapp.timing);
+        }
+        /* render-on-demand mode: the first frame is always rendered, then wait for something to happen */
+        else if (_sapp.desc.render_on_demand && !_sapp.first_frame) {
+            if (_sapp_x11_wait_redraw()) {
+                /* don't let the idle time show up as frame duration */
+                _sapp_timing_discontinuity(&_sapp.timing);
+            }
+            _sapp.x11.redraw_time = -1.0;
+        }
         _sapp_timing_measure(&_sapp.timing);
         int count = XPending(_sapp.x11.display);
         while (count--) {
@@ -11693,6 +13116,7 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
             XNextEvent(_sapp.x11.display, &event);
             _sapp_x11_process_event(&event);
         }
+        _sapp_x11_flush_coalesced_event();
         _sapp_frame();
 #if defined(_SAPP_GLX)
         _sapp_glx_swap_buffers();
@@ -11717,6 +13141,10 @@ _SOKOL_PRIVATE void _sapp_linux_run(const sapp_desc* desc) {
     _sapp_egl_destroy();
 #endif
     _sapp_x11_destroy_window();
+    if (_sapp.x11.wakeup_fd >= 0) {
+        close(_sapp.x11.wakeup_fd);
+        _sapp.x11.wakeup_fd = -1;
+    }
     _sapp_x11_destroy_cursors();
     XCloseDisplay(_sapp.x11.display);
     _sapp_discard_state();
@@ -11781,15 +13209,48 @@ SOKOL_API_IMPL sapp_desc sapp_query_desc(void) {
 }
 
 SOKOL_API_IMPL uint64_t sapp_frame_count(void) {
-    return _sapp.frame_count;
+    return _sapp_shared_load(&_sapp.frame_count);
 }
 
 SOKOL_API_IMPL double sapp_frame_duration(void) {
+    if (_sapp.desc.fixed_frame_duration > 0.0) {
+        return _sapp.desc.fixed_frame_duration;
+    }
     return _sapp_timing_get_avg(&_sapp.timing);
 }
 
+SOKOL_API_IMPL sapp_frame_stats sapp_query_frame_stats(void) {
+    const _sapp_frame_stats_t* s = &_sapp.timing.stats;
+    sapp_frame_stats res;
+    _sapp_clear(&res, sizeof(res));
+    res.num_frames = s->num;
+    if (s->num > 0) {
+        res.avg = s->sum / (double)s->num;
+        res.min = s->min;
+        res.max = s->max;
+        res.p50 = _sapp_frame_stats_percentile(s, 0.50);
+        res.p95 = _sapp_frame_stats_percentile(s, 0.95);
+        res.p99 = _sapp_frame_stats_percentile(s, 0.99);
+    }
+    res.num_hitches_1_5x = s->num_hitches_1_5x;
+    res.num_hitches_2x = s->num_hitches_2x;
+    res.num_hitches_100ms = s->num_hitches_100ms;
+    res.num_recent = s->num_recent;
+    int pos = (s->recent_pos + SAPP_MAX_FRAME_STATS_SAMPLES - s->num_recent) % SAPP_MAX_FRAME_STATS_SAMPLES;
+    for (int i = 0; i < s->num_recent; i++) {
+        res.recent[i] = s->recent[pos];
+        pos = (pos + 1) % SAPP_MAX_FRAME_STATS_SAMPLES;
+    }
+    return res;
+}
+
+SOKOL_API_IMPL void sapp_reset_frame_stats(void) {
+    _sapp_clear(&_sapp.timing.stats, sizeof(_sapp.timing.stats));
+}
+
 SOKOL_API_IMPL int sapp_width(void) {
-    return (_sapp.framebuffer_width > 0) ? _sapp.framebuffer_width : 1;
+    const int w = _sapp_shared_load(&_sapp.framebuffer_width);
+    return (w > 0) ? w : 1;
 }
 
 SOKOL_API_IMPL float sapp_widthf(void) {
@@ -11797,7 +13258,8 @@ SOKOL_API_IMPL float sapp_widthf(void) {
 }
 
 SOKOL_API_IMPL int sapp_height(void) {
-    return (_sapp.framebuffer_height > 0) ? _sapp.framebuffer_height : 1;
+    const int h = _sapp_shared_load(&_sapp.framebuffer_height);
+    return (h > 0) ? h : 1;
 }
 
 SOKOL_API_IMPL float sapp_heightf(void) {
@@ -11892,12 +13354,19 @@ SOKOL_API_IMPL void sapp_toggle_fullscreen(void) {
     #elif defined(_SAPP_UWP)
     _sapp_uwp_toggle_fullscreen();
     #elif defined(_SAPP_LINUX)
-    _sapp_x11_toggle_fullscreen();
+    if (!_sapp_x11_cmd_defer(_SAPP_X11_CMD_TOGGLE_FULLSCREEN, false)) {
+        _sapp_x11_toggle_fullscreen();
+    }
     #endif
 }
 
 /* NOTE that sapp_show_mouse() does not "stack" like the Win32 or macOS API functions! */
 SOKOL_API_IMPL void sapp_show_mouse(bool show) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp_x11_cmd_defer(_SAPP_X11_CMD_SHOW_MOUSE, show)) {
+        return;
+    }
+    #endif
     if (_sapp.mouse.shown != show) {
         #if defined(_SAPP_MACOS)
         _sapp_macos_update_cursor(_sapp.mouse.current_cursor, show);
@@ -11926,7 +13395,9 @@ SOKOL_API_IMPL void sapp_lock_mouse(bool lock) {
     #elif defined(_SAPP_WIN32)
     _sapp_win32_lock_mouse(lock);
     #elif defined(_SAPP_LINUX)
-    _sapp_x11_lock_mouse(lock);
+    if (!_sapp_x11_cmd_defer(_SAPP_X11_CMD_LOCK_MOUSE, lock)) {
+        _sapp_x11_lock_mouse(lock);
+    }
     #else
     _sapp.mouse.locked = lock;
     #endif
@@ -11958,16 +13429,44 @@ SOKOL_API_IMPL sapp_mouse_cursor sapp_get_mouse_cursor(void) {
     return _sapp.mouse.current_cursor;
 }
 
+SOKOL_API_IMPL bool sapp_is_replaying(void) {
+    return _sapp.evlog.replaying;
+}
+
+SOKOL_API_IMPL void sapp_request_redraw(void) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.x11.wakeup_fd >= 0) {
+        const uint64_t one = 1;
+        if (write(_sapp.x11.wakeup_fd, &one, sizeof(one)) != sizeof(one)) {
+            /* counter overflow (EAGAIN), a wakeup is pending anyway */
+        }
+    }
+    #endif
+}
+
+SOKOL_API_IMPL void sapp_request_redraw_after(double seconds) {
+    #if defined(_SAPP_LINUX)
+    if (_sapp.desc.render_on_demand) {
+        const double t = _sapp_timestamp_now(&_sapp.timing.timestamp) + ((seconds > 0.0) ? seconds : 0.0);
+        if ((_sapp.x11.redraw_time < 0.0) || (t < _sapp.x11.redraw_time)) {
+            _sapp.x11.redraw_time = t;
+        }
+    }
+    #else
+    _SOKOL_UNUSED(seconds);
+    #endif
+}
+
 SOKOL_API_IMPL void sapp_request_quit(void) {
-    _sapp.quit_requested = true;
+    _sapp_shared_store(&_sapp.quit_requested, true);
 }
 
 SOKOL_API_IMPL void sapp_cancel_quit(void) {
-    _sapp.quit_requested = false;
+    _sapp_shared_store(&_sapp.quit_requested, false);
 }
 
 SOKOL_API_IMPL void sapp_quit(void) {
-    _sapp.quit_ordered = true;
+    _sapp_shared_store(&_sapp.quit_ordered, true);
 }
 
 SOKOL_API_IMPL void sapp_consume_event(void) {
@@ -26,6 +26,9 @@
                                   will be copied into an 8-byte aligned memory region associated
                                   with each in-flight request, default value is 16 (== 128 bytes)
     SFETCH_MAX_CHANNELS         - max number of IO channels (default is 16, also see sfetch_desc_t.num_channels)
+    SFETCH_MAX_CHANNEL_THREADS  - max number of IO threads per channel (default is 16, also see sfetch_desc_t.num_threads)
+    SFETCH_USE_IO_URING         - on Linux, use io_uring instead of blocking IO threads (see IO_URING below)
+    SFETCH_MAX_PACKS            - max number of mounted pack files (default is 8, also see sfetch_mount())
 
     If sokol_fetch.h is compiled as a DLL, define the following before
     including the declaration or implementation:
@@ -166,6 +169,20 @@
             (search below for CHANNELS AND LANES for more details). The
             default number of lanes is 1.
 
+        - num_threads (uint32_t):
+            The number of IO threads per channel. With more than one thread,
+            the requests in the lanes of a channel are processed concurrently
+            (search below for IO THREADS for more details). The default
+            is 1 thread per channel.
+
+        - max_lz4_block_size (uint32_t):
+            The max size of a compressed block in LZ4-compressed files.
+            Each lane gets a scratch buffer of this size for requests
+            with the lz4 flag (search below for LZ4 COMPRESSION). The
+            default is 0, which disables LZ4 decompression (sfetch_send()
+            then rejects requests with the lz4 flag and returns an invalid
+            handle).
+
     For example, to setup sokol-fetch for max 1024 active requests, 4 channels,
     and 8 lanes per channel in C99:
 
@@ -243,6 +260,16 @@
             important information how streaming works if the web server
             is serving compressed data.
 
+        - offset (uint64_t, optional)
+            The byte offset in the file where loading starts. This is
+            useful to load or stream a part of a big archive file. If
+            chunk_size is zero, everything from the offset to the end of the
+            file is loaded, otherwise streaming starts at the offset. The
+            response's fetched_offset is always relative to the start of
+            the file. If the offset is beyond the end of the file, the
+            request fails with SFETCH_ERROR_UNEXPECTED_EOF. The default
+            is 0.
+
         - buffer_ptr, buffer_size (void*, uint64_t, optional)
             This is a optional pointer/size pair describing a chunk of memory where
             data will be loaded into (if no buffer is provided upfront, this
@@ -261,6 +288,35 @@
             block is 8-byte aligned, and will be copied via memcpy() (so don't
             put any C++ "smart members" in there).
 
+        - memory_mapped (bool, optional)
+            If true, the file (or the current chunk when streaming) will be
+            mapped into memory on the IO thread instead of being read into
+            a buffer, no buffer needs to be bound to the request. Search below
+            for MEMORY-MAPPED REQUESTS for details. The default is false.
+
+        - priority (int, optional)
+            Requests which are waiting for a free lane are dispatched in
+            priority order, higher values first. Requests with the same
+            priority are dispatched in the order they were sent. The
+            default is 0. Search below for REQUEST PRIORITIES.
+
+        - yield_lane (bool, optional)
+            If true, a streaming request gives up its lane between chunks
+            when higher priority requests are waiting for a lane. The
+            default is false. Search below for REQUEST PRIORITIES.
+
+        - lz4 (bool, optional)
+            If true, the file is an LZ4 frame which is decompressed on the
+            IO thread, and the buffer receives the decompressed data. The
+            default is false. Search below for LZ4 COMPRESSION.
+
+        - readahead (bool, optional)
+            If true, a streaming request reads the next chunk into the
+            other half of the buffer while the response callback processes
+            the current chunk. Requires chunk_size > 0 and a buffer of at
+            least 2 * chunk_size bytes. The default is false. Search below
+            for STREAMING READAHEAD.
+
     NOTE that request handles are strictly thread-local and only unique
     within the thread the handle was created on, and all function calls
     involving a request handle must happen on that same thread.
@@ -400,6 +456,15 @@
     -------------------------
     Returns the value of the SFETCH_MAX_PATH config define.
 
+    sfetch_stats_t sfetch_query_stats(uint32_t channel)
+    ---------------------------------------------------
+    Returns the statistics of a channel since sfetch_setup() or the last
+    call to sfetch_reset_stats(), search below for STATISTICS AND TIMING.
+
+    void sfetch_reset_stats(void)
+    -----------------------------
+    Resets the statistics of all channels.
+
 
     REQUEST STATES AND THE RESPONSE CALLBACK
     ========================================
@@ -479,7 +544,7 @@
             - buffer_ptr: pointer to the start of fetched data
             - fetched_offset: the byte offset of the loaded data chunk in the
               overall file (this is only set to a non-zero value in a streaming
-              scenario)
+              scenario, or when the request has a non-zero offset)
 
         Once all file data has been loaded, the 'finished' flag will be set
         in the response callback's sfetch_response_t argument.
@@ -526,10 +591,15 @@
             - if the provided buffer is too small to hold the entire file
               (if request.chunk_size == 0), or the (potentially decompressed)
               partial data chunk (SFETCH_ERROR_BUFFER_TOO_SMALL)
-            - if less bytes could be read from the file then expected
+            - if less bytes could be read from the file then expected, or
+              the request offset is beyond the end of the file
               (SFETCH_ERROR_UNEXPECTED_EOF)
             - if a request has been cancelled via sfetch_cancel()
               (SFETCH_ERROR_CANCELLED)
+            - if mapping the file into memory failed for a memory-mapped
+              request (SFETCH_ERROR_MAPPING_FAILED)
+            - if the file of an LZ4 request isn't a valid or supported
+              LZ4 frame (SFETCH_ERROR_INVALID_LZ4_DATA)
 
         The response callback will be called once after a request goes into
         the FAILED state, with the 'response->finished' and
@@ -585,6 +655,30 @@
             }
 
 
+    LARGE FILES
+    ===========
+    All file sizes and offsets are 64-bit values, so files bigger than
+    4 GBytes can be loaded or streamed. Together with request.offset this
+    allows to stream from arbitrary positions of a big archive file:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "my_archive.bin",
+            .callback = response_callback,
+            .offset = 6000000000,
+            .chunk_size = 1024 * 1024,
+            .buffer_ptr = chunk_buf,
+            .buffer_size = sizeof(chunk_buf)
+        });
+
+    On 32-bit POSIX platforms, _FILE_OFFSET_BITS must be defined to 64
+    before including any system headers (for instance on the compiler
+    command line) to get 64-bit file offsets.
+
+    On the web platform, the offset is sent as part of a HTTP range
+    request, see CHUNK SIZE AND HTTP COMPRESSION below for the
+    implications.
+
+
     CHUNK SIZE AND HTTP COMPRESSION
     ===============================
     TL;DR: for streaming scenarios, the provided chunk-size must be smaller
@@ -688,6 +782,91 @@
         }
 
 
+    REQUEST PRIORITIES
+    ==================
+    Requests which are waiting for a free lane on their channel are
+    dispatched by priority instead of in the order they were sent:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "ui_texture.png",
+            .callback = my_response_callback,
+            .priority = 10
+        });
+
+    The priority of a request can be changed with:
+
+        sfetch_set_priority(handle, priority);
+
+    This only has an effect while the request is waiting for a lane.
+
+    Once a request occupies a lane, it usually keeps the lane until it has
+    finished, so a big streaming download with a low priority can block
+    all lanes of a channel. To prevent this, set the yield_lane flag:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "background_music.ogg",
+            .callback = my_response_callback,
+            .chunk_size = 64 * 1024,
+            .buffer_ptr = stream_buffer,
+            .buffer_size = sizeof(stream_buffer),
+            .priority = -1,
+            .yield_lane = true
+        });
+
+    After each chunk, the request checks whether more requests with a
+    higher priority are waiting than there are free lanes. If so, it gives
+    up its lane and waits for a free lane like a new request. When it
+    gets a lane again, streaming continues with the next chunk, without
+    another DISPATCHED response.
+
+    NOTE that a request which yields its lane may continue on a different
+    lane, so its buffer must not be a per-lane buffer like in the CHANNELS
+    AND LANES example above. Bind a buffer which belongs to the request
+    instead.
+
+
+    MEMORY-MAPPED REQUESTS
+    ======================
+    Loading a big file into a user-provided buffer means that all file
+    data is copied from the operating system's page cache into the buffer.
+    Setting the request's memory_mapped flag avoids that copy, instead the
+    file is mapped read-only into the address space on the IO thread, and
+    the response callback gets a pointer into the mapped memory:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "my_big_asset_pack.bin",
+            .callback = response_callback,
+            .memory_mapped = true
+        });
+
+        void response_callback(const sfetch_response_t* response) {
+            if (response->fetched) {
+                // buffer_ptr points into the memory mapping, the data
+                // is read-only and only valid until the callback returns
+                const void* data = response->buffer_ptr;
+                uint64_t num_bytes = response->fetched_size;
+            }
+        }
+
+    No buffer needs to be bound to a memory-mapped request (and a bound
+    buffer would be ignored), so the response callback will never be
+    called in the DISPATCHED state.
+
+    When loading the whole file (chunk_size == 0), the entire file is
+    mapped at once. When streaming (chunk_size > 0), each chunk is mapped
+    separately, and the mapping of the previous chunk is released before
+    the next chunk is mapped.
+
+    The memory mapping is released when the request is finished (after
+    the last callback has returned), also when the request has failed or
+    was cancelled. Don't hold on to the buffer_ptr after the response
+    callback returns, and never write to it.
+
+    Memory-mapped requests are not supported on the web platform, there
+    the memory_mapped flag is ignored and a buffer must be provided
+    as usual.
+
+
     NOTES ON OPTIMIZING PIPELINE LATENCY AND THROUGHPUT
     ===================================================
     With the default configuration of 1 channel and 1 lane per channel,
@@ -787,8 +966,257 @@
     for requests that need to start as soon as possible.
 
     On platforms with threading support, each channel runs on its own
-    thread, but this is mainly an implementation detail to work around
-    the blocking traditional file IO functions, not for performance reasons.
+    thread (or threads, see below), which is mainly an implementation detail
+    to work around the blocking traditional file IO functions.
+
+
+    IO THREADS
+    ==========
+    By default each channel has a single IO thread, so that only one
+    blocking file operation per channel is in progress at any time, even
+    if many lanes are occupied. Fast storage devices (like NVMe SSDs) can
+    process many reads in parallel, and a single thread leaves most of
+    that capacity unused.
+
+    The number of IO threads per channel can be configured in
+    sfetch_setup():
+
+        sfetch_setup(&(sfetch_desc_t){
+            .num_channels = 2,
+            .num_lanes = 16,
+            .num_threads = 4
+        });
+
+    Each IO thread has its own pair of lock-free single-producer/single-
+    consumer message queues to and from the user thread. sfetch_dowork()
+    hands each request to the thread with the fewest requests in flight,
+    and only wakes up IO threads which are actually waiting for work, so
+    that a busy IO thread doesn't cost the user thread a mutex or a
+    system call per request.
+
+    A request is only ever handled by one thread at a time, and it will
+    only move back into the IO threads after its response callback has
+    been called, so the order of chunks of a streaming request is
+    preserved, and pausing, continuing and cancelling requests works
+    exactly the same. Only the order in which *different* requests on the
+    same channel complete may change.
+
+    A channel never uses more threads than it has lanes, since more threads
+    wouldn't have anything to do. The maximum number of threads per channel
+    is defined by SFETCH_MAX_CHANNEL_THREADS (default: 16).
+
+    On the web platform, num_threads is ignored.
+
+
+    IO_URING
+    ========
+    On Linux, sokol-fetch can use io_uring (kernel 5.6 or newer) for local
+    file IO instead of blocking IO threads. To enable io_uring, define
+    SFETCH_USE_IO_URING before including the implementation:
+
+        #define SFETCH_USE_IO_URING
+        #define SOKOL_FETCH_IMPL
+        #include "sokol_fetch.h"
+
+    With io_uring, each channel has a single IO thread which submits the
+    open- and read-operations of all its lanes to the kernel at once, and
+    then waits for their completion. So the number of lanes (instead of
+    the number of threads) defines how many IO operations per channel are
+    in flight at the same time, and sfetch_desc_t.num_threads is ignored.
+
+    The file size is still queried with a blocking fstat() call, and files
+    are closed with a blocking close() call, and memory-mapped requests
+    are mapped on the IO thread with a blocking mmap() call as before.
+
+    If io_uring isn't available at runtime (for instance because the kernel
+    is too old, or io_uring has been disabled in a container), sokol-fetch
+    logs a message and falls back to the regular IO threads.
+
+    SFETCH_USE_IO_URING is ignored on all other platforms.
+
+
+    PACK FILES
+    ==========
+    Loading many small files pays for a file open and close per request.
+    To avoid this, files can be bundled into pack files which are mounted
+    once and stay open until sfetch_shutdown():
+
+        sfetch_setup(&(sfetch_desc_t){ ... });
+        sfetch_mount("assets.pack");
+
+    sfetch_mount() loads the pack file index into memory and returns false
+    if the pack file doesn't exist or isn't valid. When a request is sent,
+    its path is looked up in the mounted packs (the last mounted pack is
+    searched first, so that patch packs can override files in earlier
+    packs). Requests for files in a pack are loaded from the pack file's
+    file handle, all other requests are loaded from loose files as before.
+    Everything else (chunked streaming, offsets, memory-mapped requests,
+    pausing and cancelling) works the same for files in packs.
+
+    Only files sent *after* sfetch_mount() are resolved against the pack.
+    Packs can't be unmounted, the max number of mounted packs is defined
+    by SFETCH_MAX_PACKS (default: 8).
+
+    Pack files are created with the Python script util/sokol_fetch_pack.py,
+    which also documents the file format. Pack files only store a 64-bit
+    hash of each path (the script fails on hash collisions), so the paths
+    must be exactly the same as the paths passed to sfetch_send().
+
+    Multiple IO threads of a channel read the same pack file with
+    positional reads (pread() on POSIX platforms), only where pread() isn't
+    available the reads are serialized. Pack files are not supported on
+    the web platform, where sfetch_mount() always returns false.
+
+
+    LZ4 COMPRESSION
+    ===============
+    Compressed files can be decompressed on the IO threads, so that the
+    decompression doesn't take CPU time away from the thread which calls
+    sfetch_dowork(). The files must be in the LZ4 frame format as written
+    by the lz4 command line tool, for instance:
+
+        lz4 -9 -B4 level.bin level.bin.lz4
+
+    Decompression needs a scratch buffer per lane for the compressed data
+    of the current block, so first set the max compressed block size in
+    sfetch_setup() (the -B4 option above means 64 KB blocks):
+
+        sfetch_setup(&(sfetch_desc_t){
+            .num_lanes = 4,
+            .max_lz4_block_size = 64 * 1024
+        });
+
+    ...and then set the lz4 flag in the request:
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "level.bin.lz4",
+            .callback = response_callback,
+            .buffer_ptr = buf,
+            .buffer_size = sizeof(buf),
+            .lz4 = true
+        });
+
+    The buffer receives the decompressed data, and fetched_offset and
+    fetched_size in the response refer to the decompressed data.
+
+    When loading the whole file (chunk_size is 0), the buffer must be big
+    enough for the entire decompressed content, otherwise the request
+    fails with SFETCH_ERROR_BUFFER_TOO_SMALL. If the frame header contains
+    the content size (lz4 --content-size), this is checked before any
+    data is read.
+
+    When streaming (chunk_size > 0), each response contains the
+    decompressed data of exactly one LZ4 block, so the buffer must be at
+    least as big as the block size used for compression (for instance
+    64 KB with -B4), the actual value of chunk_size doesn't matter. Streaming
+    requires independent blocks (the lz4 tool's default, not -BD), since
+    the data of previous blocks isn't available anymore.
+
+    Blocks which are stored uncompressed are read directly into the
+    buffer. Block and content checksums are skipped but not verified, the
+    decoder checks all offsets and lengths though, so that corrupt data
+    results in SFETCH_ERROR_INVALID_LZ4_DATA instead of out-of-bounds
+    accesses. Dictionaries and request offsets aren't supported, and
+    LZ4 requests can't be memory-mapped.
+
+    With io_uring, the file is opened asynchronously but read and
+    decompressed with blocking reads on the channel's IO thread.
+
+    LZ4 decompression is not supported on the web platform, LZ4 requests
+    are rejected by sfetch_send() there (and when max_lz4_block_size is zero).
+
+
+    STREAMING READAHEAD
+    ===================
+    A streaming request normally alternates between reading a chunk on
+    the IO thread and processing it in the response callback, so the disk
+    waits for the callback, and the callback waits for the disk. With the
+    readahead flag, the IO thread reads the next chunk right after it has
+    handed the current chunk to the user thread:
+
+        static uint8_t buf[2 * 64 * 1024];
+
+        sfetch_send(&(sfetch_request_t){
+            .path = "music.ogg",
+            .callback = response_callback,
+            .buffer_ptr = buf,
+            .buffer_size = sizeof(buf),
+            .chunk_size = 64 * 1024,
+            .readahead = true
+        });
+
+    The buffer is split into two halves which take turns: while the
+    response callback looks at one half, the next chunk is read into the
+    other half. The response's buffer_ptr and buffer_size point to the half
+    which holds the fetched chunk, so the callback works the same as
+    without readahead. The buffer must be at least twice the chunk size.
+
+    Since an IO thread may still be reading into the buffer after the
+    response callback has returned, the buffer can only be bound or
+    unbound in the dispatched callback or after the request has finished.
+    Pausing and cancelling work as usual, a read which is in flight is
+    completed (and its result is kept or dropped) before the request
+    continues.
+
+    Independent of the readahead flag, streaming requests pass hints to
+    the operating system on POSIX platforms: loose files are opened for
+    sequential access (posix_fadvise() with POSIX_FADV_SEQUENTIAL), and
+    without readahead the range of the next chunk is announced
+    (POSIX_FADV_WILLNEED) before the current chunk is read, so that the
+    kernel can fetch it in the background. On Windows, files are already
+    opened with FILE_FLAG_SEQUENTIAL_SCAN.
+
+    With io_uring, readahead requests also alternate between the buffer
+    halves, but don't read ahead, since the in-flight reads of the other
+    lanes already keep the disk busy. Readahead can't be combined with
+    memory-mapped or LZ4 requests, and it's ignored on the web platform.
+
+
+    STATISTICS AND TIMING
+    =====================
+    To find out whether slow loads are caused by the disk (or network), by
+    requests waiting for a lane, or by sfetch_dowork() not being called
+    often enough, each response carries the timing of the IO operation
+    which produced it in response.timing (all durations in seconds):
+
+        - queue_wait: the time from sfetch_send() (or the end of the previous
+          response callback of a streaming request) until an IO thread
+          started the IO operation, this includes waiting for a free lane
+        - io_time: the duration of the IO operation on the IO thread (reading,
+          mapping or decompressing the data, or the HTTP request on the web)
+        - callback_wait: the time from the end of the IO operation until the
+          response callback is called in sfetch_dowork()
+
+    The timing is zero in the response callback of the DISPATCHED state.
+
+    In addition, sfetch_query_stats() returns the following statistics
+    for a channel since sfetch_setup() or the last call of sfetch_reset_stats():
+
+        - num_queued: the number of requests waiting for a free lane
+        - num_in_flight: the number of requests which occupy a lane
+        - num_lanes: the number of lanes of the channel
+        - lane_utilization: the average fraction of occupied lanes, a value
+          close to 1.0 means that requests are waiting for lanes most of the
+          time, more lanes (or channels) could help
+        - num_bytes: the number of fetched bytes
+        - num_completed, num_failed: the number of finished requests, cancelled
+          requests count as failed
+        - queue_wait, io_time, callback_wait: latency statistics over the
+          timing of all responses, except for paused and cancelled requests
+
+    The latency statistics contain the number of measurements, the average,
+    min and max durations, and the 50th, 95th and 99th percentile, which are
+    computed from a histogram and are accurate to about 6%. The buckets[]
+    array is a coarse histogram with power-of-two microsecond buckets:
+    buckets[i] counts durations of at least 2^(i-1) and below 2^i
+    microseconds (buckets[0] counts durations below 1 microsecond, and the
+    last bucket also counts all longer durations), for instance to draw
+    a latency graph.
+
+    Timing and statistics are measured on the user thread and the IO
+    threads with a monotonic clock. The statistics are only updated inside
+    sfetch_dowork(), and sfetch_query_stats() must be called on the thread
+    which called sfetch_setup().
 
 
     MEMORY ALLOCATION OVERRIDE
@@ -909,6 +1337,8 @@ typedef struct sfetch_desc_t {
     uint32_t max_requests;          /* max number of active requests across all channels (default: 128) */
     uint32_t num_channels;          /* number of channels to fetch requests in parallel (default: 1) */
     uint32_t num_lanes;             /* max number of requests active on the same channel (default: 1) */
+    uint32_t num_threads;           /* number of IO threads per channel (default: 1) */
+    uint32_t max_lz4_block_size;    /* max compressed LZ4 block size, allocated per lane (default: 0, no LZ4 support) */
     sfetch_allocator_t allocator;   /* optional memory allocation overrides (default: malloc/free) */
 } sfetch_desc_t;
 
@@ -923,9 +1353,18 @@ typedef enum sfetch_error_t {
     SFETCH_ERROR_BUFFER_TOO_SMALL,
     SFETCH_ERROR_UNEXPECTED_EOF,
     SFETCH_ERROR_INVALID_HTTP_STATUS,
-    SFETCH_ERROR_CANCELLED
+    SFETCH_ERROR_CANCELLED,
+    SFETCH_ERROR_MAPPING_FAILED,
+    SFETCH_ERROR_INVALID_LZ4_DATA
 } sfetch_error_t;
 
+/* the timing of the IO operation which produced a response (in seconds) */
+typedef struct sfetch_timing_t {
+    double queue_wait;              /* waiting for a free lane and an IO thread */
+    double io_time;                 /* reading, mapping or decompressing the data (or the HTTP request) */
+    double callback_wait;           /* from the end of the IO operation until the response callback */
+} sfetch_timing_t;
+
 /* the response struct passed to the response callback */
 typedef struct sfetch_response_t {
     sfetch_handle_t handle;         /* request handle this response belongs to */
@@ -940,10 +1379,11 @@ typedef struct sfetch_response_t {
     uint32_t lane;                  /* the lane this request occupies on its channel */
     const char* path;               /* the original filesystem path of the request (FIXME: this is unsafe, wrap in API call?) */
     void* user_data;                /* pointer to read/write user-data area (FIXME: this is unsafe, wrap in API call?) */
-    uint32_t fetched_offset;        /* current offset of fetched data chunk in file data */
-    uint32_t fetched_size;          /* size of fetched data chunk in number of bytes */
-    void* buffer_ptr;               /* pointer to buffer with fetched data */
-    uint32_t buffer_size;           /* overall buffer size (may be >= than fetched_size!) */
+    uint64_t fetched_offset;        /* current offset of fetched data chunk in file data */
+    uint64_t fetched_size;          /* size of fetched data chunk in number of bytes */
+    void* buffer_ptr;               /* pointer to buffer with fetched data (read-only for memory-mapped requests) */
+    uint64_t buffer_size;           /* overall buffer size (may be >= than fetched_size!) */
+    sfetch_timing_t timing;         /* timing breakdown of the IO operation (zero in the dispatched callback) */
 } sfetch_response_t;
 
 /* response callback function signature */
@@ -955,12 +1395,45 @@ typedef struct sfetch_request_t {
     const char* path;               /* filesystem path or HTTP URL (required) */
     sfetch_callback_t callback;     /* response callback function pointer (required) */
     void* buffer_ptr;               /* buffer pointer where data will be loaded into (optional) */
-    uint32_t buffer_size;           /* buffer size in number of bytes (optional) */
+    uint64_t buffer_size;           /* buffer size in number of bytes (optional) */
     uint32_t chunk_size;            /* number of bytes to load per stream-block (optional) */
+    uint64_t offset;                /* byte offset in the file where loading starts (optional) */
     const void* user_data_ptr;      /* pointer to a POD user-data block which will be memcpy'd(!) (optional) */
     uint32_t user_data_size;        /* size of user-data block (optional) */
+    bool memory_mapped;             /* map the file into memory instead of reading into a buffer (optional) */
+    int priority;                   /* requests with higher priority are dispatched first (optional, default: 0) */
+    bool yield_lane;                /* give up the lane between chunks when higher priority requests are waiting (optional) */
+    bool lz4;                       /* the file is an LZ4 frame, decompress into the buffer (optional, not on web) */
+    bool readahead;                 /* when streaming, read the next chunk into the other buffer half while the current chunk is processed (optional, not on web) */
 } sfetch_request_t;
 
+/* latency statistics (in seconds), see STATISTICS AND TIMING */
+#define SFETCH_NUM_LATENCY_BUCKETS (24)
+typedef struct sfetch_latency_t {
+    uint64_t num;                   /* number of measurements */
+    double avg;                     /* average duration */
+    double min;                     /* shortest duration */
+    double max;                     /* longest duration */
+    double p50;                     /* median duration */
+    double p95;                     /* 95th percentile duration */
+    double p99;                     /* 99th percentile duration */
+    uint32_t buckets[SFETCH_NUM_LATENCY_BUCKETS];  /* bucket i: number of durations below 2^i microseconds (and not below 2^(i-1)) */
+} sfetch_latency_t;
+
+/* per-channel statistics, returned by sfetch_query_stats() */
+typedef struct sfetch_stats_t {
+    uint32_t num_queued;            /* requests waiting for a free lane */
+    uint32_t num_in_flight;         /* requests which occupy a lane */
+    uint32_t num_lanes;             /* number of lanes of the channel */
+    double lane_utilization;        /* average fraction of occupied lanes (0.0 .. 1.0) */
+    uint64_t num_bytes;             /* number of bytes fetched */
+    uint64_t num_completed;         /* requests which have finished successfully */
+    uint64_t num_failed;            /* requests which have failed or were cancelled */
+    sfetch_latency_t queue_wait;    /* see sfetch_timing_t */
+    sfetch_latency_t io_time;
+    sfetch_latency_t callback_wait;
+} sfetch_stats_t;
+
 /* setup sokol-fetch (can be called on multiple threads) */
 SOKOL_FETCH_API_DECL void sfetch_setup(const sfetch_desc_t* desc);
 /* discard a sokol-fetch context */
@@ -982,7 +1455,7 @@ SOKOL_FETCH_API_DECL bool sfetch_handle_valid(sfetch_handle_t h);
 SOKOL_FETCH_API_DECL void sfetch_dowork(void);
 
 /* bind a data buffer to a request (request must not currently have a buffer bound, must be called from response callback */
-SOKOL_FETCH_API_DECL void sfetch_bind_buffer(sfetch_handle_t h, void* buffer_ptr, uint32_t buffer_size);
+SOKOL_FETCH_API_DECL void sfetch_bind_buffer(sfetch_handle_t h, void* buffer_ptr, uint64_t buffer_size);
 /* clear the 'buffer binding' of a request, returns previous buffer pointer (can be 0), must be called from response callback */
 SOKOL_FETCH_API_DECL void* sfetch_unbind_buffer(sfetch_handle_t h);
 /* cancel a request that's in flight (will call response callback with .cancelled + .finished) */
@@ -991,6 +1464,14 @@ SOKOL_FETCH_API_DECL void sfetch_cancel(sfetch_handle_t h);
 SOKOL_FETCH_API_DECL void sfetch_pause(sfetch_handle_t h);
 /* continue a paused request */
 SOKOL_FETCH_API_DECL void sfetch_continue(sfetch_handle_t h);
+/* change the priority of a request which is waiting for a lane or yields its lane */
+SOKOL_FETCH_API_DECL void sfetch_set_priority(sfetch_handle_t h, int priority);
+/* mount a pack file, requests for files in the pack will be loaded from the pack (returns false on error) */
+SOKOL_FETCH_API_DECL bool sfetch_mount(const char* pack_path);
+/* get the statistics of a channel since sfetch_setup() or the last sfetch_reset_stats() */
+SOKOL_FETCH_API_DECL sfetch_stats_t sfetch_query_stats(uint32_t channel);
+/* reset the statistics of all channels */
+SOKOL_FETCH_API_DECL void sfetch_reset_stats(void);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -1022,6 +1503,12 @@ inline sfetch_handle_t sfetch_send(const sfetch_request_t& request) { return sfe
 #ifndef SFETCH_MAX_CHANNELS
 #define SFETCH_MAX_CHANNELS (16)
 #endif
+#ifndef SFETCH_MAX_CHANNEL_THREADS
+#define SFETCH_MAX_CHANNEL_THREADS (16)
+#endif
+#ifndef SFETCH_MAX_PACKS
+#define SFETCH_MAX_PACKS (8)
+#endif
 
 #ifndef SOKOL_API_IMPL
     #define SOKOL_API_IMPL
@@ -1076,11 +1563,37 @@ inline sfetch_handle_t sfetch_send(const sfetch_request_t& request) { return sfe
     #define _SFETCH_HAS_THREADS (1)
 #else
     #include <pthread.h>
-    #include <stdio.h>  /* fopen, fread, fseek, fclose */
+    #include <errno.h>      /* errno, EINTR */
+    #include <fcntl.h>      /* open */
+    #include <sys/mman.h>   /* mmap, munmap */
+    #include <sys/stat.h>   /* fstat */
+    #include <unistd.h>     /* read, pread, lseek, close, sysconf */
+    #include <sched.h>      /* sched_yield */
+    #include <time.h>       /* clock_gettime */
     #define _SFETCH_PLATFORM_POSIX (1)
     #define _SFETCH_PLATFORM_EMSCRIPTEN (0)
     #define _SFETCH_PLATFORM_WINDOWS (0)
     #define _SFETCH_HAS_THREADS (1)
+    /* pread() and posix_fadvise() are hidden in strict C mode without POSIX feature macros */
+    #if !defined(__STRICT_ANSI__) || (defined(_POSIX_C_SOURCE) && (_POSIX_C_SOURCE >= 200809L)) || (defined(_XOPEN_SOURCE) && (_XOPEN_SOURCE >= 500))
+        #define _SFETCH_HAS_PREAD (1)
+    #else
+        #define _SFETCH_HAS_PREAD (0)
+    #endif
+    #if defined(POSIX_FADV_SEQUENTIAL)
+        #define _SFETCH_HAS_FADVISE (1)
+    #else
+        #define _SFETCH_HAS_FADVISE (0)
+    #endif
+#endif
+#if _SFETCH_PLATFORM_POSIX && defined(__linux__) && defined(SFETCH_USE_IO_URING)
+    #include <linux/io_uring.h>
+    #include <sys/eventfd.h>    /* eventfd */
+    #include <poll.h>           /* poll */
+    #include <sys/syscall.h>    /* syscall, __NR_io_uring_* */
+    #define _SFETCH_USE_IO_URING (1)
+#else
+    #define _SFETCH_USE_IO_URING (0)
 #endif
 
 /*=== private type definitions ===============================================*/
@@ -1090,38 +1603,59 @@ typedef struct _sfetch_path_t {
 
 typedef struct _sfetch_buffer_t {
     uint8_t* ptr;
-    uint32_t size;
+    uint64_t size;
 } _sfetch_buffer_t;
 
-/* a thread with incoming and outgoing message queue syncing */
-#if _SFETCH_PLATFORM_POSIX
+/* a ringbuffer for pool-slot ids, the message queues between the user
+   thread and an IO thread are single-producer/single-consumer rings where
+   only the producer writes head and only the consumer writes tail
+*/
 typedef struct {
-    pthread_t thread;
-    pthread_cond_t incoming_cond;
-    pthread_mutex_t incoming_mutex;
-    pthread_mutex_t outgoing_mutex;
-    pthread_mutex_t running_mutex;
-    pthread_mutex_t stop_mutex;
-    bool stop_requested;
-    bool valid;
-} _sfetch_thread_t;
-#elif _SFETCH_PLATFORM_WINDOWS
+    uint32_t head;
+    uint32_t tail;
+    uint32_t num;
+    uint32_t* buf;
+} _sfetch_ring_t;
+
+/* a group of IO threads, each with its own incoming and outgoing message queue */
+#if _SFETCH_HAS_THREADS
 typedef struct {
+    _sfetch_ring_t incoming;    /* user thread => IO thread */
+    _sfetch_ring_t outgoing;    /* IO thread => user thread */
+    uint32_t waiting;           /* atomic: set while the IO thread waits for incoming requests */
+    uint32_t num_assigned;      /* user thread only: number of requests handed to this IO thread */
+    uint32_t index;
+    void* arg;                  /* argument for the thread function */
+    #if _SFETCH_PLATFORM_POSIX
+    pthread_t thread;
+    pthread_mutex_t wait_mutex;
+    pthread_cond_t wait_cond;
+    #elif _SFETCH_PLATFORM_WINDOWS
     HANDLE thread;
-    HANDLE incoming_event;
-    CRITICAL_SECTION incoming_critsec;
-    CRITICAL_SECTION outgoing_critsec;
+    HANDLE wait_event;
+    #endif
+} _sfetch_thread_worker_t;
+
+typedef struct {
+    uint32_t num_threads;
+    _sfetch_thread_worker_t workers[SFETCH_MAX_CHANNEL_THREADS];
+    #if _SFETCH_PLATFORM_POSIX
+    pthread_mutex_t running_mutex;
+    #elif _SFETCH_PLATFORM_WINDOWS
     CRITICAL_SECTION running_critsec;
-    CRITICAL_SECTION stop_critsec;
-    bool stop_requested;
+    #endif
+    #if _SFETCH_USE_IO_URING
+    int wakeup_fd;      /* eventfd to wake up an io_uring thread, or -1 */
+    #endif
+    uint32_t stop_requested;    /* atomic */
     bool valid;
 } _sfetch_thread_t;
 #endif
 
 /* file handle abstraction */
 #if _SFETCH_PLATFORM_POSIX
-typedef FILE* _sfetch_file_handle_t;
-#define _SFETCH_INVALID_FILE_HANDLE (0)
+typedef int _sfetch_file_handle_t;
+#define _SFETCH_INVALID_FILE_HANDLE (-1)
 typedef void*(*_sfetch_thread_func_t)(void*);
 #elif _SFETCH_PLATFORM_WINDOWS
 typedef HANDLE _sfetch_file_handle_t;
@@ -1129,36 +1663,147 @@ typedef HANDLE _sfetch_file_handle_t;
 typedef LPTHREAD_START_ROUTINE _sfetch_thread_func_t;
 #endif
 
+/* an io_uring instance with its memory-mapped submission and completion queues */
+#if _SFETCH_USE_IO_URING
+typedef struct {
+    int fd;
+    int wakeup_fd;              /* eventfd which wakes the thread from io_uring_enter() */
+    uint64_t wakeup_value;      /* target buffer for the pending eventfd read */
+    uint32_t* sq_head;
+    uint32_t* sq_tail;
+    uint32_t* sq_mask;
+    uint32_t* sq_array;
+    uint32_t* cq_head;
+    uint32_t* cq_tail;
+    uint32_t* cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_ptr;
+    size_t sq_size;
+    void* cq_ptr;
+    size_t cq_size;
+    size_t sqes_size;
+    uint32_t num_to_submit;
+    uint32_t num_in_kernel;     /* submitted operations without a reaped completion */
+    bool valid;
+} _sfetch_uring_t;
+#endif
+
+/* a read-only memory mapping of a file range */
+#if !_SFETCH_PLATFORM_EMSCRIPTEN
+typedef struct {
+    void* base;     /* start of the mapping (aligned to page size or allocation granularity) */
+    size_t size;    /* size of the mapping starting at base */
+    uint8_t* ptr;   /* start of the requested file range inside the mapping */
+} _sfetch_mapping_t;
+#endif
+
+/* a mounted pack file, the index is sorted by path hash */
+#if _SFETCH_HAS_THREADS
+#define _SFETCH_PACK_MAGIC (0x4B504653)     /* 'SFPK' */
+#define _SFETCH_PACK_VERSION (1)
+#define _SFETCH_PACK_HEADER_SIZE (16)
+#define _SFETCH_PACK_ENTRY_SIZE (32)
+typedef struct {
+    uint64_t path_hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t flags;
+} _sfetch_pack_entry_t;
+
+typedef struct {
+    _sfetch_file_handle_t file_handle;  /* kept open until sfetch_shutdown() */
+    uint32_t num_entries;
+    _sfetch_pack_entry_t* entries;
+    #if _SFETCH_PLATFORM_POSIX && !_SFETCH_HAS_PREAD
+    pthread_mutex_t read_mutex;         /* serializes seek+read from multiple IO threads */
+    #endif
+    bool valid;
+} _sfetch_pack_t;
+#endif
+
 /* user-side per-request state */
 typedef struct {
     bool pause;                 /* switch item to PAUSED state if true */
     bool cont;                  /* switch item back to FETCHING if true */
     bool cancel;                /* cancel the request, switch into FAILED state */
     /* transfer IO => user thread */
-    uint32_t fetched_offset;    /* number of bytes fetched so far */
-    uint32_t fetched_size;      /* size of last fetched chunk */
+    uint64_t fetched_offset;    /* file offset after the last fetched chunk */
+    uint64_t fetched_size;      /* size of last fetched chunk */
+    uint64_t fetched_buffer_offset; /* offset of the fetched chunk in the buffer (readahead) */
     sfetch_error_t error_code;
     bool finished;
     /* user thread only */
+    uint64_t queued_time;       /* when the request started to wait for the next IO operation */
+    sfetch_timing_t timing;     /* timing of the last IO operation */
     uint32_t user_data_size;
     uint64_t user_data[SFETCH_MAX_USERDATA_UINT64];
 } _sfetch_item_user_t;
 
+/* IO-thread state of an LZ4 request, the scratch buffer is set
+   by the user thread when a lane is assigned
+*/
+#if !_SFETCH_PLATFORM_EMSCRIPTEN
+typedef struct {
+    bool enabled;
+    bool header_done;
+    bool dependent_blocks;      /* blocks may refer to the data of previous blocks */
+    bool block_checksums;
+    bool done;                  /* the end mark has been reached */
+    uint32_t next_block_size;   /* size field of the next block, read together with the previous block */
+    uint64_t read_offset;       /* offset of the next block data in the compressed file */
+    uint8_t* scratch;           /* the lane's scratch buffer for compressed blocks */
+    uint32_t scratch_size;
+} _sfetch_lz4_t;
+
+/* IO-thread state of a streaming request with readahead, the next chunk is
+   read into the other half of the buffer after the current chunk has been
+   handed to the user thread, the read parameters are captured before the
+   handoff since the item then belongs to the user thread
+*/
+typedef struct {
+    uint32_t busy;              /* atomic: set while the next chunk is read */
+    uint32_t half;              /* the buffer half which receives the next chunk */
+    bool pending;               /* start reading the next chunk after the handoff */
+    bool valid;                 /* the next chunk is in the buffer */
+    bool failed;
+    _sfetch_file_handle_t file_handle;
+    _sfetch_pack_t* pack;
+    uint64_t offset;            /* file range of the next chunk */
+    uint64_t size;
+    uint8_t* ptr;
+} _sfetch_readahead_t;
+#endif
+
 /* thread-side per-request state */
 typedef struct {
     /* transfer IO => user thread */
-    uint32_t fetched_offset;
-    uint32_t fetched_size;
+    uint64_t fetched_offset;
+    uint64_t fetched_size;
+    uint64_t fetched_buffer_offset;
+    uint64_t io_start_time;     /* start and end of the last IO operation */
+    uint64_t io_end_time;
     sfetch_error_t error_code;
     bool failed;
     bool finished;
     /* IO thread only */
     #if _SFETCH_PLATFORM_EMSCRIPTEN
-    uint32_t http_range_offset;
+    uint64_t http_range_offset;
     #else
     _sfetch_file_handle_t file_handle;
+    _sfetch_mapping_t mapping;
+    _sfetch_pack_t* pack;       /* the pack file which contains the file, or null for loose files */
+    uint64_t pack_offset;       /* start and size of the file in the pack file */
+    uint64_t pack_size;
+    _sfetch_lz4_t lz4;
+    _sfetch_readahead_t readahead;
     #endif
-    uint32_t content_size;
+    #if _SFETCH_USE_IO_URING
+    uint64_t uring_read_offset;     /* file range of the current read */
+    uint64_t uring_read_size;
+    uint64_t uring_read_done;       /* number of bytes read so far (reads may be short) */
+    #endif
+    uint64_t content_size;
 } _sfetch_item_thread_t;
 
 /* a request goes through the following states, ping-ponging between IO and user thread */
@@ -1180,6 +1825,10 @@ typedef struct {
     uint32_t channel;
     uint32_t lane;
     uint32_t chunk_size;
+    bool memory_mapped;
+    bool yield_lane;
+    bool readahead;
+    int priority;               /* user thread only */
     sfetch_callback_t callback;
     _sfetch_buffer_t buffer;
 
@@ -1203,13 +1852,38 @@ typedef struct {
     bool valid;
 } _sfetch_pool_t;
 
-/* a ringbuffer for pool-slot ids */
+/*
+    Latency statistics (see sfetch_query_stats()), in microseconds.
+
+    Percentiles are computed from a log-linear histogram: durations below
+    8us have one bucket per microsecond, each power-of-two range above
+    that is split into 8 linear buckets, durations above 16 seconds go
+    into the last bucket.
+*/
+#define _SFETCH_LATENCY_SUB_BITS (3)
+#define _SFETCH_LATENCY_SUB_BUCKETS (1<<_SFETCH_LATENCY_SUB_BITS)
+#define _SFETCH_LATENCY_MAX_EXP (23)
+#define _SFETCH_LATENCY_NUM_BUCKETS ((_SFETCH_LATENCY_MAX_EXP - _SFETCH_LATENCY_SUB_BITS + 2) * _SFETCH_LATENCY_SUB_BUCKETS)
 typedef struct {
-    uint32_t head;
-    uint32_t tail;
-    uint32_t num;
-    uint32_t* buf;
-} _sfetch_ring_t;
+    uint64_t num;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint32_t buckets[_SFETCH_LATENCY_NUM_BUCKETS];
+} _sfetch_latency_t;
+
+/* per-channel statistics, only accessed on the user thread */
+typedef struct {
+    uint64_t start_time;        /* sfetch_setup() or sfetch_reset_stats() */
+    uint64_t lane_update_time;
+    uint64_t lane_time;         /* sum of the time lanes have been occupied */
+    uint64_t num_bytes;
+    uint64_t num_completed;
+    uint64_t num_failed;
+    _sfetch_latency_t queue_wait;
+    _sfetch_latency_t io_time;
+    _sfetch_latency_t callback_wait;
+} _sfetch_stats_t;
 
 /* an IO channel with its own IO thread */
 struct _sfetch_t;
@@ -1221,11 +1895,18 @@ typedef struct {
     _sfetch_ring_t user_incoming;
     _sfetch_ring_t user_outgoing;
     #if _SFETCH_HAS_THREADS
-    _sfetch_ring_t thread_incoming;
-    _sfetch_ring_t thread_outgoing;
     _sfetch_thread_t thread;
     #endif
+    #if _SFETCH_USE_IO_URING
+    _sfetch_uring_t uring;
+    #endif
+    #if _SFETCH_HAS_THREADS
+    uint8_t* lz4_buffers;       /* one scratch buffer per lane for LZ4 requests */
+    uint32_t lz4_buffer_size;
+    #endif
     void (*request_handler)(struct _sfetch_t* ctx, uint32_t slot_id);
+    uint32_t num_lanes;
+    _sfetch_stats_t stats;
     bool valid;
 } _sfetch_channel_t;
 
@@ -1237,6 +1918,10 @@ typedef struct _sfetch_t {
     sfetch_desc_t desc;
     _sfetch_pool_t pool;
     _sfetch_channel_t chn[SFETCH_MAX_CHANNELS];
+    #if _SFETCH_HAS_THREADS
+    uint32_t num_packs;
+    _sfetch_pack_t packs[SFETCH_MAX_PACKS];
+    #endif
 } _sfetch_t;
 #if _SFETCH_HAS_THREADS
 #if defined(_MSC_VER)
@@ -1327,6 +2012,172 @@ _SOKOL_PRIVATE uint32_t _sfetch_slot_index(uint32_t slot_id) {
     return slot_id & 0xFFFF;
 }
 
+/*=== request statistics =====================================================*/
+
+/* a monotonic timestamp in nanoseconds, comparable between threads */
+_SOKOL_PRIVATE uint64_t _sfetch_now(void) {
+    #if _SFETCH_PLATFORM_EMSCRIPTEN
+        return (uint64_t)(emscripten_get_now() * 1000000.0);
+    #elif _SFETCH_PLATFORM_WINDOWS
+        LARGE_INTEGER freq, counter;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&counter);
+        const uint64_t f = (uint64_t)freq.QuadPart;
+        const uint64_t c = (uint64_t)counter.QuadPart;
+        return ((c / f) * 1000000000) + (((c % f) * 1000000000) / f);
+    #else
+        struct timespec ts;
+        #if defined(CLOCK_MONOTONIC)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        #else
+        /* strict C mode without POSIX feature macros */
+        timespec_get(&ts, TIME_UTC);
+        #endif
+        return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+    #endif
+}
+
+_SOKOL_PRIVATE uint64_t _sfetch_elapsed(uint64_t start_time, uint64_t end_time) {
+    return (end_time > start_time) ? (end_time - start_time) : 0;
+}
+
+_SOKOL_PRIVATE double _sfetch_seconds(uint64_t ns) {
+    return (double)ns * 1.0e-9;
+}
+
+_SOKOL_PRIVATE int _sfetch_latency_bucket(uint64_t us) {
+    if (us < _SFETCH_LATENCY_SUB_BUCKETS) {
+        return (int)us;
+    }
+    int e = _SFETCH_LATENCY_SUB_BITS;
+    while (((us >> (e + 1)) != 0) && (e < _SFETCH_LATENCY_MAX_EXP)) {
+        e++;
+    }
+    if ((us >> (e + 1)) != 0) {
+        return _SFETCH_LATENCY_NUM_BUCKETS - 1;
+    }
+    const int sub = (int)((us >> (e - _SFETCH_LATENCY_SUB_BITS)) & (_SFETCH_LATENCY_SUB_BUCKETS - 1));
+    return (e - _SFETCH_LATENCY_SUB_BITS + 1) * _SFETCH_LATENCY_SUB_BUCKETS + sub;
+}
+
+/* returns the lower bound and width of a histogram bucket in microseconds */
+_SOKOL_PRIVATE uint64_t _sfetch_latency_bucket_lower(int bucket, uint64_t* out_width) {
+    if (bucket < _SFETCH_LATENCY_SUB_BUCKETS) {
+        *out_width = 1;
+        return (uint64_t)bucket;
+    }
+    const int e = (bucket / _SFETCH_LATENCY_SUB_BUCKETS) + _SFETCH_LATENCY_SUB_BITS - 1;
+    const int sub = bucket % _SFETCH_LATENCY_SUB_BUCKETS;
+    *out_width = 1ULL << (e - _SFETCH_LATENCY_SUB_BITS);
+    return (uint64_t)(_SFETCH_LATENCY_SUB_BUCKETS + sub) * *out_width;
+}
+
+_SOKOL_PRIVATE void _sfetch_latency_put(_sfetch_latency_t* l, uint64_t ns) {
+    const uint64_t us = (ns + 500) / 1000;
+    if ((0 == l->num) || (us < l->min)) {
+        l->min = us;
+    }
+    if (us > l->max) {
+        l->max = us;
+    }
+    l->num++;
+    l->sum += us;
+    l->buckets[_sfetch_latency_bucket(us)]++;
+}
+
+/* returns the duration in seconds below or at which the fraction p of all samples lie */
+_SOKOL_PRIVATE double _sfetch_latency_percentile(const _sfetch_latency_t* l, double p) {
+    SOKOL_ASSERT(l->num > 0);
+    uint64_t target = (uint64_t)(p * (double)l->num + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+    uint64_t count = 0;
+    for (int i = 0; i < _SFETCH_LATENCY_NUM_BUCKETS; i++) {
+        count += l->buckets[i];
+        if (count >= target) {
+            /* the bucket center may lie outside the actually measured range */
+            uint64_t width;
+            const uint64_t lower = _sfetch_latency_bucket_lower(i, &width);
+            double val = (double)lower + 0.5 * (double)(width - 1);
+            if (val < (double)l->min) {
+                val = (double)l->min;
+            }
+            if (val > (double)l->max) {
+                val = (double)l->max;
+            }
+            return val * 1.0e-6;
+        }
+    }
+    return (double)l->max * 1.0e-6;
+}
+
+_SOKOL_PRIVATE sfetch_latency_t _sfetch_latency_query(const _sfetch_latency_t* l) {
+    sfetch_latency_t res;
+    _sfetch_clear(&res, sizeof(res));
+    if (0 == l->num) {
+        return res;
+    }
+    res.num = l->num;
+    res.avg = ((double)l->sum / (double)l->num) * 1.0e-6;
+    res.min = (double)l->min * 1.0e-6;
+    res.max = (double)l->max * 1.0e-6;
+    res.p50 = _sfetch_latency_percentile(l, 0.50);
+    res.p95 = _sfetch_latency_percentile(l, 0.95);
+    res.p99 = _sfetch_latency_percentile(l, 0.99);
+    /* fold the log-linear buckets into power-of-two buckets */
+    for (int i = 0; i < _SFETCH_LATENCY_NUM_BUCKETS; i++) {
+        uint64_t width;
+        uint64_t lower = _sfetch_latency_bucket_lower(i, &width);
+        int pow2_bucket = 0;
+        while ((lower != 0) && (pow2_bucket < (SFETCH_NUM_LATENCY_BUCKETS - 1))) {
+            lower >>= 1;
+            pow2_bucket++;
+        }
+        res.buckets[pow2_bucket] += l->buckets[i];
+    }
+    return res;
+}
+
+_SOKOL_PRIVATE void _sfetch_stats_reset(_sfetch_stats_t* stats, uint64_t now) {
+    _sfetch_clear(stats, sizeof(_sfetch_stats_t));
+    stats->start_time = now;
+    stats->lane_update_time = now;
+}
+
+/* the number of occupied lanes only changes in sfetch_dowork() */
+_SOKOL_PRIVATE void _sfetch_stats_update_lanes(_sfetch_stats_t* stats, uint32_t num_busy_lanes, uint64_t now) {
+    stats->lane_time += num_busy_lanes * _sfetch_elapsed(stats->lane_update_time, now);
+    stats->lane_update_time = now;
+}
+
+/* called on the user thread when an item comes out of its IO operation, right before the response callback */
+_SOKOL_PRIVATE void _sfetch_stats_put(_sfetch_stats_t* stats, _sfetch_item_t* item, uint64_t now) {
+    const uint64_t queue_wait = _sfetch_elapsed(item->user.queued_time, item->thread.io_start_time);
+    const uint64_t io_time = _sfetch_elapsed(item->thread.io_start_time, item->thread.io_end_time);
+    const uint64_t callback_wait = _sfetch_elapsed(item->thread.io_end_time, now);
+    item->user.timing.queue_wait = _sfetch_seconds(queue_wait);
+    item->user.timing.io_time = _sfetch_seconds(io_time);
+    item->user.timing.callback_wait = _sfetch_seconds(callback_wait);
+    /* paused and cancelled requests pass through the IO thread without doing any IO */
+    if (!item->user.cancel && (item->state != _SFETCH_STATE_PAUSED)) {
+        _sfetch_latency_put(&stats->queue_wait, queue_wait);
+        _sfetch_latency_put(&stats->io_time, io_time);
+        _sfetch_latency_put(&stats->callback_wait, callback_wait);
+    }
+    if (item->state == _SFETCH_STATE_FETCHED) {
+        stats->num_bytes += item->user.fetched_size;
+    }
+    if (item->user.finished) {
+        if (item->state == _SFETCH_STATE_FAILED) {
+            stats->num_failed++;
+        }
+        else {
+            stats->num_completed++;
+        }
+    }
+}
+
 /*=== a circular message queue ===============================================*/
 _SOKOL_PRIVATE uint32_t _sfetch_ring_wrap(const _sfetch_ring_t* rb, uint32_t i) {
     return i % rb->num;
@@ -1409,6 +2260,58 @@ _SOKOL_PRIVATE uint32_t _sfetch_ring_peek(const _sfetch_ring_t* rb, uint32_t ind
     return rb->buf[rb_index];
 }
 
+/* lock-free single-producer/single-consumer access to a ring, used
+   for the message queues between the user thread and an IO thread
+
+   NOTE: the atomics are sequentially consistent, the wakeup logic relies on
+   this (a producer which publishes a new head and then finds the waiting
+   flag cleared can be sure that the consumer will see the new head)
+*/
+#if _SFETCH_HAS_THREADS
+#if defined(_MSC_VER)
+    #define _sfetch_atomic_load(ptr) ((uint32_t)_InterlockedOr((volatile long*)(ptr), 0))
+    #define _sfetch_atomic_store(ptr, val) _InterlockedExchange((volatile long*)(ptr), (long)(val))
+#else
+    #define _sfetch_atomic_load(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+    #define _sfetch_atomic_store(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_SEQ_CST)
+#endif
+
+/* called from the producer thread, returns false if the ring is full */
+_SOKOL_PRIVATE bool _sfetch_spsc_enqueue(_sfetch_ring_t* rb, uint32_t slot_id) {
+    SOKOL_ASSERT(rb && rb->buf && (0 != slot_id));
+    const uint32_t head = rb->head;
+    const uint32_t next = _sfetch_ring_wrap(rb, head + 1);
+    if (next == _sfetch_atomic_load(&rb->tail)) {
+        return false;
+    }
+    rb->buf[head] = slot_id;
+    _sfetch_atomic_store(&rb->head, next);
+    return true;
+}
+
+/* called from the consumer thread, returns 0 if the ring is empty */
+_SOKOL_PRIVATE uint32_t _sfetch_spsc_dequeue(_sfetch_ring_t* rb) {
+    SOKOL_ASSERT(rb && rb->buf);
+    const uint32_t tail = rb->tail;
+    if (tail == _sfetch_atomic_load(&rb->head)) {
+        return 0;
+    }
+    const uint32_t slot_id = rb->buf[tail];
+    _sfetch_atomic_store(&rb->tail, _sfetch_ring_wrap(rb, tail + 1));
+    return slot_id;
+}
+
+/* called from the consumer thread */
+_SOKOL_PRIVATE bool _sfetch_spsc_empty(_sfetch_ring_t* rb) {
+    SOKOL_ASSERT(rb && rb->buf);
+    return rb->tail == _sfetch_atomic_load(&rb->head);
+}
+
+_SOKOL_PRIVATE bool _sfetch_thread_stop_requested(_sfetch_thread_t* thread) {
+    return 0 != _sfetch_atomic_load(&thread->stop_requested);
+}
+#endif /* _SFETCH_HAS_THREADS */
+
 /*=== request pool implementation ============================================*/
 _SOKOL_PRIVATE void _sfetch_item_init(_sfetch_item_t* item, uint32_t slot_id, const sfetch_request_t* request) {
     SOKOL_ASSERT(item && (0 == item->handle.id));
@@ -1418,13 +2321,26 @@ _SOKOL_PRIVATE void _sfetch_item_init(_sfetch_item_t* item, uint32_t slot_id, co
     item->state = _SFETCH_STATE_INITIAL;
     item->channel = request->channel;
     item->chunk_size = request->chunk_size;
+    item->priority = request->priority;
+    item->yield_lane = request->yield_lane;
+    item->readahead = request->readahead;
     item->lane = _SFETCH_INVALID_LANE;
     item->callback = request->callback;
     item->buffer.ptr = (uint8_t*) request->buffer_ptr;
     item->buffer.size = request->buffer_size;
     item->path = _sfetch_path_make(request->path);
+    /* loading starts at the request offset */
+    item->user.fetched_offset = request->offset;
+    item->thread.fetched_offset = request->offset;
+    /* the queue wait starts in sfetch_send() */
+    item->user.queued_time = _sfetch_now();
+    #if _SFETCH_PLATFORM_EMSCRIPTEN
+    item->thread.http_range_offset = request->offset;
+    #endif
     #if !_SFETCH_PLATFORM_EMSCRIPTEN
+    item->memory_mapped = request->memory_mapped;
     item->thread.file_handle = _SFETCH_INVALID_FILE_HANDLE;
+    item->thread.lz4.enabled = request->lz4;
     #endif
     if (request->user_data_ptr &&
         (request->user_data_size > 0) &&
@@ -1543,158 +2459,222 @@ _SOKOL_PRIVATE _sfetch_item_t* _sfetch_pool_item_lookup(_sfetch_pool_t* pool, ui
 /*=== PLATFORM WRAPPER FUNCTIONS =============================================*/
 #if _SFETCH_PLATFORM_POSIX
 _SOKOL_PRIVATE _sfetch_file_handle_t _sfetch_file_open(const _sfetch_path_t* path) {
-    return fopen(path->buf, "rb");
+    return open(path->buf, O_RDONLY);
 }
 
 _SOKOL_PRIVATE void _sfetch_file_close(_sfetch_file_handle_t h) {
-    fclose(h);
+    close(h);
 }
 
 _SOKOL_PRIVATE bool _sfetch_file_handle_valid(_sfetch_file_handle_t h) {
     return h != _SFETCH_INVALID_FILE_HANDLE;
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_file_size(_sfetch_file_handle_t h) {
-    fseek(h, 0, SEEK_END);
-    return (uint32_t) ftell(h);
+/* with a 32-bit off_t, file ranges reaching beyond 2 GBytes can't be expressed */
+_SOKOL_PRIVATE bool _sfetch_file_range_valid(uint64_t offset, uint64_t num_bytes) {
+    if (sizeof(off_t) < 8) {
+        return (offset <= (uint64_t)INT32_MAX) && (num_bytes <= ((uint64_t)INT32_MAX - offset));
+    }
+    return true;
 }
 
-_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint32_t offset, uint32_t num_bytes, void* ptr) {
-    fseek(h, (long)offset, SEEK_SET);
-    return num_bytes == fread(ptr, 1, num_bytes, h);
+_SOKOL_PRIVATE bool _sfetch_file_size(_sfetch_file_handle_t h, uint64_t* out_size) {
+    struct stat st;
+    /* NOTE: with a 32-bit off_t, fstat() fails with EOVERFLOW on files >= 2 GBytes */
+    if ((0 != fstat(h, &st)) || (st.st_size < 0) || !_sfetch_file_range_valid(0, (uint64_t)st.st_size)) {
+        *out_size = 0;
+        return false;
+    }
+    *out_size = (uint64_t) st.st_size;
+    return true;
 }
 
-_SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, _sfetch_thread_func_t thread_func, void* thread_arg) {
-    SOKOL_ASSERT(thread && !thread->valid && !thread->stop_requested);
-
-    pthread_mutexattr_t attr;
-    pthread_mutexattr_init(&attr);
-    pthread_mutex_init(&thread->incoming_mutex, &attr);
-    pthread_mutexattr_destroy(&attr);
+_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    if (!_sfetch_file_range_valid(offset, num_bytes)) {
+        return false;
+    }
+    #if !_SFETCH_HAS_PREAD
+    if ((off_t)offset != lseek(h, (off_t)offset, SEEK_SET)) {
+        return false;
+    }
+    #endif
+    /* read() may return less bytes than requested, and is limited to SSIZE_MAX */
+    uint8_t* dst = (uint8_t*) ptr;
+    while (num_bytes > 0) {
+        const size_t max_bytes = 1 << 30;
+        const size_t bytes_to_read = (num_bytes > max_bytes) ? max_bytes : (size_t)num_bytes;
+        #if _SFETCH_HAS_PREAD
+        const ssize_t res = pread(h, dst, bytes_to_read, (off_t)offset);
+        #else
+        const ssize_t res = read(h, dst, bytes_to_read);
+        #endif
+        if (res > 0) {
+            dst += res;
+            num_bytes -= (uint64_t)res;
+            offset += (uint64_t)res;
+        }
+        else if ((res < 0) && (errno == EINTR)) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
 
-    pthread_mutexattr_init(&attr);
-    pthread_mutex_init(&thread->outgoing_mutex, &attr);
-    pthread_mutexattr_destroy(&attr);
+/* access pattern hints for streaming, num_bytes == 0 means until the end of the file */
+_SOKOL_PRIVATE void _sfetch_file_advise_sequential(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes) {
+    #if _SFETCH_HAS_FADVISE
+    if (!_sfetch_file_range_valid(offset, num_bytes)) {
+        return;
+    }
+    posix_fadvise(h, (off_t)offset, (off_t)num_bytes, POSIX_FADV_SEQUENTIAL);
+    #else
+    _SOKOL_UNUSED(h); _SOKOL_UNUSED(offset); _SOKOL_UNUSED(num_bytes);
+    #endif
+}
 
-    pthread_mutexattr_init(&attr);
-    pthread_mutex_init(&thread->running_mutex, &attr);
-    pthread_mutexattr_destroy(&attr);
+_SOKOL_PRIVATE void _sfetch_file_advise_willneed(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes) {
+    #if _SFETCH_HAS_FADVISE
+    if (!_sfetch_file_range_valid(offset, num_bytes)) {
+        return;
+    }
+    posix_fadvise(h, (off_t)offset, (off_t)num_bytes, POSIX_FADV_WILLNEED);
+    #else
+    _SOKOL_UNUSED(h); _SOKOL_UNUSED(offset); _SOKOL_UNUSED(num_bytes);
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sfetch_file_map(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, _sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && (0 == mapping->base) && (num_bytes > 0));
+    if (!_sfetch_file_range_valid(offset, num_bytes)) {
+        return false;
+    }
+    /* the mapping offset must be a multiple of the page size */
+    const long page_size = sysconf(_SC_PAGESIZE);
+    SOKOL_ASSERT(page_size > 0);
+    const uint64_t page_offset = offset % (uint64_t)page_size;
+    #if SIZE_MAX < UINT64_MAX
+    if ((page_offset + num_bytes) > SIZE_MAX) {
+        /* doesn't fit into the address space */
+        return false;
+    }
+    #endif
+    const size_t map_size = (size_t)(page_offset + num_bytes);
+    void* base = mmap(0, map_size, PROT_READ, MAP_PRIVATE, h, (off_t)(offset - page_offset));
+    if (MAP_FAILED == base) {
+        return false;
+    }
+    mapping->base = base;
+    mapping->size = map_size;
+    mapping->ptr = (uint8_t*)base + page_offset;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sfetch_file_unmap(_sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping);
+    if (mapping->base) {
+        munmap(mapping->base, mapping->size);
+        _sfetch_clear(mapping, sizeof(_sfetch_mapping_t));
+    }
+}
 
+_SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, uint32_t num_threads, uint32_t num_slots, _sfetch_thread_func_t thread_func, void* thread_arg) {
+    SOKOL_ASSERT(thread && !thread->valid && !thread->stop_requested);
+    SOKOL_ASSERT((num_threads > 0) && (num_threads <= SFETCH_MAX_CHANNEL_THREADS));
+
+    pthread_mutexattr_t attr;
     pthread_mutexattr_init(&attr);
-    pthread_mutex_init(&thread->stop_mutex, &attr);
+    pthread_mutex_init(&thread->running_mutex, &attr);
     pthread_mutexattr_destroy(&attr);
 
-    pthread_condattr_t cond_attr;
-    pthread_condattr_init(&cond_attr);
-    pthread_cond_init(&thread->incoming_cond, &cond_attr);
-    pthread_condattr_destroy(&cond_attr);
-
     /* FIXME: in debug mode, the threads should be named */
     pthread_mutex_lock(&thread->running_mutex);
-    int res = pthread_create(&thread->thread, 0, thread_func, thread_arg);
-    thread->valid = (0 == res);
+    thread->num_threads = 0;
+    for (uint32_t i = 0; i < num_threads; i++) {
+        _sfetch_thread_worker_t* worker = &thread->workers[i];
+        worker->index = i;
+        worker->arg = thread_arg;
+        if (!_sfetch_ring_init(&worker->incoming, num_slots) || !_sfetch_ring_init(&worker->outgoing, num_slots)) {
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+            break;
+        }
+        pthread_mutexattr_init(&attr);
+        pthread_mutex_init(&worker->wait_mutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+        pthread_condattr_t cond_attr;
+        pthread_condattr_init(&cond_attr);
+        pthread_cond_init(&worker->wait_cond, &cond_attr);
+        pthread_condattr_destroy(&cond_attr);
+        if (0 != pthread_create(&worker->thread, 0, thread_func, worker)) {
+            pthread_cond_destroy(&worker->wait_cond);
+            pthread_mutex_destroy(&worker->wait_mutex);
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+            break;
+        }
+        thread->num_threads++;
+    }
+    thread->valid = (thread->num_threads > 0);
     pthread_mutex_unlock(&thread->running_mutex);
     return thread->valid;
 }
 
-_SOKOL_PRIVATE void _sfetch_thread_request_stop(_sfetch_thread_t* thread) {
-    pthread_mutex_lock(&thread->stop_mutex);
-    thread->stop_requested = true;
-    pthread_mutex_unlock(&thread->stop_mutex);
+/* wake up an IO thread blocked in _sfetch_thread_wait() */
+_SOKOL_PRIVATE void _sfetch_thread_wake(_sfetch_thread_worker_t* worker) {
+    pthread_mutex_lock(&worker->wait_mutex);
+    pthread_cond_signal(&worker->wait_cond);
+    pthread_mutex_unlock(&worker->wait_mutex);
 }
 
-_SOKOL_PRIVATE bool _sfetch_thread_stop_requested(_sfetch_thread_t* thread) {
-    pthread_mutex_lock(&thread->stop_mutex);
-    bool stop_requested = thread->stop_requested;
-    pthread_mutex_unlock(&thread->stop_mutex);
-    return stop_requested;
+/* block an IO thread until its incoming queue is not empty or a stop is requested */
+_SOKOL_PRIVATE void _sfetch_thread_wait(_sfetch_thread_t* thread, _sfetch_thread_worker_t* worker) {
+    pthread_mutex_lock(&worker->wait_mutex);
+    _sfetch_atomic_store(&worker->waiting, 1);
+    while (_sfetch_spsc_empty(&worker->incoming) && !_sfetch_thread_stop_requested(thread)) {
+        pthread_cond_wait(&worker->wait_cond, &worker->wait_mutex);
+    }
+    _sfetch_atomic_store(&worker->waiting, 0);
+    pthread_mutex_unlock(&worker->wait_mutex);
 }
 
 _SOKOL_PRIVATE void _sfetch_thread_join(_sfetch_thread_t* thread) {
     SOKOL_ASSERT(thread);
     if (thread->valid) {
-        pthread_mutex_lock(&thread->incoming_mutex);
-        _sfetch_thread_request_stop(thread);
-        pthread_cond_signal(&thread->incoming_cond);
-        pthread_mutex_unlock(&thread->incoming_mutex);
-        pthread_join(thread->thread, 0);
+        _sfetch_atomic_store(&thread->stop_requested, 1);
+        for (uint32_t i = 0; i < thread->num_threads; i++) {
+            _sfetch_thread_wake(&thread->workers[i]);
+        }
+        #if _SFETCH_USE_IO_URING
+        if (thread->wakeup_fd >= 0) {
+            const uint64_t one = 1;
+            ssize_t res = write(thread->wakeup_fd, &one, sizeof(one));
+            _SOKOL_UNUSED(res);
+        }
+        #endif
+        for (uint32_t i = 0; i < thread->num_threads; i++) {
+            _sfetch_thread_worker_t* worker = &thread->workers[i];
+            pthread_join(worker->thread, 0);
+            pthread_cond_destroy(&worker->wait_cond);
+            pthread_mutex_destroy(&worker->wait_mutex);
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+        }
+        thread->num_threads = 0;
         thread->valid = false;
     }
-    pthread_mutex_destroy(&thread->stop_mutex);
     pthread_mutex_destroy(&thread->running_mutex);
-    pthread_mutex_destroy(&thread->incoming_mutex);
-    pthread_mutex_destroy(&thread->outgoing_mutex);
-    pthread_cond_destroy(&thread->incoming_cond);
 }
 
 /* called when the thread-func is entered, this blocks the thread func until
-   the _sfetch_thread_t object is fully initialized
+   the _sfetch_thread_t object is fully initialized (all threads have been started)
 */
 _SOKOL_PRIVATE void _sfetch_thread_entered(_sfetch_thread_t* thread) {
     pthread_mutex_lock(&thread->running_mutex);
-}
-
-/* called by the thread-func right before it is left */
-_SOKOL_PRIVATE void _sfetch_thread_leaving(_sfetch_thread_t* thread) {
     pthread_mutex_unlock(&thread->running_mutex);
 }
-
-_SOKOL_PRIVATE void _sfetch_thread_enqueue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming, _sfetch_ring_t* src) {
-    /* called from user thread */
-    SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(incoming && incoming->buf);
-    SOKOL_ASSERT(src && src->buf);
-    if (!_sfetch_ring_empty(src)) {
-        pthread_mutex_lock(&thread->incoming_mutex);
-        while (!_sfetch_ring_full(incoming) && !_sfetch_ring_empty(src)) {
-            _sfetch_ring_enqueue(incoming, _sfetch_ring_dequeue(src));
-        }
-        pthread_cond_signal(&thread->incoming_cond);
-        pthread_mutex_unlock(&thread->incoming_mutex);
-    }
-}
-
-_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming) {
-    /* called from thread function */
-    SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(incoming && incoming->buf);
-    pthread_mutex_lock(&thread->incoming_mutex);
-    while (_sfetch_ring_empty(incoming) && !thread->stop_requested) {
-        pthread_cond_wait(&thread->incoming_cond, &thread->incoming_mutex);
-    }
-    uint32_t item = 0;
-    if (!thread->stop_requested) {
-        item = _sfetch_ring_dequeue(incoming);
-    }
-    pthread_mutex_unlock(&thread->incoming_mutex);
-    return item;
-}
-
-_SOKOL_PRIVATE bool _sfetch_thread_enqueue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, uint32_t item) {
-    /* called from thread function */
-    SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(outgoing && outgoing->buf);
-    SOKOL_ASSERT(0 != item);
-    pthread_mutex_lock(&thread->outgoing_mutex);
-    bool result = false;
-    if (!_sfetch_ring_full(outgoing)) {
-        _sfetch_ring_enqueue(outgoing, item);
-    }
-    pthread_mutex_unlock(&thread->outgoing_mutex);
-    return result;
-}
-
-_SOKOL_PRIVATE void _sfetch_thread_dequeue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, _sfetch_ring_t* dst) {
-    /* called from user thread */
-    SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(outgoing && outgoing->buf);
-    SOKOL_ASSERT(dst && dst->buf);
-    pthread_mutex_lock(&thread->outgoing_mutex);
-    while (!_sfetch_ring_full(dst) && !_sfetch_ring_empty(outgoing)) {
-        _sfetch_ring_enqueue(dst, _sfetch_ring_dequeue(outgoing));
-    }
-    pthread_mutex_unlock(&thread->outgoing_mutex);
-}
 #endif /* _SFETCH_PLATFORM_POSIX */
 
 #if _SFETCH_PLATFORM_WINDOWS
@@ -1738,154 +2718,808 @@ _SOKOL_PRIVATE bool _sfetch_file_handle_valid(_sfetch_file_handle_t h) {
     return h != _SFETCH_INVALID_FILE_HANDLE;
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_file_size(_sfetch_file_handle_t h) {
-    return GetFileSize(h, NULL);
+_SOKOL_PRIVATE bool _sfetch_file_size(_sfetch_file_handle_t h, uint64_t* out_size) {
+    LARGE_INTEGER size_li;
+    if (!GetFileSizeEx(h, &size_li)) {
+        *out_size = 0;
+        return false;
+    }
+    *out_size = (uint64_t) size_li.QuadPart;
+    return true;
 }
 
-_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint32_t offset, uint32_t num_bytes, void* ptr) {
-    LARGE_INTEGER offset_li;
-    offset_li.QuadPart = offset;
-    BOOL seek_res = SetFilePointerEx(h, offset_li, NULL, FILE_BEGIN);
-    if (seek_res) {
+_SOKOL_PRIVATE bool _sfetch_file_read(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    /* ReadFile() can read at most 4 GBytes at once */
+    uint8_t* dst = (uint8_t*) ptr;
+    while (num_bytes > 0) {
+        const DWORD max_bytes = 1 << 30;
+        const DWORD bytes_to_read = (num_bytes > max_bytes) ? max_bytes : (DWORD)num_bytes;
+        /* a positional read, same as pread() on POSIX */
+        OVERLAPPED overlapped;
+        _sfetch_clear(&overlapped, sizeof(overlapped));
+        overlapped.Offset = (DWORD)offset;
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
         DWORD bytes_read = 0;
-        BOOL read_res = ReadFile(h, ptr, (DWORD)num_bytes, &bytes_read, NULL);
-        return read_res && (bytes_read == num_bytes);
+        BOOL read_res = ReadFile(h, dst, bytes_to_read, &bytes_read, &overlapped);
+        if (!read_res || (bytes_read != bytes_to_read)) {
+            return false;
+        }
+        dst += bytes_read;
+        num_bytes -= bytes_read;
+        offset += bytes_read;
     }
-    else {
+    return true;
+}
+
+/* the file is opened with FILE_FLAG_SEQUENTIAL_SCAN, and there's no equivalent to POSIX_FADV_WILLNEED */
+_SOKOL_PRIVATE void _sfetch_file_advise_sequential(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes) {
+    _SOKOL_UNUSED(h); _SOKOL_UNUSED(offset); _SOKOL_UNUSED(num_bytes);
+}
+
+_SOKOL_PRIVATE void _sfetch_file_advise_willneed(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes) {
+    _SOKOL_UNUSED(h); _SOKOL_UNUSED(offset); _SOKOL_UNUSED(num_bytes);
+}
+
+_SOKOL_PRIVATE bool _sfetch_file_map(_sfetch_file_handle_t h, uint64_t offset, uint64_t num_bytes, _sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping && (0 == mapping->base) && (num_bytes > 0));
+    /* the view offset must be a multiple of the allocation granularity */
+    SYSTEM_INFO sys_info;
+    GetSystemInfo(&sys_info);
+    const uint64_t granularity_offset = offset % sys_info.dwAllocationGranularity;
+    const uint64_t view_offset = offset - granularity_offset;
+    #if SIZE_MAX < UINT64_MAX
+    if ((granularity_offset + num_bytes) > SIZE_MAX) {
+        /* doesn't fit into the address space */
         return false;
     }
+    #endif
+    const SIZE_T view_size = (SIZE_T)(granularity_offset + num_bytes);
+    HANDLE file_mapping = CreateFileMappingW(h, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == file_mapping) {
+        return false;
+    }
+    void* base = MapViewOfFile(file_mapping, FILE_MAP_READ, (DWORD)(view_offset >> 32), (DWORD)view_offset, view_size);
+    /* the view keeps the file mapping object alive */
+    CloseHandle(file_mapping);
+    if (NULL == base) {
+        return false;
+    }
+    mapping->base = base;
+    mapping->size = view_size;
+    mapping->ptr = (uint8_t*)base + granularity_offset;
+    return true;
 }
 
-_SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, _sfetch_thread_func_t thread_func, void* thread_arg) {
+_SOKOL_PRIVATE void _sfetch_file_unmap(_sfetch_mapping_t* mapping) {
+    SOKOL_ASSERT(mapping);
+    if (mapping->base) {
+        UnmapViewOfFile(mapping->base);
+        _sfetch_clear(mapping, sizeof(_sfetch_mapping_t));
+    }
+}
+
+_SOKOL_PRIVATE bool _sfetch_thread_init(_sfetch_thread_t* thread, uint32_t num_threads, uint32_t num_slots, _sfetch_thread_func_t thread_func, void* thread_arg) {
     SOKOL_ASSERT(thread && !thread->valid && !thread->stop_requested);
+    SOKOL_ASSERT((num_threads > 0) && (num_threads <= SFETCH_MAX_CHANNEL_THREADS));
 
-    thread->incoming_event = CreateEventA(NULL, FALSE, FALSE, NULL);
-    SOKOL_ASSERT(NULL != thread->incoming_event);
-    InitializeCriticalSection(&thread->incoming_critsec);
-    InitializeCriticalSection(&thread->outgoing_critsec);
     InitializeCriticalSection(&thread->running_critsec);
-    InitializeCriticalSection(&thread->stop_critsec);
 
     EnterCriticalSection(&thread->running_critsec);
     const SIZE_T stack_size = 512 * 1024;
-    thread->thread = CreateThread(NULL, stack_size, thread_func, thread_arg, 0, NULL);
-    thread->valid = (NULL != thread->thread);
+    thread->num_threads = 0;
+    for (uint32_t i = 0; i < num_threads; i++) {
+        _sfetch_thread_worker_t* worker = &thread->workers[i];
+        worker->index = i;
+        worker->arg = thread_arg;
+        if (!_sfetch_ring_init(&worker->incoming, num_slots) || !_sfetch_ring_init(&worker->outgoing, num_slots)) {
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+            break;
+        }
+        /* auto-reset, a wakeup before the wait isn't lost */
+        worker->wait_event = CreateEventA(NULL, FALSE, FALSE, NULL);
+        SOKOL_ASSERT(NULL != worker->wait_event);
+        worker->thread = CreateThread(NULL, stack_size, thread_func, worker, 0, NULL);
+        if (NULL == worker->thread) {
+            CloseHandle(worker->wait_event);
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+            break;
+        }
+        thread->num_threads++;
+    }
+    thread->valid = (thread->num_threads > 0);
     LeaveCriticalSection(&thread->running_critsec);
     return thread->valid;
 }
 
-_SOKOL_PRIVATE void _sfetch_thread_request_stop(_sfetch_thread_t* thread) {
-    EnterCriticalSection(&thread->stop_critsec);
-    thread->stop_requested = true;
-    LeaveCriticalSection(&thread->stop_critsec);
+/* wake up an IO thread blocked in _sfetch_thread_wait() */
+_SOKOL_PRIVATE void _sfetch_thread_wake(_sfetch_thread_worker_t* worker) {
+    BOOL set_event_res = SetEvent(worker->wait_event);
+    _SOKOL_UNUSED(set_event_res);
+    SOKOL_ASSERT(set_event_res);
 }
 
-_SOKOL_PRIVATE bool _sfetch_thread_stop_requested(_sfetch_thread_t* thread) {
-    EnterCriticalSection(&thread->stop_critsec);
-    bool stop_requested = thread->stop_requested;
-    LeaveCriticalSection(&thread->stop_critsec);
-    return stop_requested;
+/* block an IO thread until its incoming queue is not empty or a stop is requested */
+_SOKOL_PRIVATE void _sfetch_thread_wait(_sfetch_thread_t* thread, _sfetch_thread_worker_t* worker) {
+    _sfetch_atomic_store(&worker->waiting, 1);
+    while (_sfetch_spsc_empty(&worker->incoming) && !_sfetch_thread_stop_requested(thread)) {
+        WaitForSingleObject(worker->wait_event, INFINITE);
+    }
+    _sfetch_atomic_store(&worker->waiting, 0);
 }
 
 _SOKOL_PRIVATE void _sfetch_thread_join(_sfetch_thread_t* thread) {
     if (thread->valid) {
-        EnterCriticalSection(&thread->incoming_critsec);
-        _sfetch_thread_request_stop(thread);
-        BOOL set_event_res = SetEvent(thread->incoming_event);
-        _SOKOL_UNUSED(set_event_res);
-        SOKOL_ASSERT(set_event_res);
-        LeaveCriticalSection(&thread->incoming_critsec);
-        WaitForSingleObject(thread->thread, INFINITE);
-        CloseHandle(thread->thread);
+        _sfetch_atomic_store(&thread->stop_requested, 1);
+        HANDLE handles[SFETCH_MAX_CHANNEL_THREADS];
+        for (uint32_t i = 0; i < thread->num_threads; i++) {
+            _sfetch_thread_wake(&thread->workers[i]);
+            handles[i] = thread->workers[i].thread;
+        }
+        WaitForMultipleObjects(thread->num_threads, handles, TRUE, INFINITE);
+        for (uint32_t i = 0; i < thread->num_threads; i++) {
+            _sfetch_thread_worker_t* worker = &thread->workers[i];
+            CloseHandle(worker->thread);
+            CloseHandle(worker->wait_event);
+            _sfetch_ring_discard(&worker->incoming);
+            _sfetch_ring_discard(&worker->outgoing);
+        }
+        thread->num_threads = 0;
         thread->valid = false;
     }
-    CloseHandle(thread->incoming_event);
-    DeleteCriticalSection(&thread->stop_critsec);
     DeleteCriticalSection(&thread->running_critsec);
-    DeleteCriticalSection(&thread->outgoing_critsec);
-    DeleteCriticalSection(&thread->incoming_critsec);
 }
 
 _SOKOL_PRIVATE void _sfetch_thread_entered(_sfetch_thread_t* thread) {
     EnterCriticalSection(&thread->running_critsec);
-}
-
-/* called by the thread-func right before it is left */
-_SOKOL_PRIVATE void _sfetch_thread_leaving(_sfetch_thread_t* thread) {
     LeaveCriticalSection(&thread->running_critsec);
 }
+#endif /* _SFETCH_PLATFORM_WINDOWS */
 
-_SOKOL_PRIVATE void _sfetch_thread_enqueue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming, _sfetch_ring_t* src) {
-    /* called from user thread */
+/*=== IO thread message queues ===============================================*/
+#if _SFETCH_HAS_THREADS
+_SOKOL_PRIVATE void _sfetch_thread_enqueue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* src) {
+    /* called from user thread, each request goes to the IO thread with the least
+       work, and IO threads are only woken up if they're actually waiting
+    */
     SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(incoming && incoming->buf);
     SOKOL_ASSERT(src && src->buf);
-    if (!_sfetch_ring_empty(src)) {
-        EnterCriticalSection(&thread->incoming_critsec);
-        while (!_sfetch_ring_full(incoming) && !_sfetch_ring_empty(src)) {
-            _sfetch_ring_enqueue(incoming, _sfetch_ring_dequeue(src));
+    if (_sfetch_ring_empty(src)) {
+        return;
+    }
+    while (!_sfetch_ring_empty(src)) {
+        _sfetch_thread_worker_t* worker = &thread->workers[0];
+        for (uint32_t i = 1; i < thread->num_threads; i++) {
+            if (thread->workers[i].num_assigned < worker->num_assigned) {
+                worker = &thread->workers[i];
+            }
+        }
+        /* each queue can hold all lanes of the channel, so this can't fail */
+        const bool enqueued = _sfetch_spsc_enqueue(&worker->incoming, _sfetch_ring_dequeue(src));
+        _SOKOL_UNUSED(enqueued);
+        SOKOL_ASSERT(enqueued);
+        worker->num_assigned++;
+    }
+    for (uint32_t i = 0; i < thread->num_threads; i++) {
+        if (0 != _sfetch_atomic_load(&thread->workers[i].waiting)) {
+            _sfetch_thread_wake(&thread->workers[i]);
         }
-        LeaveCriticalSection(&thread->incoming_critsec);
-        BOOL set_event_res = SetEvent(thread->incoming_event);
-        _SOKOL_UNUSED(set_event_res);
-        SOKOL_ASSERT(set_event_res);
     }
+    #if _SFETCH_USE_IO_URING
+    if (thread->wakeup_fd >= 0) {
+        const uint64_t one = 1;
+        ssize_t res = write(thread->wakeup_fd, &one, sizeof(one));
+        _SOKOL_UNUSED(res);
+    }
+    #endif
 }
 
-_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_ring_t* incoming) {
-    /* called from thread function */
+_SOKOL_PRIVATE uint32_t _sfetch_thread_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_thread_worker_t* worker) {
+    /* called from thread function, blocks until work arrives, returns 0 on stop */
     SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(incoming && incoming->buf);
-    EnterCriticalSection(&thread->incoming_critsec);
-    while (_sfetch_ring_empty(incoming) && !thread->stop_requested) {
-        LeaveCriticalSection(&thread->incoming_critsec);
-        WaitForSingleObject(thread->incoming_event, INFINITE);
-        EnterCriticalSection(&thread->incoming_critsec);
+    while (!_sfetch_thread_stop_requested(thread)) {
+        const uint32_t item = _sfetch_spsc_dequeue(&worker->incoming);
+        if (0 != item) {
+            return item;
+        }
+        _sfetch_thread_wait(thread, worker);
     }
-    uint32_t item = 0;
-    if (!thread->stop_requested) {
-        item = _sfetch_ring_dequeue(incoming);
+    return 0;
+}
+
+#if _SFETCH_USE_IO_URING
+_SOKOL_PRIVATE uint32_t _sfetch_thread_try_dequeue_incoming(_sfetch_thread_t* thread, _sfetch_thread_worker_t* worker) {
+    /* called from thread function, doesn't block if the queue is empty */
+    SOKOL_ASSERT(thread && thread->valid);
+    if (_sfetch_thread_stop_requested(thread)) {
+        return 0;
     }
-    LeaveCriticalSection(&thread->incoming_critsec);
-    return item;
+    return _sfetch_spsc_dequeue(&worker->incoming);
 }
+#endif
 
-_SOKOL_PRIVATE bool _sfetch_thread_enqueue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, uint32_t item) {
-    /* called from thread function */
+_SOKOL_PRIVATE void _sfetch_thread_enqueue_outgoing(_sfetch_thread_t* thread, _sfetch_thread_worker_t* worker, uint32_t item) {
+    /* called from thread function, the user thread polls the outgoing queues each frame */
     SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(outgoing && outgoing->buf);
-    EnterCriticalSection(&thread->outgoing_critsec);
-    bool result = false;
-    if (!_sfetch_ring_full(outgoing)) {
-        _sfetch_ring_enqueue(outgoing, item);
+    SOKOL_ASSERT(0 != item);
+    _SOKOL_UNUSED(thread);
+    const bool enqueued = _sfetch_spsc_enqueue(&worker->outgoing, item);
+    _SOKOL_UNUSED(enqueued);
+    SOKOL_ASSERT(enqueued);
+}
+
+_SOKOL_PRIVATE void _sfetch_thread_dequeue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* dst) {
+    /* called from user thread */
+    SOKOL_ASSERT(thread && thread->valid);
+    SOKOL_ASSERT(dst && dst->buf);
+    for (uint32_t i = 0; i < thread->num_threads; i++) {
+        _sfetch_thread_worker_t* worker = &thread->workers[i];
+        while (!_sfetch_ring_full(dst)) {
+            const uint32_t item = _sfetch_spsc_dequeue(&worker->outgoing);
+            if (0 == item) {
+                break;
+            }
+            _sfetch_ring_enqueue(dst, item);
+            SOKOL_ASSERT(worker->num_assigned > 0);
+            worker->num_assigned--;
+        }
+    }
+}
+#endif /* _SFETCH_HAS_THREADS */
+
+/*=== PACK FILE implementation ===============================================*/
+#if _SFETCH_HAS_THREADS
+/* 64-bit FNV-1a hash of a path string, must match the pack tool */
+_SOKOL_PRIVATE uint64_t _sfetch_hash_path(const char* path) {
+    uint64_t hash = 0xCBF29CE484222325;
+    while (*path) {
+        hash ^= (uint8_t) *path++;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+_SOKOL_PRIVATE uint32_t _sfetch_load_u32le(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+}
+
+_SOKOL_PRIVATE uint64_t _sfetch_load_u64le(const uint8_t* ptr) {
+    return (uint64_t)_sfetch_load_u32le(ptr) | ((uint64_t)_sfetch_load_u32le(ptr + 4) << 32);
+}
+
+_SOKOL_PRIVATE void _sfetch_pack_discard(_sfetch_pack_t* pack) {
+    SOKOL_ASSERT(pack);
+    if (pack->entries) {
+        _sfetch_free(pack->entries);
+    }
+    if (_sfetch_file_handle_valid(pack->file_handle)) {
+        _sfetch_file_close(pack->file_handle);
+    }
+    #if _SFETCH_PLATFORM_POSIX && !_SFETCH_HAS_PREAD
+    if (pack->valid) {
+        pthread_mutex_destroy(&pack->read_mutex);
+    }
+    #endif
+    _sfetch_clear(pack, sizeof(_sfetch_pack_t));
+    pack->file_handle = _SFETCH_INVALID_FILE_HANDLE;
+}
+
+/* open a pack file and load its index, the file handle stays open */
+_SOKOL_PRIVATE bool _sfetch_pack_init(_sfetch_pack_t* pack, const _sfetch_path_t* path) {
+    SOKOL_ASSERT(pack && !pack->valid);
+    _sfetch_clear(pack, sizeof(_sfetch_pack_t));
+    pack->file_handle = _sfetch_file_open(path);
+    if (!_sfetch_file_handle_valid(pack->file_handle)) {
+        SOKOL_LOG("sfetch_mount: failed to open pack file");
+        _sfetch_pack_discard(pack);
+        return false;
+    }
+    uint64_t file_size = 0;
+    uint8_t header[_SFETCH_PACK_HEADER_SIZE];
+    if (!_sfetch_file_size(pack->file_handle, &file_size) ||
+        (file_size < _SFETCH_PACK_HEADER_SIZE) ||
+        !_sfetch_file_read(pack->file_handle, 0, _SFETCH_PACK_HEADER_SIZE, header) ||
+        (_sfetch_load_u32le(header) != _SFETCH_PACK_MAGIC) ||
+        (_sfetch_load_u32le(header + 4) != _SFETCH_PACK_VERSION))
+    {
+        SOKOL_LOG("sfetch_mount: not a valid pack file");
+        _sfetch_pack_discard(pack);
+        return false;
+    }
+    pack->num_entries = _sfetch_load_u32le(header + 8);
+    const uint64_t index_size = (uint64_t)pack->num_entries * _SFETCH_PACK_ENTRY_SIZE;
+    if ((_SFETCH_PACK_HEADER_SIZE + index_size) > file_size) {
+        SOKOL_LOG("sfetch_mount: pack file index is truncated");
+        _sfetch_pack_discard(pack);
+        return false;
+    }
+    if (pack->num_entries > 0) {
+        uint8_t* index = (uint8_t*) _sfetch_malloc((size_t)index_size);
+        bool index_valid = _sfetch_file_read(pack->file_handle, _SFETCH_PACK_HEADER_SIZE, index_size, index);
+        pack->entries = (_sfetch_pack_entry_t*) _sfetch_malloc_clear(pack->num_entries * sizeof(_sfetch_pack_entry_t));
+        for (uint32_t i = 0; index_valid && (i < pack->num_entries); i++) {
+            const uint8_t* src = index + i * _SFETCH_PACK_ENTRY_SIZE;
+            _sfetch_pack_entry_t* entry = &pack->entries[i];
+            entry->path_hash = _sfetch_load_u64le(src);
+            entry->offset = _sfetch_load_u64le(src + 8);
+            entry->size = _sfetch_load_u64le(src + 16);
+            entry->flags = _sfetch_load_u32le(src + 24);
+            /* entries must be sorted by hash without duplicates, and must be inside the pack file */
+            index_valid = ((i == 0) || (entry->path_hash > pack->entries[i-1].path_hash)) &&
+                          (entry->offset <= file_size) &&
+                          (entry->size <= (file_size - entry->offset)) &&
+                          (entry->flags == 0);
+        }
+        _sfetch_free(index);
+        if (!index_valid) {
+            SOKOL_LOG("sfetch_mount: pack file index is invalid");
+            _sfetch_pack_discard(pack);
+            return false;
+        }
+    }
+    #if _SFETCH_PLATFORM_POSIX && !_SFETCH_HAS_PREAD
+    pthread_mutex_init(&pack->read_mutex, 0);
+    #endif
+    pack->valid = true;
+    return true;
+}
+
+/* binary search for a path hash in the pack index, returns null if not found */
+_SOKOL_PRIVATE const _sfetch_pack_entry_t* _sfetch_pack_find(const _sfetch_pack_t* pack, uint64_t path_hash) {
+    SOKOL_ASSERT(pack && pack->valid);
+    uint32_t lo = 0;
+    uint32_t hi = pack->num_entries;
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        const _sfetch_pack_entry_t* entry = &pack->entries[mid];
+        if (entry->path_hash == path_hash) {
+            return entry;
+        }
+        else if (entry->path_hash < path_hash) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return 0;
+}
+
+/* called on the user thread from sfetch_send(), later mounted packs take precedence */
+_SOKOL_PRIVATE void _sfetch_pack_resolve(_sfetch_t* ctx, _sfetch_item_t* item) {
+    SOKOL_ASSERT(ctx && item);
+    if (0 == ctx->num_packs) {
+        return;
+    }
+    const uint64_t path_hash = _sfetch_hash_path(item->path.buf);
+    for (uint32_t i = ctx->num_packs; i-- > 0;) {
+        const _sfetch_pack_entry_t* entry = _sfetch_pack_find(&ctx->packs[i], path_hash);
+        if (entry) {
+            item->thread.pack = &ctx->packs[i];
+            item->thread.pack_offset = entry->offset;
+            item->thread.pack_size = entry->size;
+            return;
+        }
+    }
+}
+
+/* read a file range, positional reads on the shared pack file handle can run
+   concurrently, only a seek+read must be serialized
+*/
+_SOKOL_PRIVATE bool _sfetch_pack_read(_sfetch_pack_t* pack, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    SOKOL_ASSERT(pack && pack->valid);
+    #if _SFETCH_PLATFORM_POSIX && !_SFETCH_HAS_PREAD
+    pthread_mutex_lock(&pack->read_mutex);
+    const bool res = _sfetch_file_read(pack->file_handle, offset, num_bytes, ptr);
+    pthread_mutex_unlock(&pack->read_mutex);
+    return res;
+    #else
+    return _sfetch_file_read(pack->file_handle, offset, num_bytes, ptr);
+    #endif
+}
+#endif /* _SFETCH_HAS_THREADS */
+
+/*=== LZ4 decompression ======================================================*/
+#if _SFETCH_HAS_THREADS
+#define _SFETCH_LZ4_MAGIC (0x184D2204)
+#define _SFETCH_LZ4_MAX_BLOCK_SIZE (4 * 1024 * 1024)
+/* the block checksum and the size field of the next block follow each block */
+#define _SFETCH_LZ4_MAX_TRAILER_SIZE (8)
+
+/* decode one LZ4 block, matches may reach back to dst_begin (with dependent
+   blocks this is the output of the previous blocks), on success *dst_ptr
+   is moved to the end of the decoded data
+*/
+_SOKOL_PRIVATE sfetch_error_t _sfetch_lz4_decode_block(const uint8_t* src, size_t src_size, const uint8_t* dst_begin, uint8_t** dst_ptr, const uint8_t* dst_end) {
+    const uint8_t* src_end = src + src_size;
+    uint8_t* dst = *dst_ptr;
+    while (true) {
+        /* a sequence starts with a token byte and the literals */
+        if (src == src_end) {
+            return SFETCH_ERROR_INVALID_LZ4_DATA;
+        }
+        const uint32_t token = *src++;
+        size_t num_literals = token >> 4;
+        if (num_literals == 15) {
+            uint32_t len;
+            do {
+                if (src == src_end) {
+                    return SFETCH_ERROR_INVALID_LZ4_DATA;
+                }
+                len = *src++;
+                num_literals += len;
+            } while (len == 255);
+        }
+        if (num_literals > (size_t)(src_end - src)) {
+            return SFETCH_ERROR_INVALID_LZ4_DATA;
+        }
+        if (num_literals > (size_t)(dst_end - dst)) {
+            return SFETCH_ERROR_BUFFER_TOO_SMALL;
+        }
+        memcpy(dst, src, num_literals);
+        src += num_literals;
+        dst += num_literals;
+        /* the last sequence of a block only has literals */
+        if (src == src_end) {
+            break;
+        }
+        /* ...all others are followed by a match */
+        if ((src_end - src) < 2) {
+            return SFETCH_ERROR_INVALID_LZ4_DATA;
+        }
+        const size_t offset = (size_t)src[0] | ((size_t)src[1] << 8);
+        src += 2;
+        if ((offset == 0) || (offset > (size_t)(dst - dst_begin))) {
+            return SFETCH_ERROR_INVALID_LZ4_DATA;
+        }
+        size_t match_len = (size_t)(token & 15) + 4;
+        if ((token & 15) == 15) {
+            uint32_t len;
+            do {
+                if (src == src_end) {
+                    return SFETCH_ERROR_INVALID_LZ4_DATA;
+                }
+                len = *src++;
+                match_len += len;
+            } while (len == 255);
+        }
+        if (match_len > (size_t)(dst_end - dst)) {
+            return SFETCH_ERROR_BUFFER_TOO_SMALL;
+        }
+        const uint8_t* match = dst - offset;
+        if (offset >= match_len) {
+            memcpy(dst, match, match_len);
+            dst += match_len;
+        }
+        else {
+            /* overlapping match (a repeating pattern), copy in steps which don't overlap themselves */
+            const uint8_t* match_end = dst + match_len;
+            if (offset >= 8) {
+                while ((match_end - dst) >= 8) {
+                    memcpy(dst, match, 8);
+                    dst += 8;
+                    match += 8;
+                }
+            }
+            while (dst < match_end) {
+                *dst++ = *match++;
+            }
+        }
+    }
+    *dst_ptr = dst;
+    return SFETCH_ERROR_NO_ERROR;
+}
+
+_SOKOL_PRIVATE bool _sfetch_lz4_failed(_sfetch_item_thread_t* thread, sfetch_error_t error_code) {
+    thread->error_code = error_code;
+    thread->failed = true;
+    return false;
+}
+
+/* read a range of the compressed file, the offset is relative to the start of the file */
+_SOKOL_PRIVATE bool _sfetch_lz4_read(_sfetch_item_thread_t* thread, uint64_t offset, uint64_t num_bytes, void* ptr) {
+    if ((offset + num_bytes) > thread->content_size) {
+        return _sfetch_lz4_failed(thread, SFETCH_ERROR_UNEXPECTED_EOF);
+    }
+    const bool res = thread->pack ?
+        _sfetch_pack_read(thread->pack, thread->pack_offset + offset, num_bytes, ptr) :
+        _sfetch_file_read(thread->file_handle, offset, num_bytes, ptr);
+    return res ? true : _sfetch_lz4_failed(thread, SFETCH_ERROR_UNEXPECTED_EOF);
+}
+
+/* parse the frame header, and read the size field of the first block */
+_SOKOL_PRIVATE bool _sfetch_lz4_read_header(_sfetch_item_thread_t* thread, const _sfetch_buffer_t* buffer, uint32_t chunk_size) {
+    _sfetch_lz4_t* lz4 = &thread->lz4;
+    /* magic, FLG and BD byte, optional content size, header checksum, first block size */
+    uint8_t hdr[4 + 2 + 8 + 1 + 4];
+    if (!_sfetch_lz4_read(thread, 0, 6, hdr)) {
+        return false;
+    }
+    const uint8_t flg = hdr[4];
+    const bool has_content_size = 0 != (flg & (1<<3));
+    if ((_sfetch_load_u32le(hdr) != _SFETCH_LZ4_MAGIC) ||
+        ((flg >> 6) != 1) ||    /* version */
+        (0 != (flg & (1<<1))) ||  /* reserved */
+        (0 != (flg & (1<<0))))    /* dictionary id */
+    {
+        return _sfetch_lz4_failed(thread, SFETCH_ERROR_INVALID_LZ4_DATA);
+    }
+    lz4->dependent_blocks = 0 == (flg & (1<<5));
+    lz4->block_checksums = 0 != (flg & (1<<4));
+    if (lz4->dependent_blocks && (chunk_size > 0)) {
+        /* when streaming, the data of the previous block is gone */
+        return _sfetch_lz4_failed(thread, SFETCH_ERROR_INVALID_LZ4_DATA);
+    }
+    const uint64_t hdr_size = has_content_size ? 15 : 7;
+    if (!_sfetch_lz4_read(thread, 6, hdr_size - 6 + 4, hdr + 6)) {
+        return false;
+    }
+    if (has_content_size && (chunk_size == 0) && (_sfetch_load_u64le(hdr + 6) > buffer->size)) {
+        return _sfetch_lz4_failed(thread, SFETCH_ERROR_BUFFER_TOO_SMALL);
+    }
+    lz4->next_block_size = _sfetch_load_u32le(hdr + hdr_size);
+    lz4->read_offset = hdr_size + 4;
+    lz4->done = (0 == lz4->next_block_size);
+    lz4->header_done = true;
+    return true;
+}
+
+/* read and decode the next block, and read the size field of the block after it */
+_SOKOL_PRIVATE bool _sfetch_lz4_next_block(_sfetch_item_thread_t* thread, const uint8_t* dst_begin, uint8_t** dst_ptr, const uint8_t* dst_end) {
+    _sfetch_lz4_t* lz4 = &thread->lz4;
+    SOKOL_ASSERT(!lz4->done && (0 != lz4->next_block_size));
+    /* the high bit of the size field is set for blocks which are stored uncompressed */
+    const bool stored = 0 != (lz4->next_block_size & 0x80000000);
+    const uint32_t block_size = lz4->next_block_size & 0x7FFFFFFF;
+    const uint32_t trailer_size = lz4->block_checksums ? 8 : 4;
+    const uint8_t* trailer;
+    if (stored) {
+        if (block_size > (size_t)(dst_end - *dst_ptr)) {
+            return _sfetch_lz4_failed(thread, SFETCH_ERROR_BUFFER_TOO_SMALL);
+        }
+        if (!_sfetch_lz4_read(thread, lz4->read_offset, block_size, *dst_ptr) ||
+            !_sfetch_lz4_read(thread, lz4->read_offset + block_size, trailer_size, lz4->scratch))
+        {
+            return false;
+        }
+        *dst_ptr += block_size;
+        trailer = lz4->scratch;
+    }
+    else {
+        /* compressed blocks are read together with their trailer into the scratch buffer */
+        if ((block_size + trailer_size) > lz4->scratch_size) {
+            return _sfetch_lz4_failed(thread, SFETCH_ERROR_INVALID_LZ4_DATA);
+        }
+        if (!_sfetch_lz4_read(thread, lz4->read_offset, block_size + trailer_size, lz4->scratch)) {
+            return false;
+        }
+        const sfetch_error_t err = _sfetch_lz4_decode_block(lz4->scratch, block_size, dst_begin, dst_ptr, dst_end);
+        if (err != SFETCH_ERROR_NO_ERROR) {
+            return _sfetch_lz4_failed(thread, err);
+        }
+        trailer = lz4->scratch + block_size;
+    }
+    /* block checksums are skipped */
+    lz4->read_offset += block_size + trailer_size;
+    lz4->next_block_size = _sfetch_load_u32le(trailer + trailer_size - 4);
+    lz4->done = (0 == lz4->next_block_size);
+    return true;
+}
+
+/* decompress the entire file, or the next block when streaming, into the buffer */
+_SOKOL_PRIVATE void _sfetch_lz4_fetch(_sfetch_item_thread_t* thread, const _sfetch_buffer_t* buffer, uint32_t chunk_size) {
+    SOKOL_ASSERT(thread->lz4.enabled);
+    /* sfetch_send() rejects LZ4 requests without sfetch_desc_t.max_lz4_block_size */
+    SOKOL_ASSERT(thread->lz4.scratch);
+    if (!thread->lz4.header_done && !_sfetch_lz4_read_header(thread, buffer, chunk_size)) {
+        return;
+    }
+    uint8_t* dst = buffer->ptr;
+    while (!thread->lz4.done) {
+        /* matches in independent blocks can't reach into the previous block */
+        const uint8_t* dst_begin = thread->lz4.dependent_blocks ? buffer->ptr : dst;
+        if (!_sfetch_lz4_next_block(thread, dst_begin, &dst, buffer->ptr + buffer->size)) {
+            return;
+        }
+        if (chunk_size > 0) {
+            break;
+        }
+    }
+    thread->fetched_size = (uint64_t)(dst - buffer->ptr);
+    thread->fetched_offset += thread->fetched_size;
+}
+#endif /* _SFETCH_HAS_THREADS */
+
+/*=== IO CHANNEL implementation ==============================================*/
+
+/* per-channel request handler for native platforms accessing the local filesystem */
+#if _SFETCH_HAS_THREADS
+
+/* called after the file has been opened, checks the request offset */
+_SOKOL_PRIVATE void _sfetch_file_opened(_sfetch_item_thread_t* thread, uint32_t chunk_size) {
+    SOKOL_ASSERT(_sfetch_file_handle_valid(thread->file_handle));
+    /* a file in a pack file is a range of the pack file */
+    if (thread->pack) {
+        thread->content_size = thread->pack_size;
+    }
+    else if (!_sfetch_file_size(thread->file_handle, &thread->content_size)) {
+        thread->error_code = SFETCH_ERROR_FILE_NOT_FOUND;
+        thread->failed = true;
+        return;
+    }
+    /* streamed files are read front to back, the pack file handle is shared */
+    if ((chunk_size > 0) && !thread->pack) {
+        _sfetch_file_advise_sequential(thread->file_handle, 0, 0);
+    }
+    /* fetched_offset starts at the request offset */
+    if (thread->fetched_offset > thread->content_size) {
+        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+        thread->failed = true;
+    }
+}
+
+/* compute the file range for the next read (whole file or next chunk), returns false on error */
+_SOKOL_PRIVATE bool _sfetch_file_next_range(_sfetch_item_thread_t* thread, const _sfetch_buffer_t* buffer, uint32_t chunk_size, bool memory_mapped, uint64_t* out_offset, uint64_t* out_num_bytes) {
+    const uint64_t read_offset = thread->fetched_offset;
+    uint64_t bytes_to_read = 0;
+    if (chunk_size == 0) {
+        /* load entire file (starting at the request offset) */
+        if (memory_mapped || ((thread->content_size - read_offset) <= buffer->size)) {
+            bytes_to_read = thread->content_size - read_offset;
+        }
+        else {
+            /* provided buffer to small to fit entire file */
+            thread->error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
+            thread->failed = true;
+        }
+    }
+    else {
+        if (memory_mapped || (chunk_size <= buffer->size)) {
+            bytes_to_read = chunk_size;
+            if ((read_offset + bytes_to_read) > thread->content_size) {
+                bytes_to_read = thread->content_size - read_offset;
+            }
+        }
+        else {
+            /* provided buffer to small to fit next chunk */
+            thread->error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
+            thread->failed = true;
+        }
+    }
+    /* the returned offset is relative to the start of the file handle */
+    *out_offset = thread->pack_offset + read_offset;
+    *out_num_bytes = bytes_to_read;
+    return !thread->failed;
+}
+
+/* map the next file range into memory */
+_SOKOL_PRIVATE void _sfetch_file_map_range(_sfetch_item_thread_t* thread, uint64_t offset, uint64_t num_bytes) {
+    /* the user thread is done with the previous chunk's mapping */
+    _sfetch_file_unmap(&thread->mapping);
+    if ((0 == num_bytes) || _sfetch_file_map(thread->file_handle, offset, num_bytes, &thread->mapping)) {
+        thread->fetched_size = num_bytes;
+        thread->fetched_offset += num_bytes;
+    }
+    else {
+        thread->error_code = SFETCH_ERROR_MAPPING_FAILED;
+        thread->failed = true;
+    }
+}
+
+/* called at the end of each IO operation, closes the file when done */
+_SOKOL_PRIVATE void _sfetch_file_check_finished(_sfetch_item_thread_t* thread) {
+    /* for LZ4 requests, the fetched offset is in the decompressed data */
+    SOKOL_ASSERT(thread->failed || thread->lz4.enabled || (thread->fetched_offset <= thread->content_size));
+    const bool eof = thread->lz4.enabled ? thread->lz4.done : (thread->fetched_offset == thread->content_size);
+    if (thread->failed || eof) {
+        /* the pack file stays open */
+        if (_sfetch_file_handle_valid(thread->file_handle) && !thread->pack) {
+            _sfetch_file_close(thread->file_handle);
+        }
+        thread->file_handle = _SFETCH_INVALID_FILE_HANDLE;
+        thread->finished = true;
+    }
+}
+
+/* when streaming, let the OS start reading the chunk after the one which is read now */
+_SOKOL_PRIVATE void _sfetch_file_advise_next_chunk(_sfetch_item_thread_t* thread, uint32_t chunk_size, uint64_t next_offset) {
+    const uint64_t end_offset = thread->pack_offset + thread->content_size;
+    if ((chunk_size > 0) && (next_offset < end_offset)) {
+        const uint64_t num_bytes = end_offset - next_offset;
+        _sfetch_file_advise_willneed(thread->file_handle, next_offset, (num_bytes < chunk_size) ? num_bytes : chunk_size);
+    }
+}
+
+/* wait until a readahead which has been started by another IO thread is done */
+_SOKOL_PRIVATE void _sfetch_readahead_wait(_sfetch_readahead_t* ra) {
+    while (0 != _sfetch_atomic_load(&ra->busy)) {
+        #if _SFETCH_PLATFORM_WINDOWS
+        SwitchToThread();
+        #else
+        sched_yield();
+        #endif
+    }
+}
+
+/* hand out the next chunk of a streaming request with readahead, and capture
+   the read parameters of the chunk after it for _sfetch_readahead_read()
+*/
+_SOKOL_PRIVATE void _sfetch_readahead_fetch(_sfetch_item_thread_t* thread, const _sfetch_buffer_t* buffer, uint32_t chunk_size) {
+    _sfetch_readahead_t* ra = &thread->readahead;
+    const uint64_t half_size = buffer->size / 2;
+    const _sfetch_buffer_t half = { buffer->ptr + ra->half * half_size, half_size };
+    uint64_t read_offset = 0;
+    uint64_t bytes_to_read = 0;
+    if (!_sfetch_file_next_range(thread, &half, chunk_size, false, &read_offset, &bytes_to_read)) {
+        return;
+    }
+    if (ra->valid) {
+        /* the chunk has already been read after the previous handoff */
+        SOKOL_ASSERT((ra->offset == read_offset) && (ra->size == bytes_to_read) && (ra->ptr == half.ptr));
+        ra->valid = false;
+        if (ra->failed) {
+            thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+            thread->failed = true;
+            return;
+        }
+    }
+    else if (!(thread->pack ?
+               _sfetch_pack_read(thread->pack, read_offset, bytes_to_read, half.ptr) :
+               _sfetch_file_read(thread->file_handle, read_offset, bytes_to_read, half.ptr)))
+    {
+        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+        thread->failed = true;
+        return;
+    }
+    thread->fetched_size = bytes_to_read;
+    thread->fetched_offset += bytes_to_read;
+    thread->fetched_buffer_offset = ra->half * half_size;
+    ra->half ^= 1;
+    if (thread->fetched_offset < thread->content_size) {
+        const uint64_t num_bytes = thread->content_size - thread->fetched_offset;
+        ra->pending = true;
+        ra->file_handle = thread->file_handle;
+        ra->pack = thread->pack;
+        ra->offset = thread->pack_offset + thread->fetched_offset;
+        ra->size = (num_bytes < chunk_size) ? num_bytes : chunk_size;
+        ra->ptr = buffer->ptr + ra->half * half_size;
     }
-    LeaveCriticalSection(&thread->outgoing_critsec);
-    return result;
 }
 
-_SOKOL_PRIVATE void _sfetch_thread_dequeue_outgoing(_sfetch_thread_t* thread, _sfetch_ring_t* outgoing, _sfetch_ring_t* dst) {
-    /* called from user thread */
-    SOKOL_ASSERT(thread && thread->valid);
-    SOKOL_ASSERT(outgoing && outgoing->buf);
-    SOKOL_ASSERT(dst && dst->buf);
-    EnterCriticalSection(&thread->outgoing_critsec);
-    while (!_sfetch_ring_full(dst) && !_sfetch_ring_empty(outgoing)) {
-        _sfetch_ring_enqueue(dst, _sfetch_ring_dequeue(outgoing));
+/* called by the IO thread after the request handler, returns the readahead
+   to run after the item has been handed to the user thread, or null
+*/
+_SOKOL_PRIVATE _sfetch_readahead_t* _sfetch_readahead_begin(_sfetch_t* ctx, uint32_t slot_id) {
+    _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
+    if (!item || !item->thread.readahead.pending) {
+        return 0;
     }
-    LeaveCriticalSection(&thread->outgoing_critsec);
+    _sfetch_readahead_t* ra = &item->thread.readahead;
+    ra->pending = false;
+    _sfetch_atomic_store(&ra->busy, 1);
+    return ra;
 }
-#endif /* _SFETCH_PLATFORM_WINDOWS */
 
-/*=== IO CHANNEL implementation ==============================================*/
+/* read the next chunk while the user thread processes the current chunk,
+   only the readahead state is accessed since the item belongs to the user thread
+*/
+_SOKOL_PRIVATE void _sfetch_readahead_read(_sfetch_readahead_t* ra) {
+    ra->failed = !(ra->pack ?
+                   _sfetch_pack_read(ra->pack, ra->offset, ra->size, ra->ptr) :
+                   _sfetch_file_read(ra->file_handle, ra->offset, ra->size, ra->ptr));
+    ra->valid = true;
+    _sfetch_atomic_store(&ra->busy, 0);
+}
 
-/* per-channel request handler for native platforms accessing the local filesystem */
-#if _SFETCH_HAS_THREADS
 _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
     _sfetch_state_t state;
     _sfetch_path_t* path;
     _sfetch_item_thread_t* thread;
     _sfetch_buffer_t* buffer;
     uint32_t chunk_size;
+    bool memory_mapped;
+    bool readahead;
     {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (!item) {
@@ -1899,12 +3533,14 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
         thread = &item->thread;
         buffer = &item->buffer;
         chunk_size = item->chunk_size;
+        memory_mapped = item->memory_mapped;
+        readahead = item->readahead;
     }
-    if (thread->failed) {
-        return;
-    }
-    if (state == _SFETCH_STATE_FETCHING) {
-        if ((buffer->ptr == 0) || (buffer->size == 0)) {
+    thread->io_start_time = _sfetch_now();
+    /* the previous handoff may have started a readahead on another IO thread */
+    _sfetch_readahead_wait(&thread->readahead);
+    if (!thread->failed && (state == _SFETCH_STATE_FETCHING)) {
+        if (!memory_mapped && ((buffer->ptr == 0) || (buffer->size == 0))) {
             thread->error_code = SFETCH_ERROR_NO_BUFFER;
             thread->failed = true;
         }
@@ -1912,68 +3548,46 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
             /* open file if not happened yet */
             if (!_sfetch_file_handle_valid(thread->file_handle)) {
                 SOKOL_ASSERT(path->buf[0]);
-                SOKOL_ASSERT(thread->fetched_offset == 0);
                 SOKOL_ASSERT(thread->fetched_size == 0);
-                thread->file_handle = _sfetch_file_open(path);
+                thread->file_handle = thread->pack ? thread->pack->file_handle : _sfetch_file_open(path);
                 if (_sfetch_file_handle_valid(thread->file_handle)) {
-                    thread->content_size = _sfetch_file_size(thread->file_handle);
+                    _sfetch_file_opened(thread, chunk_size);
                 }
                 else {
                     thread->error_code = SFETCH_ERROR_FILE_NOT_FOUND;
                     thread->failed = true;
                 }
             }
-            if (!thread->failed) {
-                uint32_t read_offset = 0;
-                uint32_t bytes_to_read = 0;
-                if (chunk_size == 0) {
-                    /* load entire file */
-                    if (thread->content_size <= buffer->size) {
-                        bytes_to_read = thread->content_size;
-                        read_offset = 0;
-                    }
-                    else {
-                        /* provided buffer to small to fit entire file */
-                        thread->error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
-                        thread->failed = true;
-                    }
+            uint64_t read_offset = 0;
+            uint64_t bytes_to_read = 0;
+            if (!thread->failed && thread->lz4.enabled) {
+                _sfetch_lz4_fetch(thread, buffer, chunk_size);
+            }
+            else if (!thread->failed && readahead && (chunk_size > 0)) {
+                _sfetch_readahead_fetch(thread, buffer, chunk_size);
+            }
+            else if (!thread->failed && _sfetch_file_next_range(thread, buffer, chunk_size, memory_mapped, &read_offset, &bytes_to_read)) {
+                _sfetch_file_advise_next_chunk(thread, chunk_size, read_offset + bytes_to_read);
+                if (memory_mapped) {
+                    _sfetch_file_map_range(thread, read_offset, bytes_to_read);
                 }
-                else {
-                    if (chunk_size <= buffer->size) {
-                        bytes_to_read = chunk_size;
-                        read_offset = thread->fetched_offset;
-                        if ((read_offset + bytes_to_read) > thread->content_size) {
-                            bytes_to_read = thread->content_size - read_offset;
-                        }
-                    }
-                    else {
-                        /* provided buffer to small to fit next chunk */
-                        thread->error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
-                        thread->failed = true;
-                    }
+                else if (thread->pack ?
+                         _sfetch_pack_read(thread->pack, read_offset, bytes_to_read, buffer->ptr) :
+                         _sfetch_file_read(thread->file_handle, read_offset, bytes_to_read, buffer->ptr))
+                {
+                    thread->fetched_size = bytes_to_read;
+                    thread->fetched_offset += bytes_to_read;
                 }
-                if (!thread->failed) {
-                    if (_sfetch_file_read(thread->file_handle, read_offset, bytes_to_read, buffer->ptr)) {
-                        thread->fetched_size = bytes_to_read;
-                        thread->fetched_offset += bytes_to_read;
-                    }
-                    else {
-                        thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
-                        thread->failed = true;
-                    }
+                else {
+                    thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+                    thread->failed = true;
                 }
             }
         }
-        SOKOL_ASSERT(thread->fetched_offset <= thread->content_size);
-        if (thread->failed || (thread->fetched_offset == thread->content_size)) {
-            if (_sfetch_file_handle_valid(thread->file_handle)) {
-                _sfetch_file_close(thread->file_handle);
-                thread->file_handle = _SFETCH_INVALID_FILE_HANDLE;
-            }
-            thread->finished = true;
-        }
+        _sfetch_file_check_finished(thread);
     }
     /* ignore items in PAUSED or FAILED state */
+    thread->io_end_time = _sfetch_now();
 }
 
 #if _SFETCH_PLATFORM_WINDOWS
@@ -1981,24 +3595,434 @@ _SOKOL_PRIVATE DWORD WINAPI _sfetch_channel_thread_func(LPVOID arg) {
 #else
 _SOKOL_PRIVATE void* _sfetch_channel_thread_func(void* arg) {
 #endif
-    _sfetch_channel_t* chn = (_sfetch_channel_t*) arg;
+    _sfetch_thread_worker_t* worker = (_sfetch_thread_worker_t*) arg;
+    _sfetch_channel_t* chn = (_sfetch_channel_t*) worker->arg;
     _sfetch_thread_entered(&chn->thread);
     while (!_sfetch_thread_stop_requested(&chn->thread)) {
         /* block until work arrives */
-        uint32_t slot_id = _sfetch_thread_dequeue_incoming(&chn->thread, &chn->thread_incoming);
+        uint32_t slot_id = _sfetch_thread_dequeue_incoming(&chn->thread, worker);
         /* slot_id will be invalid if the thread was woken up to join */
-        if (!_sfetch_thread_stop_requested(&chn->thread)) {
-            SOKOL_ASSERT(0 != slot_id);
+        if (0 != slot_id) {
             chn->request_handler(chn->ctx, slot_id);
-            SOKOL_ASSERT(!_sfetch_ring_full(&chn->thread_outgoing));
-            _sfetch_thread_enqueue_outgoing(&chn->thread, &chn->thread_outgoing, slot_id);
+            /* the readahead must be started before the item belongs to the user thread */
+            _sfetch_readahead_t* readahead = _sfetch_readahead_begin(chn->ctx, slot_id);
+            _sfetch_thread_enqueue_outgoing(&chn->thread, worker, slot_id);
+            if (readahead) {
+                _sfetch_readahead_read(readahead);
+            }
         }
     }
-    _sfetch_thread_leaving(&chn->thread);
     return 0;
 }
 #endif /* _SFETCH_HAS_THREADS */
 
+/*=== IO_URING backend =======================================================*/
+#if _SFETCH_USE_IO_URING
+/* user_data of the eventfd read, all other submissions carry the slot id */
+#define _SFETCH_URING_WAKEUP_USER_DATA (0)
+/* max number of bytes per read submission */
+#define _SFETCH_URING_MAX_READ_SIZE (1u<<30)
+
+_SOKOL_PRIVATE void _sfetch_uring_discard(_sfetch_uring_t* uring) {
+    SOKOL_ASSERT(uring);
+    if (uring->sqes) {
+        munmap(uring->sqes, uring->sqes_size);
+    }
+    if (uring->cq_ptr) {
+        munmap(uring->cq_ptr, uring->cq_size);
+    }
+    if (uring->sq_ptr) {
+        munmap(uring->sq_ptr, uring->sq_size);
+    }
+    if (uring->fd >= 0) {
+        close(uring->fd);
+    }
+    if (uring->wakeup_fd >= 0) {
+        close(uring->wakeup_fd);
+    }
+    _sfetch_clear(uring, sizeof(_sfetch_uring_t));
+    uring->fd = -1;
+    uring->wakeup_fd = -1;
+}
+
+/* check whether the kernel supports all required operations */
+_SOKOL_PRIVATE bool _sfetch_uring_probe(int fd) {
+    union {
+        struct io_uring_probe probe;
+        uint8_t buf[sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op)];
+    } probe;
+    _sfetch_clear(&probe, sizeof(probe));
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, &probe, 256) < 0) {
+        return false;
+    }
+    const uint32_t ops[2] = { IORING_OP_OPENAT, IORING_OP_READ };
+    for (uint32_t i = 0; i < 2; i++) {
+        if ((ops[i] > probe.probe.last_op) || (0 == (probe.probe.ops[ops[i]].flags & IO_URING_OP_SUPPORTED))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* setup an io_uring instance, returns false if io_uring isn't available */
+_SOKOL_PRIVATE bool _sfetch_uring_init(_sfetch_uring_t* uring, uint32_t num_entries) {
+    SOKOL_ASSERT(uring && !uring->valid && (num_entries > 0));
+    _sfetch_clear(uring, sizeof(_sfetch_uring_t));
+    uring->fd = -1;
+    uring->wakeup_fd = -1;
+    struct io_uring_params params;
+    _sfetch_clear(&params, sizeof(params));
+    uring->fd = (int) syscall(__NR_io_uring_setup, num_entries, &params);
+    if (uring->fd < 0) {
+        SOKOL_LOG("sokol_fetch.h: io_uring_setup() failed, falling back to IO threads");
+        _sfetch_uring_discard(uring);
+        return false;
+    }
+    if (!_sfetch_uring_probe(uring->fd)) {
+        SOKOL_LOG("sokol_fetch.h: io_uring doesn't support OPENAT/READ, falling back to IO threads");
+        _sfetch_uring_discard(uring);
+        return false;
+    }
+    uring->sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    uring->cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    uring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sq_ptr = mmap(0, uring->sq_size, PROT_READ|PROT_WRITE, MAP_SHARED, uring->fd, IORING_OFF_SQ_RING);
+    void* cq_ptr = mmap(0, uring->cq_size, PROT_READ|PROT_WRITE, MAP_SHARED, uring->fd, IORING_OFF_CQ_RING);
+    void* sqes = mmap(0, uring->sqes_size, PROT_READ|PROT_WRITE, MAP_SHARED, uring->fd, IORING_OFF_SQES);
+    uring->sq_ptr = (sq_ptr == MAP_FAILED) ? 0 : sq_ptr;
+    uring->cq_ptr = (cq_ptr == MAP_FAILED) ? 0 : cq_ptr;
+    uring->sqes = (sqes == MAP_FAILED) ? 0 : (struct io_uring_sqe*) sqes;
+    uring->wakeup_fd = eventfd(0, 0);
+    if (!uring->sq_ptr || !uring->cq_ptr || !uring->sqes || (uring->wakeup_fd < 0)) {
+        SOKOL_LOG("sokol_fetch.h: failed to map io_uring queues, falling back to IO threads");
+        _sfetch_uring_discard(uring);
+        return false;
+    }
+    uint8_t* sq = (uint8_t*) uring->sq_ptr;
+    uint8_t* cq = (uint8_t*) uring->cq_ptr;
+    uring->sq_head = (uint32_t*) (sq + params.sq_off.head);
+    uring->sq_tail = (uint32_t*) (sq + params.sq_off.tail);
+    uring->sq_mask = (uint32_t*) (sq + params.sq_off.ring_mask);
+    uring->sq_array = (uint32_t*) (sq + params.sq_off.array);
+    uring->cq_head = (uint32_t*) (cq + params.cq_off.head);
+    uring->cq_tail = (uint32_t*) (cq + params.cq_off.tail);
+    uring->cq_mask = (uint32_t*) (cq + params.cq_off.ring_mask);
+    uring->cqes = (struct io_uring_cqe*) (cq + params.cq_off.cqes);
+    uring->valid = true;
+    return true;
+}
+
+/* get the next free submission queue entry, the queue is big enough
+   to hold one entry per lane plus the eventfd read, so this can't fail,
+   the entry must be filled in before it is published with _sfetch_uring_commit_sqe()
+*/
+_SOKOL_PRIVATE struct io_uring_sqe* _sfetch_uring_next_sqe(_sfetch_uring_t* uring) {
+    SOKOL_ASSERT(uring && uring->valid);
+    const uint32_t tail = *uring->sq_tail;
+    SOKOL_ASSERT((tail - __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE)) <= *uring->sq_mask);
+    struct io_uring_sqe* sqe = &uring->sqes[tail & *uring->sq_mask];
+    _sfetch_clear(sqe, sizeof(struct io_uring_sqe));
+    return sqe;
+}
+
+/* publish the entry returned by _sfetch_uring_next_sqe(), the release store
+   makes sure the kernel never sees a partially written entry
+*/
+_SOKOL_PRIVATE void _sfetch_uring_commit_sqe(_sfetch_uring_t* uring) {
+    const uint32_t tail = *uring->sq_tail;
+    const uint32_t index = tail & *uring->sq_mask;
+    uring->sq_array[index] = index;
+    __atomic_store_n(uring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    uring->num_to_submit++;
+}
+
+_SOKOL_PRIVATE void _sfetch_uring_submit_read(_sfetch_uring_t* uring, int fd, void* ptr, uint64_t offset, uint64_t num_bytes, uint64_t user_data) {
+    struct io_uring_sqe* sqe = _sfetch_uring_next_sqe(uring);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t) (uintptr_t) ptr;
+    sqe->len = (uint32_t) ((num_bytes > _SFETCH_URING_MAX_READ_SIZE) ? _SFETCH_URING_MAX_READ_SIZE : num_bytes);
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    _sfetch_uring_commit_sqe(uring);
+}
+
+_SOKOL_PRIVATE void _sfetch_uring_submit_open(_sfetch_uring_t* uring, const char* path, uint64_t user_data) {
+    struct io_uring_sqe* sqe = _sfetch_uring_next_sqe(uring);
+    sqe->opcode = IORING_OP_OPENAT;
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uint64_t) (uintptr_t) path;
+    sqe->open_flags = O_RDONLY;
+    sqe->user_data = user_data;
+    _sfetch_uring_commit_sqe(uring);
+}
+
+_SOKOL_PRIVATE void _sfetch_uring_submit_wakeup_read(_sfetch_uring_t* uring) {
+    _sfetch_uring_submit_read(uring, uring->wakeup_fd, &uring->wakeup_value, 0, sizeof(uring->wakeup_value), _SFETCH_URING_WAKEUP_USER_DATA);
+}
+
+/* submit the pending queue entries and wait for at least one completion,
+   returns 0, or the errno of a failed io_uring_enter()
+*/
+_SOKOL_PRIVATE int _sfetch_uring_submit_and_wait(_sfetch_uring_t* uring) {
+    SOKOL_ASSERT(uring && uring->valid);
+    int res;
+    do {
+        res = (int) syscall(__NR_io_uring_enter, uring->fd, uring->num_to_submit, 1, IORING_ENTER_GETEVENTS, 0, 0);
+    } while ((res < 0) && (errno == EINTR));
+    if (res < 0) {
+        return errno;
+    }
+    SOKOL_ASSERT((uint32_t)res <= uring->num_to_submit);
+    uring->num_to_submit -= (uint32_t)res;
+    uring->num_in_kernel += (uint32_t)res;
+    return 0;
+}
+
+_SOKOL_PRIVATE bool _sfetch_uring_cq_empty(_sfetch_uring_t* uring) {
+    return *uring->cq_head == __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+}
+
+/* wait for a completion without io_uring_enter(), used when submitting fails */
+_SOKOL_PRIVATE void _sfetch_uring_wait_cq(_sfetch_uring_t* uring) {
+    struct pollfd pfd;
+    _sfetch_clear(&pfd, sizeof(pfd));
+    pfd.fd = uring->fd;
+    pfd.events = POLLIN;
+    while ((poll(&pfd, 1, -1) < 0) && (errno == EINTR));
+}
+
+/* after a fatal io_uring_enter() error, fail the items of the queued entries
+   which haven't been consumed by the kernel and drop the entries, returns
+   the number of failed items
+*/
+_SOKOL_PRIVATE uint32_t _sfetch_uring_fail_unsubmitted(_sfetch_channel_t* chn, _sfetch_thread_worker_t* worker, bool* out_wakeup_dropped) {
+    _sfetch_uring_t* uring = &chn->uring;
+    const uint32_t head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+    const uint32_t tail = *uring->sq_tail;
+    uint32_t num_failed = 0;
+    *out_wakeup_dropped = false;
+    for (uint32_t i = head; i != tail; i++) {
+        const struct io_uring_sqe* sqe = &uring->sqes[uring->sq_array[i & *uring->sq_mask]];
+        if (sqe->user_data == _SFETCH_URING_WAKEUP_USER_DATA) {
+            *out_wakeup_dropped = true;
+            continue;
+        }
+        const uint32_t slot_id = (uint32_t) sqe->user_data;
+        _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, slot_id);
+        SOKOL_ASSERT(item);
+        _sfetch_item_thread_t* thread = &item->thread;
+        /* an item without a file handle was waiting for its open operation */
+        thread->error_code = _sfetch_file_handle_valid(thread->file_handle) ? SFETCH_ERROR_UNEXPECTED_EOF : SFETCH_ERROR_FILE_NOT_FOUND;
+        thread->failed = true;
+        _sfetch_file_check_finished(thread);
+        thread->io_end_time = _sfetch_now();
+        _sfetch_thread_enqueue_outgoing(&chn->thread, worker, slot_id);
+        num_failed++;
+    }
+    /* without SQPOLL the kernel only reads the queue inside io_uring_enter() */
+    __atomic_store_n(uring->sq_tail, head, __ATOMIC_RELEASE);
+    uring->num_to_submit = 0;
+    return num_failed;
+}
+
+/* compute the next file range of an item and either submit a read, or
+   complete the IO operation right away, returns true if a read is in flight
+*/
+_SOKOL_PRIVATE bool _sfetch_uring_next_read(_sfetch_uring_t* uring, _sfetch_item_t* item) {
+    _sfetch_item_thread_t* thread = &item->thread;
+    uint64_t read_offset = 0;
+    uint64_t bytes_to_read = 0;
+    /* readahead requests alternate between the buffer halves, but aren't read ahead,
+       the in-flight reads of other lanes already keep the disk busy
+    */
+    _sfetch_buffer_t buffer = item->buffer;
+    if (item->readahead && (item->chunk_size > 0)) {
+        buffer.size = item->buffer.size / 2;
+        thread->fetched_buffer_offset = thread->readahead.half * buffer.size;
+        buffer.ptr += thread->fetched_buffer_offset;
+        thread->readahead.half ^= 1;
+    }
+    if (!thread->failed && thread->lz4.enabled) {
+        /* LZ4 requests are read and decompressed with blocking reads */
+        _sfetch_lz4_fetch(thread, &item->buffer, item->chunk_size);
+    }
+    else if (!thread->failed && _sfetch_file_next_range(thread, &buffer, item->chunk_size, item->memory_mapped, &read_offset, &bytes_to_read)) {
+        if (item->memory_mapped) {
+            _sfetch_file_map_range(thread, read_offset, bytes_to_read);
+        }
+        else if (bytes_to_read == 0) {
+            thread->fetched_size = 0;
+        }
+        else {
+            _sfetch_file_advise_next_chunk(thread, item->chunk_size, read_offset + bytes_to_read);
+            thread->uring_read_offset = read_offset;
+            thread->uring_read_size = bytes_to_read;
+            thread->uring_read_done = 0;
+            _sfetch_uring_submit_read(uring, thread->file_handle, buffer.ptr, read_offset, bytes_to_read, item->handle.id);
+            return true;
+        }
+    }
+    _sfetch_file_check_finished(thread);
+    return false;
+}
+
+/* start the IO operation of an item, returns true if an operation is in flight */
+_SOKOL_PRIVATE bool _sfetch_uring_start(_sfetch_uring_t* uring, _sfetch_item_t* item) {
+    _sfetch_item_thread_t* thread = &item->thread;
+    thread->io_start_time = _sfetch_now();
+    if (thread->failed || (item->state != _SFETCH_STATE_FETCHING)) {
+        /* ignore items in PAUSED or FAILED state */
+        return false;
+    }
+    if (!item->memory_mapped && ((item->buffer.ptr == 0) || (item->buffer.size == 0))) {
+        thread->error_code = SFETCH_ERROR_NO_BUFFER;
+        thread->failed = true;
+        _sfetch_file_check_finished(thread);
+        return false;
+    }
+    if (!_sfetch_file_handle_valid(thread->file_handle)) {
+        SOKOL_ASSERT(item->path.buf[0]);
+        SOKOL_ASSERT(thread->fetched_size == 0);
+        if (thread->pack) {
+            /* positional reads don't need to be serialized */
+            thread->file_handle = thread->pack->file_handle;
+            _sfetch_file_opened(thread, item->chunk_size);
+            return _sfetch_uring_next_read(uring, item);
+        }
+        _sfetch_uring_submit_open(uring, item->path.buf, item->handle.id);
+        return true;
+    }
+    return _sfetch_uring_next_read(uring, item);
+}
+
+/* handle the completion of an item's open or read operation, returns true if another operation is in flight */
+_SOKOL_PRIVATE bool _sfetch_uring_complete(_sfetch_uring_t* uring, _sfetch_item_t* item, int32_t res) {
+    _sfetch_item_thread_t* thread = &item->thread;
+    if (!_sfetch_file_handle_valid(thread->file_handle)) {
+        /* an open operation has completed */
+        if (res >= 0) {
+            thread->file_handle = res;
+            _sfetch_file_opened(thread, item->chunk_size);
+            return _sfetch_uring_next_read(uring, item);
+        }
+        thread->error_code = SFETCH_ERROR_FILE_NOT_FOUND;
+        thread->failed = true;
+    }
+    else {
+        /* a read operation has completed, reads may be short or interrupted */
+        if ((res == -EINTR) || (res == -EAGAIN)) {
+            res = 0;
+        }
+        else if (res <= 0) {
+            thread->error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+            thread->failed = true;
+        }
+        if (!thread->failed) {
+            thread->uring_read_done += (uint64_t)res;
+            if (thread->uring_read_done < thread->uring_read_size) {
+                _sfetch_uring_submit_read(uring,
+                    thread->file_handle,
+                    item->buffer.ptr + thread->fetched_buffer_offset + thread->uring_read_done,
+                    thread->uring_read_offset + thread->uring_read_done,
+                    thread->uring_read_size - thread->uring_read_done,
+                    item->handle.id);
+                return true;
+            }
+            thread->fetched_size = thread->uring_read_size;
+            thread->fetched_offset += thread->uring_read_size;
+        }
+    }
+    _sfetch_file_check_finished(thread);
+    return false;
+}
+
+/* the channel thread function when using io_uring, this keeps the IO operations
+   of all lanes in flight at the same time, an eventfd read operation wakes up
+   the thread when new requests arrive or the thread should be joined
+*/
+_SOKOL_PRIVATE void* _sfetch_channel_uring_thread_func(void* arg) {
+    _sfetch_thread_worker_t* worker = (_sfetch_thread_worker_t*) arg;
+    _sfetch_channel_t* chn = (_sfetch_channel_t*) worker->arg;
+    _sfetch_uring_t* uring = &chn->uring;
+    _sfetch_thread_entered(&chn->thread);
+    uint32_t num_in_flight = 0;
+    _sfetch_uring_submit_wakeup_read(uring);
+    while (true) {
+        /* start the IO operations of newly arrived requests */
+        uint32_t slot_id;
+        while (0 != (slot_id = _sfetch_thread_try_dequeue_incoming(&chn->thread, worker))) {
+            _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, slot_id);
+            if (item && _sfetch_uring_start(uring, item)) {
+                num_in_flight++;
+            }
+            else {
+                if (item) {
+                    item->thread.io_end_time = _sfetch_now();
+                }
+                _sfetch_thread_enqueue_outgoing(&chn->thread, worker, slot_id);
+            }
+        }
+        /* on join, wait for the in-flight operations, they still write into user buffers */
+        if (_sfetch_thread_stop_requested(&chn->thread) && (0 == num_in_flight)) {
+            break;
+        }
+        const int err = _sfetch_uring_submit_and_wait(uring);
+        if (0 != err) {
+            /* on EBUSY or EAGAIN the queued entries are submitted again after reaping completions,
+               other errors are fatal for the queued entries, but don't stop the thread
+            */
+            const bool fatal = (err != EBUSY) && (err != EAGAIN);
+            if (fatal) {
+                bool wakeup_dropped = false;
+                num_in_flight -= _sfetch_uring_fail_unsubmitted(chn, worker, &wakeup_dropped);
+                if (wakeup_dropped && !_sfetch_thread_stop_requested(&chn->thread)) {
+                    _sfetch_uring_submit_wakeup_read(uring);
+                }
+            }
+            if (_sfetch_uring_cq_empty(uring)) {
+                if (uring->num_in_kernel > 0) {
+                    _sfetch_uring_wait_cq(uring);
+                }
+                else if (fatal) {
+                    /* nothing in the kernel, not even the eventfd read, wait for new requests */
+                    _sfetch_thread_wait(&chn->thread, worker);
+                }
+                else {
+                    sched_yield();
+                }
+            }
+        }
+        uint32_t head = *uring->cq_head;
+        const uint32_t tail = __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const struct io_uring_cqe* cqe = &uring->cqes[head & *uring->cq_mask];
+            const uint64_t user_data = cqe->user_data;
+            const int32_t res = cqe->res;
+            head++;
+            SOKOL_ASSERT(uring->num_in_kernel > 0);
+            uring->num_in_kernel--;
+            if (user_data == _SFETCH_URING_WAKEUP_USER_DATA) {
+                if (!_sfetch_thread_stop_requested(&chn->thread)) {
+                    _sfetch_uring_submit_wakeup_read(uring);
+                }
+                continue;
+            }
+            slot_id = (uint32_t) user_data;
+            _sfetch_item_t* item = _sfetch_pool_item_lookup(&chn->ctx->pool, slot_id);
+            SOKOL_ASSERT(item && (num_in_flight > 0));
+            if (!_sfetch_uring_complete(uring, item, res)) {
+                num_in_flight--;
+                item->thread.io_end_time = _sfetch_now();
+                _sfetch_thread_enqueue_outgoing(&chn->thread, worker, slot_id);
+            }
+        }
+        __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return 0;
+}
+#endif /* _SFETCH_USE_IO_URING */
+
 #if _SFETCH_PLATFORM_EMSCRIPTEN
 /*=== embedded Javascript helper functions ===================================*/
 EM_JS(void, sfetch_js_send_head_request, (uint32_t slot_id, const char* path_cstr), {
@@ -2019,8 +4043,10 @@ EM_JS(void, sfetch_js_send_head_request, (uint32_t slot_id, const char* path_cst
     req.send();
 });
 
-/* if bytes_to_read != 0, a range-request will be sent, otherwise a normal request */
-EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr, uint32_t offset, uint32_t bytes_to_read, void* buf_ptr, uint32_t buf_size), {
+/* if bytes_to_read != 0, a range-request will be sent, otherwise a normal request,
+   NOTE: offsets and sizes are passed as double to keep 64-bit values intact
+*/
+EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr, double offset, double bytes_to_read, void* buf_ptr, uint32_t buf_size), {
     var path_str = UTF8ToString(path_cstr);
     var req = new XMLHttpRequest();
     req.open('GET', path_str);
@@ -2054,58 +4080,77 @@ EM_JS(void, sfetch_js_send_get_request, (uint32_t slot_id, const char* path_cstr
 #ifdef __cplusplus
 extern "C" {
 #endif
+/* hand an item back to the user thread */
+void _sfetch_emsc_done(_sfetch_t* ctx, uint32_t slot_id, _sfetch_item_t* item) {
+    item->thread.io_end_time = _sfetch_now();
+    _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+}
+
 void _sfetch_emsc_send_get_request(uint32_t slot_id, _sfetch_item_t* item) {
     if ((item->buffer.ptr == 0) || (item->buffer.size == 0)) {
         item->thread.error_code = SFETCH_ERROR_NO_BUFFER;
         item->thread.failed = true;
     }
     else {
-        uint32_t offset = 0;
-        uint32_t bytes_to_read = 0;
-        if (item->chunk_size > 0) {
+        uint64_t offset = 0;
+        uint64_t bytes_to_read = 0;
+        if ((item->chunk_size > 0) || (item->thread.http_range_offset > 0)) {
             /* send HTTP range request */
             SOKOL_ASSERT(item->thread.content_size > 0);
             SOKOL_ASSERT(item->thread.http_range_offset < item->thread.content_size);
             bytes_to_read = item->thread.content_size - item->thread.http_range_offset;
-            if (bytes_to_read > item->chunk_size) {
+            if ((item->chunk_size > 0) && (bytes_to_read > item->chunk_size)) {
                 bytes_to_read = item->chunk_size;
             }
             SOKOL_ASSERT(bytes_to_read > 0);
             offset = item->thread.http_range_offset;
         }
-        sfetch_js_send_get_request(slot_id, item->path.buf, offset, bytes_to_read, item->buffer.ptr, item->buffer.size);
+        /* the buffer lives in the WASM heap, so its size always fits into 32 bits */
+        const uint32_t buf_size = (item->buffer.size > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)item->buffer.size;
+        sfetch_js_send_get_request(slot_id, item->path.buf, (double)offset, (double)bytes_to_read, item->buffer.ptr, buf_size);
     }
 }
 
 /* called by JS when an initial HEAD request finished successfully (only when streaming chunks) */
-EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_head_response(uint32_t slot_id, uint32_t content_length) {
+EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_head_response(uint32_t slot_id, double content_length) {
     _sfetch_t* ctx = _sfetch_ctx();
     if (ctx && ctx->valid) {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (item) {
             SOKOL_ASSERT(item->buffer.ptr && (item->buffer.size > 0));
-            item->thread.content_size = content_length;
-            _sfetch_emsc_send_get_request(slot_id, item);
+            item->thread.content_size = (uint64_t)content_length;
+            if (item->thread.http_range_offset < item->thread.content_size) {
+                _sfetch_emsc_send_get_request(slot_id, item);
+            }
+            else {
+                /* the request offset is at or beyond the end of the file */
+                if (item->thread.http_range_offset > item->thread.content_size) {
+                    item->thread.error_code = SFETCH_ERROR_UNEXPECTED_EOF;
+                    item->thread.failed = true;
+                }
+                item->thread.finished = true;
+                _sfetch_emsc_done(ctx, slot_id, item);
+            }
         }
     }
 }
 
 /* called by JS when a followup GET request finished successfully */
-EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_get_response(uint32_t slot_id, uint32_t range_fetched_size, uint32_t content_fetched_size) {
+EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_get_response(uint32_t slot_id, double range_fetched_size, uint32_t content_fetched_size) {
     _sfetch_t* ctx = _sfetch_ctx();
     if (ctx && ctx->valid) {
         _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, slot_id);
         if (item) {
             item->thread.fetched_size = content_fetched_size;
             item->thread.fetched_offset += content_fetched_size;
-            item->thread.http_range_offset += range_fetched_size;
+            item->thread.http_range_offset += (uint64_t)range_fetched_size;
             if (item->chunk_size == 0) {
                 item->thread.finished = true;
             }
             else if (item->thread.http_range_offset >= item->thread.content_size) {
                 item->thread.finished = true;
             }
-            _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+            _sfetch_emsc_done(ctx, slot_id, item);
         }
     }
 }
@@ -2124,7 +4169,7 @@ EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_failed_http_status(uint32_t slot_id, uint
             }
             item->thread.failed = true;
             item->thread.finished = true;
-            _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+            _sfetch_emsc_done(ctx, slot_id, item);
         }
     }
 }
@@ -2137,7 +4182,7 @@ EMSCRIPTEN_KEEPALIVE void _sfetch_emsc_failed_buffer_too_small(uint32_t slot_id)
             item->thread.error_code = SFETCH_ERROR_BUFFER_TOO_SMALL;
             item->thread.failed = true;
             item->thread.finished = true;
-            _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+            _sfetch_emsc_done(ctx, slot_id, item);
         }
     }
 }
@@ -2151,10 +4196,11 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
     if (!item) {
         return;
     }
+    item->thread.io_start_time = _sfetch_now();
     if (item->state == _SFETCH_STATE_FETCHING) {
-        if ((item->chunk_size > 0) && (item->thread.content_size == 0)) {
-            /* if streaming download is requested, and the content-length isn't known
-               yet, need to send a HEAD request first
+        if (((item->chunk_size > 0) || (item->thread.http_range_offset > 0)) && (item->thread.content_size == 0)) {
+            /* if streaming download or a request offset is requested, and the
+               content-length isn't known yet, need to send a HEAD request first
              */
             sfetch_js_send_head_request(slot_id, item->path.buf);
         }
@@ -2169,7 +4215,7 @@ _SOKOL_PRIVATE void _sfetch_request_handler(_sfetch_t* ctx, uint32_t slot_id) {
         /* just move all other items (e.g. paused or cancelled)
            into the outgoing queue, so they wont get lost
         */
-        _sfetch_ring_enqueue(&ctx->chn[item->channel].user_outgoing, slot_id);
+        _sfetch_emsc_done(ctx, slot_id, item);
     }
     if (item->thread.failed) {
         item->thread.finished = true;
@@ -2183,8 +4229,15 @@ _SOKOL_PRIVATE void _sfetch_channel_discard(_sfetch_channel_t* chn) {
         if (chn->valid) {
             _sfetch_thread_join(&chn->thread);
         }
-        _sfetch_ring_discard(&chn->thread_incoming);
-        _sfetch_ring_discard(&chn->thread_outgoing);
+        #if _SFETCH_USE_IO_URING
+        if (chn->uring.valid) {
+            _sfetch_uring_discard(&chn->uring);
+        }
+        #endif
+        if (chn->lz4_buffers) {
+            _sfetch_free(chn->lz4_buffers);
+            chn->lz4_buffers = 0;
+        }
     #endif
     _sfetch_ring_discard(&chn->free_lanes);
     _sfetch_ring_discard(&chn->user_sent);
@@ -2194,12 +4247,16 @@ _SOKOL_PRIVATE void _sfetch_channel_discard(_sfetch_channel_t* chn) {
     chn->valid = false;
 }
 
-_SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx, uint32_t num_items, uint32_t num_lanes, void (*request_handler)(_sfetch_t* ctx, uint32_t)) {
-    SOKOL_ASSERT(chn && (num_items > 0) && request_handler);
+_SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx, uint32_t num_items, uint32_t num_lanes, uint32_t num_threads, void (*request_handler)(_sfetch_t* ctx, uint32_t)) {
+    SOKOL_ASSERT(chn && (num_items > 0) && (num_threads > 0) && request_handler);
     SOKOL_ASSERT(!chn->valid);
+    _SOKOL_UNUSED(num_threads);
     bool valid = true;
+    bool threads_started = false;
     chn->request_handler = request_handler;
     chn->ctx = ctx;
+    chn->num_lanes = num_lanes;
+    _sfetch_stats_reset(&chn->stats, _sfetch_now());
     valid &= _sfetch_ring_init(&chn->free_lanes, num_lanes);
     for (uint32_t lane = 0; lane < num_lanes; lane++) {
         _sfetch_ring_enqueue(&chn->free_lanes, lane);
@@ -2207,15 +4264,28 @@ _SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx,
     valid &= _sfetch_ring_init(&chn->user_sent, num_items);
     valid &= _sfetch_ring_init(&chn->user_incoming, num_lanes);
     valid &= _sfetch_ring_init(&chn->user_outgoing, num_lanes);
-    #if _SFETCH_HAS_THREADS
-        valid &= _sfetch_ring_init(&chn->thread_incoming, num_lanes);
-        valid &= _sfetch_ring_init(&chn->thread_outgoing, num_lanes);
-    #endif
     if (valid) {
         chn->valid = true;
         #if _SFETCH_HAS_THREADS
-        _sfetch_thread_init(&chn->thread, _sfetch_channel_thread_func, chn);
+        /* each IO thread's message queues can hold all lanes of the channel */
+        #if _SFETCH_USE_IO_URING
+        /* with io_uring, a single thread keeps the IO of all lanes in flight */
+        chn->thread.wakeup_fd = -1;
+        if ((request_handler == _sfetch_request_handler) && _sfetch_uring_init(&chn->uring, num_lanes + 1)) {
+            chn->thread.wakeup_fd = chn->uring.wakeup_fd;
+            threads_started = _sfetch_thread_init(&chn->thread, 1, num_lanes, _sfetch_channel_uring_thread_func, chn);
+        }
+        else
+        #endif
+        {
+            /* more threads than lanes would never have anything to do */
+            threads_started = _sfetch_thread_init(&chn->thread, (num_threads < num_lanes) ? num_threads : num_lanes, num_lanes, _sfetch_channel_thread_func, chn);
+        }
+        #else
+        threads_started = true;
         #endif
+    }
+    if (valid && threads_started) {
         return true;
     }
     else {
@@ -2224,6 +4294,17 @@ _SOKOL_PRIVATE bool _sfetch_channel_init(_sfetch_channel_t* chn, _sfetch_t* ctx,
     }
 }
 
+/* allocate the per-lane scratch buffers for LZ4 requests */
+#if _SFETCH_HAS_THREADS
+_SOKOL_PRIVATE bool _sfetch_channel_init_lz4(_sfetch_channel_t* chn, uint32_t num_lanes, uint32_t max_block_size) {
+    SOKOL_ASSERT(chn && chn->valid && (0 == chn->lz4_buffers));
+    SOKOL_ASSERT((num_lanes > 0) && (max_block_size > 0));
+    chn->lz4_buffer_size = max_block_size + _SFETCH_LZ4_MAX_TRAILER_SIZE;
+    chn->lz4_buffers = (uint8_t*) _sfetch_malloc((size_t)num_lanes * chn->lz4_buffer_size);
+    return 0 != chn->lz4_buffers;
+}
+#endif
+
 /* put a request into the channels sent-queue, this is where all new requests
    are stored until a lane becomes free.
 */
@@ -2256,28 +4337,115 @@ _SOKOL_PRIVATE void _sfetch_invoke_response_callback(_sfetch_item_t* item) {
     response.user_data = item->user.user_data;
     response.fetched_offset = item->user.fetched_offset - item->user.fetched_size;
     response.fetched_size = item->user.fetched_size;
-    response.buffer_ptr = item->buffer.ptr;
-    response.buffer_size = item->buffer.size;
+    response.timing = item->user.timing;
+    #if !_SFETCH_PLATFORM_EMSCRIPTEN
+    if (item->memory_mapped) {
+        response.buffer_ptr = item->thread.mapping.ptr;
+        response.buffer_size = item->user.fetched_size;
+    }
+    else if (item->readahead) {
+        /* the buffer half which holds the fetched chunk */
+        response.buffer_ptr = item->buffer.ptr + item->user.fetched_buffer_offset;
+        response.buffer_size = item->buffer.size / 2;
+    }
+    else
+    #endif
+    {
+        response.buffer_ptr = item->buffer.ptr;
+        response.buffer_size = item->buffer.size;
+    }
     item->callback(&response);
 }
 
+/* remove the highest priority request from the sent-queue, the queue order is
+   preserved for requests with the same priority, cancelled requests go first
+   so that they don't wait for a lane only to be finished
+*/
+_SOKOL_PRIVATE uint32_t _sfetch_channel_dequeue_sent(_sfetch_channel_t* chn, _sfetch_pool_t* pool) {
+    const uint32_t num_sent = _sfetch_ring_count(&chn->user_sent);
+    SOKOL_ASSERT(num_sent > 0);
+    uint32_t best_index = 0;
+    const _sfetch_item_t* best_item = 0;
+    for (uint32_t i = 0; i < num_sent; i++) {
+        const _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, _sfetch_ring_peek(&chn->user_sent, i));
+        SOKOL_ASSERT(item);
+        if (item->user.cancel) {
+            best_index = i;
+            break;
+        }
+        if (!best_item || (item->priority > best_item->priority)) {
+            best_index = i;
+            best_item = item;
+        }
+    }
+    /* rotate the queue to remove the item and keep the order of the others */
+    uint32_t slot_id = 0;
+    for (uint32_t i = 0; i < num_sent; i++) {
+        const uint32_t id = _sfetch_ring_dequeue(&chn->user_sent);
+        if (i == best_index) {
+            slot_id = id;
+        }
+        else {
+            _sfetch_ring_enqueue(&chn->user_sent, id);
+        }
+    }
+    SOKOL_ASSERT(0 != slot_id);
+    return slot_id;
+}
+
+/* a streaming request with yield_lane gives up its lane between chunks if
+   more higher priority requests are waiting than there are free lanes
+*/
+_SOKOL_PRIVATE bool _sfetch_channel_should_yield(_sfetch_channel_t* chn, _sfetch_pool_t* pool, const _sfetch_item_t* item) {
+    if (!item->yield_lane || (item->state != _SFETCH_STATE_FETCHED) || item->user.pause || item->user.cancel) {
+        return false;
+    }
+    const uint32_t num_free_lanes = _sfetch_ring_count(&chn->free_lanes);
+    const uint32_t num_sent = _sfetch_ring_count(&chn->user_sent);
+    uint32_t num_waiting = 0;
+    for (uint32_t i = 0; i < num_sent; i++) {
+        const _sfetch_item_t* sent_item = _sfetch_pool_item_lookup(pool, _sfetch_ring_peek(&chn->user_sent, i));
+        SOKOL_ASSERT(sent_item);
+        if (sent_item->priority > item->priority) {
+            num_waiting++;
+        }
+    }
+    return num_waiting > num_free_lanes;
+}
+
 /* per-frame channel stuff: move requests in and out of the IO threads, call response callbacks */
 _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_t* pool) {
 
+    /* account the lane occupation since the last call */
+    _sfetch_stats_update_lanes(&chn->stats, chn->num_lanes - _sfetch_ring_count(&chn->free_lanes), _sfetch_now());
+
     /* move items from sent- to incoming-queue permitting free lanes */
     const uint32_t num_sent = _sfetch_ring_count(&chn->user_sent);
     const uint32_t avail_lanes = _sfetch_ring_count(&chn->free_lanes);
     const uint32_t num_move = (num_sent < avail_lanes) ? num_sent : avail_lanes;
     for (uint32_t i = 0; i < num_move; i++) {
-        const uint32_t slot_id = _sfetch_ring_dequeue(&chn->user_sent);
+        const uint32_t slot_id = _sfetch_channel_dequeue_sent(chn, pool);
         _sfetch_item_t* item = _sfetch_pool_item_lookup(pool, slot_id);
         SOKOL_ASSERT(item);
-        SOKOL_ASSERT(item->state == _SFETCH_STATE_ALLOCATED);
-        item->state = _SFETCH_STATE_DISPATCHED;
         item->lane = _sfetch_ring_dequeue(&chn->free_lanes);
-        /* if no buffer provided yet, invoke response callback to do so */
-        if (0 == item->buffer.ptr) {
-            _sfetch_invoke_response_callback(item);
+        #if _SFETCH_HAS_THREADS
+        /* LZ4 requests use the scratch buffer of their lane */
+        if (item->thread.lz4.enabled && chn->lz4_buffers) {
+            item->thread.lz4.scratch = chn->lz4_buffers + (size_t)item->lane * chn->lz4_buffer_size;
+            item->thread.lz4.scratch_size = chn->lz4_buffer_size;
+        }
+        #endif
+        if (item->state == _SFETCH_STATE_ALLOCATED) {
+            item->state = _SFETCH_STATE_DISPATCHED;
+            _sfetch_clear(&item->user.timing, sizeof(item->user.timing));
+            /* if no buffer provided yet, invoke response callback to do so */
+            if ((0 == item->buffer.ptr) && !item->memory_mapped) {
+                _sfetch_invoke_response_callback(item);
+            }
+        }
+        else {
+            /* a request which has yielded its lane continues where it stopped */
+            SOKOL_ASSERT(item->state == _SFETCH_STATE_FETCHED);
         }
         _sfetch_ring_enqueue(&chn->user_incoming, slot_id);
     }
@@ -2316,8 +4484,8 @@ _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_
 
     #if _SFETCH_HAS_THREADS
         /* move new items into the IO threads and processed items out of IO threads */
-        _sfetch_thread_enqueue_incoming(&chn->thread, &chn->thread_incoming, &chn->user_incoming);
-        _sfetch_thread_dequeue_outgoing(&chn->thread, &chn->thread_outgoing, &chn->user_outgoing);
+        _sfetch_thread_enqueue_incoming(&chn->thread, &chn->user_incoming);
+        _sfetch_thread_dequeue_outgoing(&chn->thread, &chn->user_outgoing);
     #else
         /* without threading just directly dequeue items from the user_incoming queue and
            call the request handler, the user_outgoing queue will be filled as the
@@ -2344,6 +4512,7 @@ _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_
         /* transfer output params from thread- to user-data */
         item->user.fetched_offset = item->thread.fetched_offset;
         item->user.fetched_size = item->thread.fetched_size;
+        item->user.fetched_buffer_offset = item->thread.fetched_buffer_offset;
         if (item->user.cancel) {
             item->user.error_code = SFETCH_ERROR_CANCELLED;
         }
@@ -2360,15 +4529,27 @@ _SOKOL_PRIVATE void _sfetch_channel_dowork(_sfetch_channel_t* chn, _sfetch_pool_
         else if (item->state == _SFETCH_STATE_FETCHING) {
             item->state = _SFETCH_STATE_FETCHED;
         }
+        _sfetch_stats_put(&chn->stats, item, _sfetch_now());
         _sfetch_invoke_response_callback(item);
+        /* the queue wait for the next IO operation starts after the callback */
+        item->user.queued_time = _sfetch_now();
 
         /* when the request is finish, free the lane for another request,
            otherwise feed it back into the incoming queue
         */
         if (item->user.finished) {
+            #if !_SFETCH_PLATFORM_EMSCRIPTEN
+            _sfetch_file_unmap(&item->thread.mapping);
+            #endif
             _sfetch_ring_enqueue(&chn->free_lanes, item->lane);
             _sfetch_pool_item_free(pool, slot_id);
         }
+        else if (_sfetch_channel_should_yield(chn, pool, item)) {
+            /* give the lane to a higher priority request, and wait for a lane again */
+            _sfetch_ring_enqueue(&chn->free_lanes, item->lane);
+            item->lane = _SFETCH_INVALID_LANE;
+            _sfetch_ring_enqueue(&chn->user_sent, slot_id);
+        }
         else {
             _sfetch_ring_enqueue(&chn->user_incoming, slot_id);
         }
@@ -2394,7 +4575,7 @@ _SOKOL_PRIVATE bool _sfetch_validate_request(_sfetch_t* ctx, const sfetch_reques
             SOKOL_LOG("_sfetch_validate_request: request.callback missing");
             return false;
         }
-        if (req->chunk_size > req->buffer_size) {
+        if (!req->memory_mapped && (req->chunk_size > req->buffer_size)) {
             SOKOL_LOG("_sfetch_validate_request: request.chunk_size is greater request.buffer_size)");
             return false;
         }
@@ -2410,6 +4591,30 @@ _SOKOL_PRIVATE bool _sfetch_validate_request(_sfetch_t* ctx, const sfetch_reques
             SOKOL_LOG("_sfetch_validate_request: request.user_data_size is too big (see SFETCH_MAX_USERDATA_UINT64");
             return false;
         }
+        if (req->lz4) {
+            if (req->memory_mapped) {
+                SOKOL_LOG("_sfetch_validate_request: request.lz4 and request.memory_mapped can't be combined");
+                return false;
+            }
+            if (req->offset > 0) {
+                SOKOL_LOG("_sfetch_validate_request: request.offset must be zero for LZ4 requests");
+                return false;
+            }
+        }
+        if (req->readahead) {
+            if (0 == req->chunk_size) {
+                SOKOL_LOG("_sfetch_validate_request: request.readahead requires a request.chunk_size");
+                return false;
+            }
+            if (req->memory_mapped || req->lz4) {
+                SOKOL_LOG("_sfetch_validate_request: request.readahead can't be combined with request.memory_mapped or request.lz4");
+                return false;
+            }
+            if (req->buffer_ptr && (req->buffer_size < 2 * (uint64_t)req->chunk_size)) {
+                SOKOL_LOG("_sfetch_validate_request: request.buffer_size must be at least 2 * request.chunk_size for readahead");
+                return false;
+            }
+        }
     #else
         /* silence unused warnings in release*/
         (void)(ctx && req);
@@ -2423,6 +4628,7 @@ _SOKOL_PRIVATE sfetch_desc_t _sfetch_desc_defaults(const sfetch_desc_t* desc) {
     res.max_requests = _sfetch_def(desc->max_requests, 128);
     res.num_channels = _sfetch_def(desc->num_channels, 1);
     res.num_lanes = _sfetch_def(desc->num_lanes, 1);
+    res.num_threads = _sfetch_def(desc->num_threads, 1);
     return res;
 }
 
@@ -2445,13 +4651,29 @@ SOKOL_API_IMPL void sfetch_setup(const sfetch_desc_t* desc_) {
         ctx->desc.num_channels = SFETCH_MAX_CHANNELS;
         SOKOL_LOG("sfetch_setup: clamping num_channels to SFETCH_MAX_CHANNELS");
     }
+    if (ctx->desc.num_threads > SFETCH_MAX_CHANNEL_THREADS) {
+        ctx->desc.num_threads = SFETCH_MAX_CHANNEL_THREADS;
+        SOKOL_LOG("sfetch_setup: clamping num_threads to SFETCH_MAX_CHANNEL_THREADS");
+    }
+    #if _SFETCH_HAS_THREADS
+    if (ctx->desc.max_lz4_block_size > _SFETCH_LZ4_MAX_BLOCK_SIZE) {
+        /* the LZ4 frame format has no bigger blocks */
+        ctx->desc.max_lz4_block_size = _SFETCH_LZ4_MAX_BLOCK_SIZE;
+        SOKOL_LOG("sfetch_setup: clamping max_lz4_block_size to 4 MB");
+    }
+    #endif
 
     /* setup the global request item pool */
     ctx->valid &= _sfetch_pool_init(&ctx->pool, ctx->desc.max_requests);
 
     /* setup IO channels (one thread per channel) */
     for (uint32_t i = 0; i < ctx->desc.num_channels; i++) {
-        ctx->valid &= _sfetch_channel_init(&ctx->chn[i], ctx, ctx->desc.max_requests, ctx->desc.num_lanes, _sfetch_request_handler);
+        ctx->valid &= _sfetch_channel_init(&ctx->chn[i], ctx, ctx->desc.max_requests, ctx->desc.num_lanes, ctx->desc.num_threads, _sfetch_request_handler);
+        #if _SFETCH_HAS_THREADS
+        if (ctx->chn[i].valid && (ctx->desc.max_lz4_block_size > 0)) {
+            ctx->valid &= _sfetch_channel_init_lz4(&ctx->chn[i], ctx->desc.num_lanes, ctx->desc.max_lz4_block_size);
+        }
+        #endif
     }
 }
 
@@ -2465,6 +4687,19 @@ SOKOL_API_IMPL void sfetch_shutdown(void) {
             _sfetch_channel_discard(&ctx->chn[i]);
         }
     }
+    #if !_SFETCH_PLATFORM_EMSCRIPTEN
+    /* release the memory mappings of requests which are still in flight */
+    if (ctx->pool.valid) {
+        for (uint32_t i = 1; i < ctx->pool.size; i++) {
+            _sfetch_file_unmap(&ctx->pool.items[i].thread.mapping);
+        }
+    }
+    #endif
+    #if _SFETCH_HAS_THREADS
+    for (uint32_t i = 0; i < ctx->num_packs; i++) {
+        _sfetch_pack_discard(&ctx->packs[i]);
+    }
+    #endif
     _sfetch_pool_discard(&ctx->pool);
     ctx->setup = false;
     _sfetch_free(ctx);
@@ -2512,12 +4747,27 @@ SOKOL_API_IMPL sfetch_handle_t sfetch_send(const sfetch_request_t* request) {
         return invalid_handle;
     }
     SOKOL_ASSERT(request->channel < ctx->desc.num_channels);
+    /* LZ4 requests need the per-lane scratch buffers, so this is also checked in release mode */
+    if (request->lz4) {
+        #if _SFETCH_PLATFORM_EMSCRIPTEN
+        SOKOL_LOG("sfetch_send: request.lz4 is not supported on the web platform");
+        return invalid_handle;
+        #else
+        if (0 == ctx->desc.max_lz4_block_size) {
+            SOKOL_LOG("sfetch_send: request.lz4 is set, but sfetch_desc_t.max_lz4_block_size is zero");
+            return invalid_handle;
+        }
+        #endif
+    }
 
     uint32_t slot_id = _sfetch_pool_item_alloc(&ctx->pool, request);
     if (0 == slot_id) {
         SOKOL_LOG("sfetch_send: request pool exhausted (too many active requests)");
         return invalid_handle;
     }
+    #if _SFETCH_HAS_THREADS
+    _sfetch_pack_resolve(ctx, _sfetch_pool_item_lookup(&ctx->pool, slot_id));
+    #endif
     if (!_sfetch_channel_send(&ctx->chn[request->channel], slot_id)) {
         /* send failed because the channels sent-queue overflowed */
         _sfetch_pool_item_free(&ctx->pool, slot_id);
@@ -2545,13 +4795,16 @@ SOKOL_API_IMPL void sfetch_dowork(void) {
     ctx->in_callback = false;
 }
 
-SOKOL_API_IMPL void sfetch_bind_buffer(sfetch_handle_t h, void* buffer_ptr, uint32_t buffer_size) {
+SOKOL_API_IMPL void sfetch_bind_buffer(sfetch_handle_t h, void* buffer_ptr, uint64_t buffer_size) {
     _sfetch_t* ctx = _sfetch_ctx();
     SOKOL_ASSERT(ctx && ctx->valid);
     SOKOL_ASSERT(ctx->in_callback);
     _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, h.id);
     if (item) {
         SOKOL_ASSERT((0 == item->buffer.ptr) && (0 == item->buffer.size));
+        /* with readahead, an IO thread may still be reading into the buffer */
+        SOKOL_ASSERT(!item->readahead || (item->state == _SFETCH_STATE_DISPATCHED) || item->user.finished);
+        SOKOL_ASSERT(!item->readahead || (buffer_size >= 2 * (uint64_t)item->chunk_size));
         item->buffer.ptr = (uint8_t*) buffer_ptr;
         item->buffer.size = buffer_size;
     }
@@ -2563,6 +4816,7 @@ SOKOL_API_IMPL void* sfetch_unbind_buffer(sfetch_handle_t h) {
     SOKOL_ASSERT(ctx->in_callback);
     _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, h.id);
     if (item) {
+        SOKOL_ASSERT(!item->readahead || (item->state == _SFETCH_STATE_DISPATCHED) || item->user.finished);
         void* prev_buf_ptr = item->buffer.ptr;
         item->buffer.ptr = 0;
         item->buffer.size = 0;
@@ -2604,5 +4858,72 @@ SOKOL_API_IMPL void sfetch_cancel(sfetch_handle_t h) {
     }
 }
 
-#endif /* SOKOL_FETCH_IMPL */
+SOKOL_API_IMPL void sfetch_set_priority(sfetch_handle_t h, int priority) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    _sfetch_item_t* item = _sfetch_pool_item_lookup(&ctx->pool, h.id);
+    if (item) {
+        item->priority = priority;
+    }
+}
+
+SOKOL_API_IMPL bool sfetch_mount(const char* pack_path) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    SOKOL_ASSERT(pack_path);
+    #if _SFETCH_HAS_THREADS
+    if (ctx->num_packs >= SFETCH_MAX_PACKS) {
+        SOKOL_LOG("sfetch_mount: too many pack files mounted (see SFETCH_MAX_PACKS)");
+        return false;
+    }
+    const _sfetch_path_t path = _sfetch_path_make(pack_path);
+    if (!_sfetch_pack_init(&ctx->packs[ctx->num_packs], &path)) {
+        return false;
+    }
+    ctx->num_packs++;
+    return true;
+    #else
+    _SOKOL_UNUSED(pack_path);
+    SOKOL_LOG("sfetch_mount: pack files are not supported on this platform");
+    return false;
+    #endif
+}
+
+SOKOL_API_IMPL sfetch_stats_t sfetch_query_stats(uint32_t channel) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    SOKOL_ASSERT(channel < ctx->desc.num_channels);
+    sfetch_stats_t res;
+    _sfetch_clear(&res, sizeof(res));
+    if (channel >= ctx->desc.num_channels) {
+        return res;
+    }
+    const _sfetch_channel_t* chn = &ctx->chn[channel];
+    const _sfetch_stats_t* stats = &chn->stats;
+    const uint64_t now = _sfetch_now();
+    res.num_queued = _sfetch_ring_count(&chn->user_sent);
+    res.num_in_flight = chn->num_lanes - _sfetch_ring_count(&chn->free_lanes);
+    res.num_lanes = chn->num_lanes;
+    /* include the lane occupation since the last sfetch_dowork() */
+    const uint64_t lane_time = stats->lane_time + res.num_in_flight * _sfetch_elapsed(stats->lane_update_time, now);
+    const uint64_t total_lane_time = chn->num_lanes * _sfetch_elapsed(stats->start_time, now);
+    res.lane_utilization = (total_lane_time > 0) ? ((double)lane_time / (double)total_lane_time) : 0.0;
+    res.num_bytes = stats->num_bytes;
+    res.num_completed = stats->num_completed;
+    res.num_failed = stats->num_failed;
+    res.queue_wait = _sfetch_latency_query(&stats->queue_wait);
+    res.io_time = _sfetch_latency_query(&stats->io_time);
+    res.callback_wait = _sfetch_latency_query(&stats->callback_wait);
+    return res;
+}
+
+SOKOL_API_IMPL void sfetch_reset_stats(void) {
+    _sfetch_t* ctx = _sfetch_ctx();
+    SOKOL_ASSERT(ctx && ctx->valid);
+    const uint64_t now = _sfetch_now();
+    for (uint32_t i = 0; i < ctx->desc.num_channels; i++) {
+        _sfetch_stats_reset(&ctx->chn[i].stats, now);
+    }
+}
 
+#endif /* SOKOL_FETCH_IMPL */
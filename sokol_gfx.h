@@ -132,6 +132,10 @@
         Read the section 'UNIFORM DATA LAYOUT' to learn about the expected memory layout
         of the uniform data passed into sg_apply_uniforms().
 
+        If the same uniform data is applied again to the same shader stage
+        and uniform block slot, and the shader hasn't changed since, the
+        redundant upload is skipped (see 'FRAME STATISTICS').
+
     --- kick off a draw call with:
 
             sg_draw(int base_element, int num_elements, int num_instances)
@@ -582,6 +586,53 @@
 
     https://github.com/floooh/sokol-samples/blob/master/glfw/multiwindow-glfw.c
 
+    WORKING WITH INSTANCES
+    ======================
+    Contexts (see above) share a single sokol-gfx state and must all be
+    driven from the same thread. If completely independent renderers
+    are needed in the same process (for instance multiple threads which
+    each render offscreen with their own GL context), use instances
+    instead. Each instance holds a complete sokol-gfx state (resource
+    pools, backend state, caches and per-frame data), and the
+    'current instance' is tracked per thread:
+
+    --- sg_instance sg_make_instance(const sg_instance_desc* desc)
+        Allocates a new, not yet initialized instance. The only
+        configuration option is an optional sg_allocator which is
+        used to allocate the instance itself (the resources inside
+        the instance are allocated through sg_desc.allocator as usual).
+
+    --- sg_instance sg_set_instance(sg_instance inst)
+        Makes an instance current on the calling thread, all following
+        sokol-gfx calls on this thread (including sg_setup() and
+        sg_shutdown()) work on that instance. Returns the previously
+        current instance. Pass a zero-initialized sg_instance to switch
+        back to the default instance, which is current on all threads
+        until sg_set_instance() is called.
+
+    --- void sg_destroy_instance(sg_instance inst)
+        Frees an instance. The instance must have been shut down with
+        sg_shutdown() and must not be current on any thread.
+
+    A typical render worker thread looks like this:
+
+        sg_instance inst = sg_make_instance(&(sg_instance_desc){0});
+        sg_set_instance(inst);
+        // ...create and activate a GL context for this thread...
+        sg_setup(&(sg_desc){ ... });
+        // ...render...
+        sg_shutdown();
+        sg_set_instance((sg_instance){0});
+        sg_destroy_instance(inst);
+
+    An instance may be moved to another thread as long as it isn't
+    current on two threads at the same time. Resource handles are only
+    valid in the instance which created them.
+
+    NOTE: on Windows with the built-in GL loader, the GL function pointers
+    are process-wide, so the first sg_setup() call should have returned
+    before other threads call sg_setup() on their own instances.
+
     TRACE HOOKS:
     ============
     sokol_gfx.h optionally allows to install "trace hook" callbacks for
@@ -611,6 +662,119 @@
     imgui/sokol_gfx_imgui.h header which implements a realtime
     debugging UI for sokol_gfx.h on top of Dear ImGui.
 
+    PASS TIMING:
+    ============
+    sokol_gfx.h can optionally measure how long each render pass and
+    each debug group takes to execute. On the GL backend (GLCORE33 only)
+    this is implemented with GL_TIMESTAMP queries, on the dummy backend
+    the CPU time between the begin and end calls is measured. On all
+    other backends, the feature isn't implemented yet (check
+    sg_query_features().pass_timing).
+
+    --- Enable pass timing in sg_setup():
+
+            sg_setup(&(sg_desc){
+                .pass_timing = true,
+                ...
+            });
+
+    --- Each sg_begin_pass()/sg_end_pass() pair and each sg_push_debug_group()/
+        sg_pop_debug_group() pair creates a 'timing scope'. Passes are
+        identified by the sg_pass_desc.label string (the default pass
+        is called "default", an offscreen pass without label is called
+        "pass"), debug groups by the name passed to sg_push_debug_group().
+        Debug groups may be pushed both inside and outside of passes
+        and can be nested. At most SG_MAX_TIMING_SCOPES scopes are recorded
+        per frame, names are truncated to SG_TIMING_NAME_SIZE-1 characters.
+
+    --- The timing results are not available immediately, instead they
+        are picked up in sg_commit() a few frames later when the GPU has
+        finished rendering the frame (sokol_gfx.h will never wait for
+        query results). If the GPU falls too far behind, the timing
+        results for a frame are silently dropped.
+
+    --- Call sg_query_frame_timings() to get the timing results of the
+        most recent frame which has been resolved, the returned
+        sg_frame_timings struct contains the frame index of the recorded
+        frame and an array of sg_timing_scope items in the order the
+        scopes were started:
+
+            const sg_frame_timings timings = sg_query_frame_timings();
+            for (int i = 0; i < timings.num_scopes; i++) {
+                const sg_timing_scope* scope = &timings.scopes[i];
+                printf("%*s%s: %.3f ms\n", scope->depth*2, "", scope->name, scope->duration_ms);
+            }
+
+    --- ...or call sg_query_timing() to lookup the time of a pass or
+        debug group by name (if the same name shows up multiple times
+        in a frame, the durations are added up). The function returns
+        a negative value if no scope with that name exists in the most
+        recently resolved frame:
+
+            const double shadow_ms = sg_query_timing("shadow");
+
+    FRAME STATISTICS:
+    =================
+    Call sg_query_frame_stats() to get a few counters which have been
+    recorded in the previous frame (between the last two calls to sg_commit()).
+
+    Currently this only contains counters about sg_apply_uniforms() calls:
+
+        .uniforms.num_apply         number of sg_apply_uniforms() calls
+        .uniforms.num_skipped       number of calls where the upload was skipped
+        .uniforms.size_apply        number of bytes passed into sg_apply_uniforms()
+        .uniforms.size_skipped      number of bytes which didn't need to be uploaded
+
+    sokol_gfx.h remembers the content of the most recently applied uniform
+    block for each shader stage and uniform block slot (up to 4 KBytes,
+    bigger blocks are always uploaded), and skips the upload to the 3D
+    backend if the same data is applied again while the shader is still
+    the same. The remembered content is forgotten when a
+    pipeline with a different shader is applied, at the start of a
+    render pass, and in sg_reset_state_cache().
+
+    READING BACK IMAGE CONTENT:
+    ===========================
+    The pixel content of render target images can be read back into
+    CPU memory with sg_read_image_async(). The function doesn't wait
+    for the GPU, instead the result is delivered through a callback
+    which is invoked from inside sg_commit() a frame or two later:
+
+        static void read_done(const sg_read_image_result* res) {
+            if (res->success) {
+                // res->data.ptr now contains res->data.size bytes of pixel data
+            }
+        }
+        ...
+        sg_read_image_async(img, &(sg_rect){ .x=0, .y=0, .width=w, .height=h },
+            &(sg_range){ .ptr=buffer, .size=buffer_size }, read_done, user_data);
+
+    Some rules and restrictions:
+
+    --- The image must be a 2D render target image with a color pixel format,
+        MSAA render targets are supported (the resolved pixels will be read).
+    --- sg_read_image_async() must be called outside of a render pass.
+    --- The pixels are written in the image's pixel format, rows are tightly
+        packed (the row pitch is rect.width * bytes-per-pixel), the destination
+        buffer must be big enough for rect.width * rect.height pixels and must
+        remain valid until the callback has been called.
+    --- The rectangle and the row order use the 3D backend's native coordinate
+        system, on GL the origin is at the bottom left (see
+        sg_features.origin_top_left).
+    --- At most SG_MAX_IMAGE_READS reads can be in flight at the same time, if
+        no slot is free, or the backend doesn't support image readback (see
+        sg_features.image_readback), sg_read_image_async() returns false and
+        the callback will not be called. Otherwise the callback is guaranteed
+        to be called exactly once, if the read is still in flight when
+        sg_shutdown() is called, the callback is invoked from inside
+        sg_shutdown() with the success flag set to false.
+
+    On GL (GLCORE33 and GLES3), the pixels are copied into a pixel pack buffer
+    on the GPU, and a fence is used to check (without blocking) whether the
+    copy has finished. The dummy backend fills the buffer with zeroes (the
+    dummy backend doesn't keep image content around). Image readback isn't
+    implemented yet for the GLES2, D3D11, Metal and WebGPU backends.
+
     A NOTE ON PORTABLE PACKED VERTEX FORMATS:
     =========================================
     There are two things to consider when using packed
@@ -768,6 +932,12 @@ typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
 typedef struct sg_context  { uint32_t id; } sg_context;
 
+/*
+    sg_instance is an opaque handle to a complete sokol-gfx state,
+    see the section WORKING WITH INSTANCES in the documentation header
+*/
+typedef struct sg_instance { void* ptr; } sg_instance;
+
 /*
     sg_range is a pointer-size-pair struct used to pass memory blobs into
     sokol-gfx. When initialized from a value type (array or struct), you can
@@ -780,6 +950,13 @@ typedef struct sg_range {
     size_t size;
 } sg_range;
 
+/*
+    sg_rect describes a rectangular area in pixels, used by sg_read_image_async()
+*/
+typedef struct sg_rect {
+    int x, y, width, height;
+} sg_rect;
+
 // disabling this for every includer isn't great, but the warnings are also quite pointless
 #if defined(_MSC_VER)
 #pragma warning(disable:4221)   /* /W4 only: nonstandard extension used: 'x': cannot be initialized using address of automatic variable 'y' */
@@ -805,7 +982,10 @@ enum {
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,      /* NOTE: actual max vertex attrs can be less on GLES2, see sg_limits! */
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_TIMING_SCOPES = 32,
+    SG_TIMING_NAME_SIZE = 32,
+    SG_MAX_IMAGE_READS = 8
 };
 
 /*
@@ -993,6 +1173,8 @@ typedef struct sg_features {
     bool image_clamp_to_border;         // border color and clamp-to-border UV-wrap mode is supported
     bool mrt_independent_blend_state;   // multiple-render-target rendering can use per-render-target blend state
     bool mrt_independent_write_mask;    // multiple-render-target rendering can use per-render-target color write masks
+    bool pass_timing;                   // pass- and debug-group timing via sg_desc.pass_timing is supported
+    bool image_readback;                // sg_read_image_async() is supported
     #if defined(SOKOL_ZIG_BINDINGS)
     uint32_t __pad[3];
     #endif
@@ -1823,6 +2005,32 @@ typedef struct sg_image_data {
     Images with usage SG_USAGE_IMMUTABLE must be fully initialized by
     providing a valid .data member which points to initialization data.
 
+    ADVANCED TOPIC: Asynchronous texture streaming on GL:
+
+    When .gl_pbo_streaming is true for an SG_USAGE_DYNAMIC or SG_USAGE_STREAM
+    image (which isn't a render target), the GL backend (GLCORE33 and GLES3)
+    allocates two pixel unpack buffers for the image which are used in turns
+    for uploading new image content. sg_update_image() then copies the data
+    into a mapped pixel unpack buffer, and the actual texture upload
+    happens asynchronously from the pixel unpack buffer on the GPU side.
+    This is useful for large textures which are updated each frame (for
+    instance video frames).
+
+    To avoid the extra copy, the pixel data can also be written directly
+    into the mapped buffer:
+
+        const sg_range dst = sg_map_image(img);
+        if (dst.ptr) {
+            // ...write dst.size bytes of pixel data to dst.ptr...
+            sg_unmap_image(img);
+        }
+
+    The mapped buffer has the same layout as an sg_image_data struct with
+    all subimages tightly packed one after another, in face-major and
+    mip-minor order. A map/unmap pair counts as an image update (only one
+    update per frame is allowed). sg_map_image() returns an empty range
+    for images without .gl_pbo_streaming, and on backends other than GL.
+
     ADVANCED TOPIC: Injecting native 3D-API textures:
 
     The following struct members allow to inject your own GL, Metal or D3D11
@@ -1868,6 +2076,7 @@ typedef struct sg_image_desc {
     sg_image_data data;
     const char* label;
     /* GL specific */
+    bool gl_pbo_streaming;
     uint32_t gl_textures[SG_NUM_INFLIGHT_FRAMES];
     uint32_t gl_texture_target;
     /* Metal specific */
@@ -2172,6 +2381,9 @@ typedef struct sg_trace_hooks {
     void (*destroy_pass)(sg_pass pass, void* user_data);
     void (*update_buffer)(sg_buffer buf, const sg_range* data, void* user_data);
     void (*update_image)(sg_image img, const sg_image_data* data, void* user_data);
+    void (*map_image)(sg_image img, sg_range result, void* user_data);
+    void (*unmap_image)(sg_image img, void* user_data);
+    void (*read_image_async)(sg_image img, const sg_rect* rect, const sg_range* buffer, bool result, void* user_data);
     void (*append_buffer)(sg_buffer buf, const sg_range* data, int result, void* user_data);
     void (*begin_default_pass)(const sg_pass_action* pass_action, int width, int height, void* user_data);
     void (*begin_pass)(sg_pass pass, const sg_pass_action* pass_action, void* user_data);
@@ -2279,6 +2491,65 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+/*
+    sg_timing_scope, sg_frame_timings
+
+    The result of the optional pass timing, returned by
+    sg_query_frame_timings(). See the section PASS TIMING in the
+    documentation header for details.
+*/
+typedef struct sg_timing_scope {
+    char name[SG_TIMING_NAME_SIZE];     /* pass label or debug group name */
+    bool is_pass;                       /* true if this is a pass, false for debug groups */
+    int depth;                          /* nesting depth (0 for top-level scopes) */
+    double duration_ms;                 /* measured duration in milliseconds */
+} sg_timing_scope;
+
+typedef struct sg_frame_timings {
+    bool valid;                         /* true if timing results are available */
+    uint32_t frame_index;               /* the frame index the results were recorded in */
+    int num_scopes;
+    sg_timing_scope scopes[SG_MAX_TIMING_SCOPES];
+} sg_frame_timings;
+
+/*
+    sg_frame_stats
+
+    Per-frame counters returned by sg_query_frame_stats(), see the
+    section FRAME STATISTICS in the documentation header.
+*/
+typedef struct sg_frame_stats_apply_uniforms {
+    uint32_t num_apply;                 /* number of sg_apply_uniforms() calls */
+    uint32_t num_skipped;               /* number of calls skipped because the data was unchanged */
+    uint64_t size_apply;                /* number of bytes passed into sg_apply_uniforms() */
+    uint64_t size_skipped;              /* number of bytes which didn't need to be uploaded */
+} sg_frame_stats_apply_uniforms;
+
+typedef struct sg_frame_stats {
+    uint32_t frame_index;               /* the frame index the counters were recorded in */
+    sg_frame_stats_apply_uniforms uniforms;
+} sg_frame_stats;
+
+/*
+    sg_read_image_result, sg_read_image_callback
+
+    Passed into the callback function of sg_read_image_async() when
+    the pixel data has arrived (see the section READING BACK IMAGE
+    CONTENT in the documentation header).
+*/
+typedef struct sg_read_image_result {
+    bool success;                       /* false if the read was dropped in sg_shutdown() */
+    sg_image image;
+    sg_rect rect;
+    sg_pixel_format pixel_format;
+    int row_pitch;                      /* byte distance between rows (rect.width * bytes-per-pixel) */
+    sg_range data;                      /* the destination buffer, size is the number of bytes written */
+    uint32_t frame_index;               /* the frame index in which sg_read_image_async() was called */
+    void* user_data;
+} sg_read_image_result;
+
+typedef void (*sg_read_image_callback)(const sg_read_image_result* result);
+
 /*
     sg_desc
 
@@ -2303,6 +2574,7 @@ typedef struct sg_pass_info {
     .sampler_cache_size     64
     .uniform_buffer_size    4 MB (4*1024*1024)
     .staging_buffer_size    8 MB (8*1024*1024)
+    .pass_timing            false (see the PASS TIMING section in the header documentation)
 
     .allocator.alloc        0 (in this case, malloc() will be called)
     .allocator.free         0 (in this case, free() will be called)
@@ -2452,6 +2724,16 @@ typedef struct sg_allocator {
     void* user_data;
 } sg_allocator;
 
+/*
+    sg_instance_desc
+
+    Used in sg_make_instance(), the optional allocator is used to
+    allocate and free the instance itself.
+*/
+typedef struct sg_instance_desc {
+    sg_allocator allocator;
+} sg_instance_desc;
+
 typedef struct sg_desc {
     uint32_t _start_canary;
     int buffer_pool_size;
@@ -2463,6 +2745,7 @@ typedef struct sg_desc {
     int uniform_buffer_size;
     int staging_buffer_size;
     int sampler_cache_size;
+    bool pass_timing;
     sg_allocator allocator;
     sg_context_desc context;
     uint32_t _end_canary;
@@ -2490,9 +2773,12 @@ SOKOL_GFX_API_DECL void sg_destroy_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_destroy_pass(sg_pass pass);
 SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_data* data);
+SOKOL_GFX_API_DECL sg_range sg_map_image(sg_image img);
+SOKOL_GFX_API_DECL void sg_unmap_image(sg_image img);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL bool sg_query_buffer_overflow(sg_buffer buf);
 SOKOL_GFX_API_DECL bool sg_query_buffer_will_overflow(sg_buffer buf, size_t size);
+SOKOL_GFX_API_DECL bool sg_read_image_async(sg_image img, const sg_rect* rect, const sg_range* buffer, sg_read_image_callback callback, void* user_data);
 
 /* rendering functions */
 SOKOL_GFX_API_DECL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height);
@@ -2515,6 +2801,11 @@ SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
 SOKOL_GFX_API_DECL sg_features sg_query_features(void);
 SOKOL_GFX_API_DECL sg_limits sg_query_limits(void);
 SOKOL_GFX_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
+/* get optional pass- and debug-group timings (see sg_desc.pass_timing) */
+SOKOL_GFX_API_DECL sg_frame_timings sg_query_frame_timings(void);
+SOKOL_GFX_API_DECL double sg_query_timing(const char* name);
+/* get counters recorded in the previous frame */
+SOKOL_GFX_API_DECL sg_frame_stats sg_query_frame_stats(void);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_GFX_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_image_state(sg_image img);
@@ -2566,6 +2857,11 @@ SOKOL_GFX_API_DECL sg_context sg_setup_context(void);
 SOKOL_GFX_API_DECL void sg_activate_context(sg_context ctx_id);
 SOKOL_GFX_API_DECL void sg_discard_context(sg_context ctx_id);
 
+/* independent sokol-gfx instances (optional) */
+SOKOL_GFX_API_DECL sg_instance sg_make_instance(const sg_instance_desc* desc);
+SOKOL_GFX_API_DECL void sg_destroy_instance(sg_instance inst);
+SOKOL_GFX_API_DECL sg_instance sg_set_instance(sg_instance inst);
+
 /* Backend-specific helper functions, these may come in handy for mixing
    sokol-gfx rendering with 'native backend' rendering functions.
 
@@ -3113,6 +3409,51 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_DEPTH24_STENCIL8
     #define GL_DEPTH24_STENCIL8 0x88F0
     #endif
+    #ifndef GL_TIMESTAMP
+    #define GL_TIMESTAMP 0x8E28
+    #endif
+    #ifndef GL_PIXEL_PACK_BUFFER
+    #define GL_PIXEL_PACK_BUFFER 0x88EB
+    #endif
+    #ifndef GL_PIXEL_UNPACK_BUFFER
+    #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+    #endif
+    #ifndef GL_STREAM_DRAW
+    #define GL_STREAM_DRAW 0x88E0
+    #endif
+    #ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+    #endif
+    #ifndef GL_STREAM_READ
+    #define GL_STREAM_READ 0x88E1
+    #endif
+    #ifndef GL_PACK_ALIGNMENT
+    #define GL_PACK_ALIGNMENT 0x0D05
+    #endif
+    #ifndef GL_MAP_READ_BIT
+    #define GL_MAP_READ_BIT 0x0001
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_ALREADY_SIGNALED
+    #define GL_ALREADY_SIGNALED 0x911A
+    #endif
+    #ifndef GL_CONDITION_SATISFIED
+    #define GL_CONDITION_SATISFIED 0x911C
+    #endif
+    #ifndef GL_QUERY_RESULT
+    #define GL_QUERY_RESULT 0x8866
+    #endif
+    #ifndef GL_QUERY_RESULT_AVAILABLE
+    #define GL_QUERY_RESULT_AVAILABLE 0x8867
+    #endif
     #ifndef GL_HALF_FLOAT
     #define GL_HALF_FLOAT 0x140B
     #endif
@@ -3144,6 +3485,8 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define _SOKOL_GL_INSTANCING_ENABLED
     #endif
     #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
+#elif defined(SOKOL_DUMMY_BACKEND)
+    #include <time.h>   // clock_gettime() or timespec_get() for CPU-side pass timing
 #endif
 
 /*=== COMMON BACKEND STUFF ===================================================*/
@@ -3170,6 +3513,10 @@ enum {
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
+    _SG_TIMING_NUM_FRAMES = 4,      // number of frames in flight for pass timing
+    _SG_TIMING_MAX_QUERIES = 2 * SG_MAX_TIMING_SCOPES,
+    _SG_NUM_UPLOAD_BUFFERS = 2,     // size of the per-image pixel unpack buffer ring on GL
+    _SG_UB_CACHE_MAX_COPY_SIZE = 4 * 1024,  // uniform blocks up to this size are remembered, bigger ones are always uploaded
 };
 
 /* fixed-size string */
@@ -3348,9 +3695,22 @@ typedef struct {
     int num_color_atts;
     _sg_pass_attachment_common_t color_atts[SG_MAX_COLOR_ATTACHMENTS];
     _sg_pass_attachment_common_t ds_att;
+    char label[SG_TIMING_NAME_SIZE];
 } _sg_pass_common_t;
 
+/* copy a string into a fixed-size timing scope name, truncate if needed */
+_SOKOL_PRIVATE void _sg_timing_copy_name(char* dst, const char* src) {
+    int i = 0;
+    if (src) {
+        for (; (i < (SG_TIMING_NAME_SIZE - 1)) && src[i]; i++) {
+            dst[i] = src[i];
+        }
+    }
+    dst[i] = 0;
+}
+
 _SOKOL_PRIVATE void _sg_pass_common_init(_sg_pass_common_t* cmn, const sg_pass_desc* desc) {
+    _sg_timing_copy_name(cmn->label, desc->label ? desc->label : "pass");
     const sg_pass_attachment_desc* att_desc;
     _sg_pass_attachment_common_t* att;
     for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
@@ -3538,6 +3898,10 @@ typedef struct {
         GLuint msaa_render_buffer;
         GLuint tex[SG_NUM_INFLIGHT_FRAMES];
         bool ext_textures;  /* if true, external textures were injected with sg_image_desc.gl_textures */
+        GLuint upload_pbo[_SG_NUM_UPLOAD_BUFFERS];  /* only if sg_image_desc.gl_pbo_streaming */
+        int cur_upload_pbo;
+        int upload_size;
+        bool mapped;
     } gl;
 } _sg_gl_image_t;
 typedef _sg_gl_image_t _sg_image_t;
@@ -3588,12 +3952,35 @@ typedef struct {
     GLenum type;
 } _sg_gl_attr_t;
 
+/* render state groups which are compared as packed keys in _sg_gl_apply_pipeline() */
+enum {
+    _SG_GL_STATEGROUP_DEPTH         = (1<<0),
+    _SG_GL_STATEGROUP_DEPTH_BIAS    = (1<<1),
+    _SG_GL_STATEGROUP_STENCIL       = (1<<2),
+    _SG_GL_STATEGROUP_BLEND         = (1<<3),
+    _SG_GL_STATEGROUP_BLEND_COLOR   = (1<<4),
+    _SG_GL_STATEGROUP_COLOR_MASK    = (1<<5),
+    _SG_GL_STATEGROUP_RASTER        = (1<<6),
+    _SG_GL_STATEGROUP_ALL           = 0x7F,
+};
+
+typedef struct {
+    uint64_t depth;
+    uint64_t depth_bias;
+    uint64_t stencil;
+    uint64_t blend;
+    uint64_t blend_color[2];
+    uint64_t color_mask;
+    uint64_t raster;
+} _sg_gl_state_keys_t;
+
 typedef struct {
     _sg_slot_t slot;
     _sg_pipeline_common_t cmn;
     _sg_shader_t* shader;
     struct {
         _sg_gl_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+        _sg_gl_state_keys_t state_keys;
         sg_depth_state depth;
         sg_stencil_state stencil;
         sg_primitive_type primitive_type;
@@ -3668,6 +4055,8 @@ typedef struct {
     GLenum cur_active_texture;
     _sg_pipeline_t* cur_pipeline;
     sg_pipeline cur_pipeline_id;
+    _sg_gl_state_keys_t state_keys;     /* state keys of the most recently applied pipeline */
+    uint32_t dirty_state_groups;        /* _SG_GL_STATEGROUP_* bits which must be checked field by field */
 } _sg_gl_state_cache_t;
 
 typedef struct {
@@ -3683,6 +4072,16 @@ typedef struct {
     bool ext_anisotropic;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
+    bool timer_queries_valid;
+    GLuint timer_queries[_SG_TIMING_NUM_FRAMES][_SG_TIMING_MAX_QUERIES];
+    #if !defined(SOKOL_GLES2)
+    GLuint readback_fb;
+    struct {
+        GLuint pbo;
+        GLsizeiptr pbo_size;
+        GLsync fence;
+    } image_reads[SG_MAX_IMAGE_READS];
+    #endif
     #if _SOKOL_USE_WIN32_GL_LOADER
     HINSTANCE opengl32_dll;
     #endif
@@ -4235,9 +4634,74 @@ typedef enum {
     /* sg_update_image validation */
     _SG_VALIDATE_UPDIMG_USAGE,
     _SG_VALIDATE_UPDIMG_NOTENOUGHDATA,
-    _SG_VALIDATE_UPDIMG_ONCE
+    _SG_VALIDATE_UPDIMG_ONCE,
+
+    /* sg_map_image validation */
+    _SG_VALIDATE_MAPIMG_USAGE,
+    _SG_VALIDATE_MAPIMG_ONCE,
+
+    /* sg_read_image_async validation */
+    _SG_VALIDATE_READIMG_IN_PASS,
+    _SG_VALIDATE_READIMG_RT,
+    _SG_VALIDATE_READIMG_TYPE,
+    _SG_VALIDATE_READIMG_FORMAT,
+    _SG_VALIDATE_READIMG_RECT,
+    _SG_VALIDATE_READIMG_BUFFER,
+    _SG_VALIDATE_READIMG_CALLBACK
 } _sg_validate_error_t;
 
+/*=== PASS TIMING DECLARATIONS ===============================================*/
+typedef struct {
+    char name[SG_TIMING_NAME_SIZE];
+    bool is_pass;
+    int depth;
+    int begin_query;
+    int end_query;
+} _sg_timing_scope_t;
+
+/* the timing scopes and timestamp query results of one frame */
+typedef struct {
+    bool pending;
+    uint32_t frame_index;
+    int num_scopes;
+    int num_queries;
+    _sg_timing_scope_t scopes[SG_MAX_TIMING_SCOPES];
+    uint64_t timestamps[_SG_TIMING_MAX_QUERIES];    /* in nanoseconds */
+} _sg_timing_frame_t;
+
+typedef struct {
+    int scope_index;    /* -1 if the scope didn't fit into the frame's scope array */
+    bool is_pass;
+} _sg_timing_stack_item_t;
+
+typedef struct {
+    bool enabled;
+    int cur_frame;
+    int stack_depth;
+    _sg_timing_stack_item_t stack[SG_MAX_TIMING_SCOPES];
+    _sg_timing_frame_t frames[_SG_TIMING_NUM_FRAMES];
+    sg_frame_timings resolved;
+} _sg_timing_t;
+
+/*=== UNIFORM BLOCK CACHE DECLARATIONS ======================================*/
+typedef struct {
+    size_t size;        /* 0 if the slot content is unknown */
+    uint8_t data[_SG_UB_CACHE_MAX_COPY_SIZE];
+} _sg_ub_cache_slot_t;
+
+typedef struct {
+    uint32_t shader_id;
+    _sg_ub_cache_slot_t slots[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+} _sg_ub_cache_t;
+
+/*=== IMAGE READBACK DECLARATIONS ============================================*/
+typedef struct {
+    bool active;
+    uint64_t seq;       /* to invoke the callbacks in the order of the sg_read_image_async() calls */
+    sg_read_image_callback callback;
+    sg_read_image_result result;
+} _sg_image_read_t;
+
 /*=== GENERIC BACKEND STATE ==================================================*/
 
 typedef struct {
@@ -4258,6 +4722,12 @@ typedef struct {
     sg_features features;
     sg_limits limits;
     sg_pixelformat_info formats[_SG_PIXELFORMAT_NUM];
+    _sg_timing_t timing;
+    _sg_ub_cache_t ub_cache;
+    sg_frame_stats cur_stats;
+    sg_frame_stats prev_stats;
+    uint64_t image_read_seq;
+    _sg_image_read_t image_reads[SG_MAX_IMAGE_READS];
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_backend_t gl;
     #elif defined(SOKOL_METAL)
@@ -4271,7 +4741,24 @@ typedef struct {
     sg_trace_hooks hooks;
     #endif
 } _sg_state_t;
-static _sg_state_t _sg;
+
+/* an instance created with sg_make_instance() */
+typedef struct {
+    _sg_state_t state;      /* must be first */
+    sg_allocator allocator;
+} _sg_instance_t;
+
+/* the current instance is tracked per thread, all threads start with the default instance */
+#if defined(__cplusplus)
+    #define _SG_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+    #define _SG_THREAD_LOCAL __declspec(thread)
+#else
+    #define _SG_THREAD_LOCAL __thread
+#endif
+static _sg_state_t _sg_default_state;
+static _SG_THREAD_LOCAL _sg_state_t* _sg_state_ptr = &_sg_default_state;
+#define _sg (*_sg_state_ptr)
 
 /*-- helper functions --------------------------------------------------------*/
 
@@ -4291,11 +4778,11 @@ _SOKOL_PRIVATE void _sg_clear(void* ptr, size_t size) {
     memset(ptr, 0, size);
 }
 
-_SOKOL_PRIVATE void* _sg_malloc(size_t size) {
+_SOKOL_PRIVATE void* _sg_malloc_with_allocator(const sg_allocator* allocator, size_t size) {
     SOKOL_ASSERT(size > 0);
     void* ptr;
-    if (_sg.desc.allocator.alloc) {
-        ptr = _sg.desc.allocator.alloc(size, _sg.desc.allocator.user_data);
+    if (allocator->alloc) {
+        ptr = allocator->alloc(size, allocator->user_data);
     }
     else {
         ptr = malloc(size);
@@ -4304,21 +4791,29 @@ _SOKOL_PRIVATE void* _sg_malloc(size_t size) {
     return ptr;
 }
 
+_SOKOL_PRIVATE void* _sg_malloc(size_t size) {
+    return _sg_malloc_with_allocator(&_sg.desc.allocator, size);
+}
+
 _SOKOL_PRIVATE void* _sg_malloc_clear(size_t size) {
     void* ptr = _sg_malloc(size);
     _sg_clear(ptr, size);
     return ptr;
 }
 
-_SOKOL_PRIVATE void _sg_free(void* ptr) {
-    if (_sg.desc.allocator.free) {
-        _sg.desc.allocator.free(ptr, _sg.desc.allocator.user_data);
+_SOKOL_PRIVATE void _sg_free_with_allocator(const sg_allocator* allocator, void* ptr) {
+    if (allocator->free) {
+        allocator->free(ptr, allocator->user_data);
     }
     else {
         free(ptr);
     }
 }
 
+_SOKOL_PRIVATE void _sg_free(void* ptr) {
+    _sg_free_with_allocator(&_sg.desc.allocator, ptr);
+}
+
 _SOKOL_PRIVATE bool _sg_strempty(const _sg_str_t* str) {
     return 0 == str->buf[0];
 }
@@ -4779,6 +5274,8 @@ _SOKOL_PRIVATE void _sg_dummy_setup_backend(const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     _SOKOL_UNUSED(desc);
     _sg.backend = SG_BACKEND_DUMMY;
+    _sg.features.pass_timing = true;
+    _sg.features.image_readback = true;
     for (int i = SG_PIXELFORMAT_R8; i < SG_PIXELFORMAT_BC1_RGBA; i++) {
         _sg.formats[i].sample = true;
         _sg.formats[i].filter = true;
@@ -4927,6 +5424,53 @@ _SOKOL_PRIVATE void _sg_dummy_commit(void) {
     /* empty */
 }
 
+/* the dummy backend measures CPU time between the begin and end of a timing scope */
+_SOKOL_PRIVATE uint64_t _sg_dummy_now_ns(void) {
+    struct timespec ts;
+    #if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+    #else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    #endif
+    return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_write_timestamp(int frame_slot, int query_index) {
+    SOKOL_ASSERT((frame_slot >= 0) && (frame_slot < _SG_TIMING_NUM_FRAMES));
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_TIMING_MAX_QUERIES));
+    _sg.timing.frames[frame_slot].timestamps[query_index] = _sg_dummy_now_ns();
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_resolve_timestamps(int frame_slot, int num_queries) {
+    /* timestamps have already been written directly in _sg_dummy_write_timestamp() */
+    _SOKOL_UNUSED(frame_slot);
+    _SOKOL_UNUSED(num_queries);
+    return true;
+}
+
+/* the dummy backend has no image content, the destination buffer is directly cleared to zero */
+_SOKOL_PRIVATE bool _sg_dummy_read_image(int read_index, const _sg_image_t* img, const sg_rect* rect, void* dst, size_t num_bytes) {
+    SOKOL_ASSERT(img && rect && dst && (num_bytes > 0));
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(rect);
+    memset(dst, 0, num_bytes);
+    return true;
+}
+
+_SOKOL_PRIVATE bool _sg_dummy_poll_read_image(int read_index, void* dst, size_t num_bytes, bool* out_success) {
+    SOKOL_ASSERT(out_success);
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(dst);
+    _SOKOL_UNUSED(num_bytes);
+    *out_success = true;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_dummy_discard_read_image(int read_index) {
+    _SOKOL_UNUSED(read_index);
+}
+
 _SOKOL_PRIVATE void _sg_dummy_apply_viewport(int x, int y, int w, int h, bool origin_top_left) {
     _SOKOL_UNUSED(x);
     _SOKOL_UNUSED(y);
@@ -5114,7 +5658,18 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glTexImage2D,                      void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
-    _SG_XMACRO(glCullFace,                        void, (GLenum mode))
+    _SG_XMACRO(glCullFace,                        void, (GLenum mode)) \
+    _SG_XMACRO(glGenQueries,                      void, (GLsizei n, GLuint * ids)) \
+    _SG_XMACRO(glDeleteQueries,                   void, (GLsizei n, const GLuint * ids)) \
+    _SG_XMACRO(glQueryCounter,                    void, (GLuint id, GLenum target)) \
+    _SG_XMACRO(glGetQueryObjectiv,                void, (GLuint id, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glGetQueryObjectui64v,             void, (GLuint id, GLenum pname, GLuint64 * params)) \
+    _SG_XMACRO(glPixelStorei,                     void, (GLenum pname, GLint param)) \
+    _SG_XMACRO(glMapBufferRange,                  void *, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    _SG_XMACRO(glUnmapBuffer,                     GLboolean, (GLenum target)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
@@ -5910,6 +6465,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.pass_timing = true;
+    _sg.features.image_readback = true;
 
     /* scan extensions */
     bool has_s3tc = false;  /* BC1..BC3 */
@@ -5977,6 +6534,7 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
 #if defined(SOKOL_GLES3)
 _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     _sg.backend = SG_BACKEND_GLES3;
+    _sg.features.image_readback = true;
 
     _sg.features.origin_top_left = false;
     _sg.features.instancing = true;
@@ -6351,6 +6909,7 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
         }
         #endif
         _sg_clear(&_sg.gl.cache, sizeof(_sg.gl.cache));
+        _sg.gl.cache.dirty_state_groups = _SG_GL_STATEGROUP_ALL;
         _sg_gl_cache_clear_buffer_bindings(true);
         _SG_GL_CHECK_ERROR();
         _sg_gl_cache_clear_texture_bindings(true);
@@ -6452,10 +7011,40 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #else
         _sg_gl_init_caps_gles2();
     #endif
+
+    /* timestamp queries for pass timing */
+    #if defined(SOKOL_GLCORE33)
+    if (desc->pass_timing) {
+        for (int i = 0; i < _SG_TIMING_NUM_FRAMES; i++) {
+            glGenQueries(_SG_TIMING_MAX_QUERIES, &_sg.gl.timer_queries[i][0]);
+        }
+        _sg.gl.timer_queries_valid = true;
+        _SG_GL_CHECK_ERROR();
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    #if defined(SOKOL_GLCORE33)
+    if (_sg.gl.timer_queries_valid) {
+        for (int i = 0; i < _SG_TIMING_NUM_FRAMES; i++) {
+            glDeleteQueries(_SG_TIMING_MAX_QUERIES, &_sg.gl.timer_queries[i][0]);
+        }
+        _sg.gl.timer_queries_valid = false;
+    }
+    #endif
+    #if !defined(SOKOL_GLES2)
+    for (int i = 0; i < SG_MAX_IMAGE_READS; i++) {
+        SOKOL_ASSERT(0 == _sg.gl.image_reads[i].fence);
+        if (_sg.gl.image_reads[i].pbo) {
+            glDeleteBuffers(1, &_sg.gl.image_reads[i].pbo);
+        }
+    }
+    if (_sg.gl.readback_fb) {
+        glDeleteFramebuffers(1, &_sg.gl.readback_fb);
+    }
+    #endif
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -6552,6 +7141,29 @@ _SOKOL_PRIVATE bool _sg_gl_supported_texture_format(sg_pixel_format fmt) {
     return _sg.formats[fmt_index].sample;
 }
 
+/* compute the tightly packed subimage layout of a pixel unpack buffer as offsets, returns total size in bytes */
+_SOKOL_PRIVATE int _sg_gl_upload_layout(const _sg_image_t* img, sg_image_data* out_offsets) {
+    if (out_offsets) {
+        memset(out_offsets, 0, sizeof(sg_image_data));
+    }
+    /* NOTE: same subimage sizes as expected by sg_update_image() */
+    const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
+    int offset = 0;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+            const int mip_width = _sg_max(img->cmn.width >> mip_index, 1);
+            const int mip_height = _sg_max(img->cmn.height >> mip_index, 1);
+            const int size = _sg_surface_pitch(img->cmn.pixel_format, mip_width, mip_height, 1) * img->cmn.num_slices;
+            if (out_offsets) {
+                out_offsets->subimage[face_index][mip_index].ptr = (const void*)(uintptr_t)offset;
+                out_offsets->subimage[face_index][mip_index].size = (size_t)size;
+            }
+            offset += size;
+        }
+    }
+    return offset;
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && desc);
     _SG_GL_CHECK_ERROR();
@@ -6733,6 +7345,20 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                 _sg_gl_cache_restore_texture_binding(0);
             }
         }
+
+        /* optional pixel unpack buffers for asynchronous texture streaming */
+        #if !defined(SOKOL_GLES2)
+        if (!_sg.gl.gles2 && desc->gl_pbo_streaming && (img->cmn.usage != SG_USAGE_IMMUTABLE) && !img->cmn.render_target) {
+            img->gl.upload_size = _sg_gl_upload_layout(img, 0);
+            glGenBuffers(_SG_NUM_UPLOAD_BUFFERS, &img->gl.upload_pbo[0]);
+            for (int i = 0; i < _SG_NUM_UPLOAD_BUFFERS; i++) {
+                SOKOL_ASSERT(img->gl.upload_pbo[i]);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, img->gl.upload_pbo[i]);
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, img->gl.upload_size, 0, GL_STREAM_DRAW);
+            }
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        #endif
     }
     _SG_GL_CHECK_ERROR();
     return SG_RESOURCESTATE_VALID;
@@ -6755,6 +7381,12 @@ _SOKOL_PRIVATE void _sg_gl_destroy_image(_sg_image_t* img) {
     if (img->gl.msaa_render_buffer) {
         glDeleteRenderbuffers(1, &img->gl.msaa_render_buffer);
     }
+    #if !defined(SOKOL_GLES2)
+    if (img->gl.upload_pbo[0]) {
+        /* NOTE: deleting a mapped buffer implicitly unmaps it */
+        glDeleteBuffers(_SG_NUM_UPLOAD_BUFFERS, &img->gl.upload_pbo[0]);
+    }
+    #endif
     _SG_GL_CHECK_ERROR();
 }
 
@@ -6906,6 +7538,86 @@ _SOKOL_PRIVATE void _sg_gl_destroy_shader(_sg_shader_t* shd) {
     _SG_GL_CHECK_ERROR();
 }
 
+_SOKOL_PRIVATE uint64_t _sg_gl_float_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+/* pack the render state of a pipeline into one key per state group, equal keys mean equal GL state */
+_SOKOL_PRIVATE void _sg_gl_init_state_keys(_sg_pipeline_t* pip) {
+    _sg_gl_state_keys_t* keys = &pip->gl.state_keys;
+    _sg_clear(keys, sizeof(_sg_gl_state_keys_t));
+
+    const sg_depth_state* ds = &pip->gl.depth;
+    keys->depth = (uint64_t)ds->compare | ((uint64_t)ds->write_enabled << 8);
+    keys->depth_bias = _sg_gl_float_bits(ds->bias) | (_sg_gl_float_bits(ds->bias_slope_scale) << 32);
+
+    const sg_stencil_state* ss = &pip->gl.stencil;
+    keys->stencil = (uint64_t)ss->enabled |
+                    ((uint64_t)ss->write_mask << 8) |
+                    ((uint64_t)ss->read_mask << 16) |
+                    ((uint64_t)ss->ref << 24);
+    for (int i = 0; i < 2; i++) {
+        const sg_stencil_face_state* sfs = (i==0) ? &ss->front : &ss->back;
+        const uint64_t face_key = (uint64_t)sfs->compare |
+                                  ((uint64_t)sfs->fail_op << 4) |
+                                  ((uint64_t)sfs->depth_fail_op << 8) |
+                                  ((uint64_t)sfs->pass_op << 12);
+        keys->stencil |= face_key << (32 + i * 16);
+    }
+
+    const sg_blend_state* bs = &pip->gl.blend;
+    keys->blend = (uint64_t)bs->enabled |
+                  ((uint64_t)bs->src_factor_rgb << 8) |
+                  ((uint64_t)bs->dst_factor_rgb << 16) |
+                  ((uint64_t)bs->op_rgb << 24) |
+                  ((uint64_t)bs->src_factor_alpha << 32) |
+                  ((uint64_t)bs->dst_factor_alpha << 40) |
+                  ((uint64_t)bs->op_alpha << 48);
+
+    const sg_color* bc = &pip->cmn.blend_color;
+    keys->blend_color[0] = _sg_gl_float_bits(bc->r) | (_sg_gl_float_bits(bc->g) << 32);
+    keys->blend_color[1] = _sg_gl_float_bits(bc->b) | (_sg_gl_float_bits(bc->a) << 32);
+
+    /* only the write masks of used color attachments are applied */
+    keys->color_mask = (uint64_t)pip->cmn.color_attachment_count;
+    for (int i = 0; i < pip->cmn.color_attachment_count; i++) {
+        keys->color_mask |= (uint64_t)pip->gl.color_write_mask[i] << (8 + i * 8);
+    }
+
+    keys->raster = (uint64_t)pip->gl.cull_mode |
+                   ((uint64_t)pip->gl.face_winding << 8) |
+                   ((uint64_t)pip->gl.alpha_to_coverage_enabled << 16) |
+                   ((uint64_t)pip->gl.sample_count << 24);
+}
+
+_SOKOL_PRIVATE uint32_t _sg_gl_state_keys_diff(const _sg_gl_state_keys_t* a, const _sg_gl_state_keys_t* b) {
+    uint32_t diff = 0;
+    if (a->depth != b->depth) {
+        diff |= _SG_GL_STATEGROUP_DEPTH;
+    }
+    if (a->depth_bias != b->depth_bias) {
+        diff |= _SG_GL_STATEGROUP_DEPTH_BIAS;
+    }
+    if (a->stencil != b->stencil) {
+        diff |= _SG_GL_STATEGROUP_STENCIL;
+    }
+    if (a->blend != b->blend) {
+        diff |= _SG_GL_STATEGROUP_BLEND;
+    }
+    if ((a->blend_color[0] != b->blend_color[0]) || (a->blend_color[1] != b->blend_color[1])) {
+        diff |= _SG_GL_STATEGROUP_BLEND_COLOR;
+    }
+    if (a->color_mask != b->color_mask) {
+        diff |= _SG_GL_STATEGROUP_COLOR_MASK;
+    }
+    if (a->raster != b->raster) {
+        diff |= _SG_GL_STATEGROUP_RASTER;
+    }
+    return diff;
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(pip && shd && desc);
     SOKOL_ASSERT(!pip->shader && pip->cmn.shader_id.id == SG_INVALID_ID);
@@ -6925,6 +7637,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg
     pip->gl.face_winding = desc->face_winding;
     pip->gl.sample_count = desc->sample_count;
     pip->gl.alpha_to_coverage_enabled = desc->alpha_to_coverage_enabled;
+    _sg_gl_init_state_keys(pip);
 
     /* resolve vertex attributes */
     for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
@@ -7221,6 +7934,7 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
                 need_pip_cache_flush = true;
                 need_color_mask_flush = true;
                 _sg.gl.cache.color_write_mask[i] = SG_COLORMASK_RGBA;
+                _sg.gl.cache.dirty_state_groups |= _SG_GL_STATEGROUP_COLOR_MASK;
             }
         }
         if (need_color_mask_flush) {
@@ -7231,11 +7945,13 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
         if (!_sg.gl.cache.depth.write_enabled) {
             need_pip_cache_flush = true;
             _sg.gl.cache.depth.write_enabled = true;
+            _sg.gl.cache.dirty_state_groups |= _SG_GL_STATEGROUP_DEPTH;
             glDepthMask(GL_TRUE);
         }
         if (_sg.gl.cache.depth.compare != SG_COMPAREFUNC_ALWAYS) {
             need_pip_cache_flush = true;
             _sg.gl.cache.depth.compare = SG_COMPAREFUNC_ALWAYS;
+            _sg.gl.cache.dirty_state_groups |= _SG_GL_STATEGROUP_DEPTH;
             glDepthFunc(GL_ALWAYS);
         }
     }
@@ -7243,6 +7959,7 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
         if (_sg.gl.cache.stencil.write_mask != 0xFF) {
             need_pip_cache_flush = true;
             _sg.gl.cache.stencil.write_mask = 0xFF;
+            _sg.gl.cache.dirty_state_groups |= _SG_GL_STATEGROUP_STENCIL;
             glStencilMask(0xFF);
         }
     }
@@ -7374,8 +8091,13 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         _sg.gl.cache.cur_primitive_type = _sg_gl_primitive_type(pip->gl.primitive_type);
         _sg.gl.cache.cur_index_type = _sg_gl_index_type(pip->cmn.index_type);
 
+        /* only state groups with different keys need to be compared field by field */
+        const uint32_t dirty = _sg.gl.cache.dirty_state_groups | _sg_gl_state_keys_diff(&pip->gl.state_keys, &_sg.gl.cache.state_keys);
+        _sg.gl.cache.state_keys = pip->gl.state_keys;
+        _sg.gl.cache.dirty_state_groups = 0;
+
         /* update depth state */
-        {
+        if (dirty & _SG_GL_STATEGROUP_DEPTH) {
             const sg_depth_state* state_ds = &pip->gl.depth;
             sg_depth_state* cache_ds = &_sg.gl.cache.depth;
             if (state_ds->compare != cache_ds->compare) {
@@ -7386,6 +8108,10 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                 cache_ds->write_enabled = state_ds->write_enabled;
                 glDepthMask(state_ds->write_enabled);
             }
+        }
+        if (dirty & _SG_GL_STATEGROUP_DEPTH_BIAS) {
+            const sg_depth_state* state_ds = &pip->gl.depth;
+            sg_depth_state* cache_ds = &_sg.gl.cache.depth;
             if (!_sg_fequal(state_ds->bias, cache_ds->bias, 0.000001f) ||
                 !_sg_fequal(state_ds->bias_slope_scale, cache_ds->bias_slope_scale, 0.000001f))
             {
@@ -7416,7 +8142,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         }
 
         /* update stencil state */
-        {
+        if (dirty & _SG_GL_STATEGROUP_STENCIL) {
             const sg_stencil_state* state_ss = &pip->gl.stencil;
             sg_stencil_state* cache_ss = &_sg.gl.cache.stencil;
             if (state_ss->enabled != cache_ss->enabled) {
@@ -7466,7 +8192,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         /* update blend state
             FIXME: separate blend state per color attachment not support, needs GL4
         */
-        {
+        if (dirty & _SG_GL_STATEGROUP_BLEND) {
             const sg_blend_state* state_bs = &pip->gl.blend;
             sg_blend_state* cache_bs = &_sg.gl.cache.blend;
             if (state_bs->enabled != cache_bs->enabled) {
@@ -7500,72 +8226,78 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         }
 
         /* standalone state */
-        for (GLuint i = 0; i < (GLuint)pip->cmn.color_attachment_count; i++) {
-            if (pip->gl.color_write_mask[i] != _sg.gl.cache.color_write_mask[i]) {
-                const sg_color_mask cm = pip->gl.color_write_mask[i];
-                _sg.gl.cache.color_write_mask[i] = cm;
-                #ifdef SOKOL_GLCORE33
-                    glColorMaski(i,
-                                (cm & SG_COLORMASK_R) != 0,
-                                (cm & SG_COLORMASK_G) != 0,
-                                (cm & SG_COLORMASK_B) != 0,
-                                (cm & SG_COLORMASK_A) != 0);
-                #else
-                    if (0 == i) {
-                        glColorMask((cm & SG_COLORMASK_R) != 0,
+        if (dirty & _SG_GL_STATEGROUP_COLOR_MASK) {
+            for (GLuint i = 0; i < (GLuint)pip->cmn.color_attachment_count; i++) {
+                if (pip->gl.color_write_mask[i] != _sg.gl.cache.color_write_mask[i]) {
+                    const sg_color_mask cm = pip->gl.color_write_mask[i];
+                    _sg.gl.cache.color_write_mask[i] = cm;
+                    #ifdef SOKOL_GLCORE33
+                        glColorMaski(i,
+                                    (cm & SG_COLORMASK_R) != 0,
                                     (cm & SG_COLORMASK_G) != 0,
                                     (cm & SG_COLORMASK_B) != 0,
                                     (cm & SG_COLORMASK_A) != 0);
-                    }
-                #endif
+                    #else
+                        if (0 == i) {
+                            glColorMask((cm & SG_COLORMASK_R) != 0,
+                                        (cm & SG_COLORMASK_G) != 0,
+                                        (cm & SG_COLORMASK_B) != 0,
+                                        (cm & SG_COLORMASK_A) != 0);
+                        }
+                    #endif
+                }
             }
         }
 
-        if (!_sg_fequal(pip->cmn.blend_color.r, _sg.gl.cache.blend_color.r, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.g, _sg.gl.cache.blend_color.g, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.b, _sg.gl.cache.blend_color.b, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.a, _sg.gl.cache.blend_color.a, 0.0001f))
-        {
-            sg_color c = pip->cmn.blend_color;
-            _sg.gl.cache.blend_color = c;
-            glBlendColor(c.r, c.g, c.b, c.a);
-        }
-        if (pip->gl.cull_mode != _sg.gl.cache.cull_mode) {
-            _sg.gl.cache.cull_mode = pip->gl.cull_mode;
-            if (SG_CULLMODE_NONE == pip->gl.cull_mode) {
-                glDisable(GL_CULL_FACE);
-            }
-            else {
-                glEnable(GL_CULL_FACE);
-                GLenum gl_mode = (SG_CULLMODE_FRONT == pip->gl.cull_mode) ? GL_FRONT : GL_BACK;
-                glCullFace(gl_mode);
+        if (dirty & _SG_GL_STATEGROUP_BLEND_COLOR) {
+            if (!_sg_fequal(pip->cmn.blend_color.r, _sg.gl.cache.blend_color.r, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.g, _sg.gl.cache.blend_color.g, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.b, _sg.gl.cache.blend_color.b, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.a, _sg.gl.cache.blend_color.a, 0.0001f))
+            {
+                sg_color c = pip->cmn.blend_color;
+                _sg.gl.cache.blend_color = c;
+                glBlendColor(c.r, c.g, c.b, c.a);
             }
         }
-        if (pip->gl.face_winding != _sg.gl.cache.face_winding) {
-            _sg.gl.cache.face_winding = pip->gl.face_winding;
-            GLenum gl_winding = (SG_FACEWINDING_CW == pip->gl.face_winding) ? GL_CW : GL_CCW;
-            glFrontFace(gl_winding);
-        }
-        if (pip->gl.alpha_to_coverage_enabled != _sg.gl.cache.alpha_to_coverage_enabled) {
-            _sg.gl.cache.alpha_to_coverage_enabled = pip->gl.alpha_to_coverage_enabled;
-            if (pip->gl.alpha_to_coverage_enabled) {
-                glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+        if (dirty & _SG_GL_STATEGROUP_RASTER) {
+            if (pip->gl.cull_mode != _sg.gl.cache.cull_mode) {
+                _sg.gl.cache.cull_mode = pip->gl.cull_mode;
+                if (SG_CULLMODE_NONE == pip->gl.cull_mode) {
+                    glDisable(GL_CULL_FACE);
+                }
+                else {
+                    glEnable(GL_CULL_FACE);
+                    GLenum gl_mode = (SG_CULLMODE_FRONT == pip->gl.cull_mode) ? GL_FRONT : GL_BACK;
+                    glCullFace(gl_mode);
+                }
             }
-            else {
-                glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+            if (pip->gl.face_winding != _sg.gl.cache.face_winding) {
+                _sg.gl.cache.face_winding = pip->gl.face_winding;
+                GLenum gl_winding = (SG_FACEWINDING_CW == pip->gl.face_winding) ? GL_CW : GL_CCW;
+                glFrontFace(gl_winding);
             }
-        }
-        #ifdef SOKOL_GLCORE33
-        if (pip->gl.sample_count != _sg.gl.cache.sample_count) {
-            _sg.gl.cache.sample_count = pip->gl.sample_count;
-            if (pip->gl.sample_count > 1) {
-                glEnable(GL_MULTISAMPLE);
+            if (pip->gl.alpha_to_coverage_enabled != _sg.gl.cache.alpha_to_coverage_enabled) {
+                _sg.gl.cache.alpha_to_coverage_enabled = pip->gl.alpha_to_coverage_enabled;
+                if (pip->gl.alpha_to_coverage_enabled) {
+                    glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+                }
+                else {
+                    glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+                }
             }
-            else {
-                glDisable(GL_MULTISAMPLE);
+            #ifdef SOKOL_GLCORE33
+            if (pip->gl.sample_count != _sg.gl.cache.sample_count) {
+                _sg.gl.cache.sample_count = pip->gl.sample_count;
+                if (pip->gl.sample_count > 1) {
+                    glEnable(GL_MULTISAMPLE);
+                }
+                else {
+                    glDisable(GL_MULTISAMPLE);
+                }
             }
+            #endif
         }
-        #endif
 
         /* bind shader program */
         if (pip->shader->gl.prog != _sg.gl.cache.prog) {
@@ -7759,6 +8491,140 @@ _SOKOL_PRIVATE void _sg_gl_commit(void) {
     _sg_gl_cache_clear_texture_bindings(false);
 }
 
+_SOKOL_PRIVATE void _sg_gl_write_timestamp(int frame_slot, int query_index) {
+    SOKOL_ASSERT((frame_slot >= 0) && (frame_slot < _SG_TIMING_NUM_FRAMES));
+    SOKOL_ASSERT((query_index >= 0) && (query_index < _SG_TIMING_MAX_QUERIES));
+    #if defined(SOKOL_GLCORE33)
+    SOKOL_ASSERT(_sg.gl.timer_queries_valid);
+    glQueryCounter(_sg.gl.timer_queries[frame_slot][query_index], GL_TIMESTAMP);
+    _SG_GL_CHECK_ERROR();
+    #else
+    _SOKOL_UNUSED(frame_slot);
+    _SOKOL_UNUSED(query_index);
+    #endif
+}
+
+/* copy pixels into a pixel pack buffer, the result is picked up in _sg_gl_poll_read_image() */
+_SOKOL_PRIVATE bool _sg_gl_read_image(int read_index, const _sg_image_t* img, const sg_rect* rect, void* dst, size_t num_bytes) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < SG_MAX_IMAGE_READS));
+    SOKOL_ASSERT(img && rect && dst && (num_bytes > 0));
+    _SOKOL_UNUSED(dst);
+    #if defined(SOKOL_GLES2)
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(rect);
+    _SOKOL_UNUSED(num_bytes);
+    return false;
+    #else
+    if (_sg.gl.gles2) {
+        return false;
+    }
+    SOKOL_ASSERT(GL_TEXTURE_2D == img->gl.target);
+    const GLuint tex = img->gl.tex[img->cmn.active_slot];
+    SOKOL_ASSERT(tex);
+    _SG_GL_CHECK_ERROR();
+    if (0 == _sg.gl.readback_fb) {
+        glGenFramebuffers(1, &_sg.gl.readback_fb);
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _sg.gl.readback_fb);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    /* the pixel pack buffers are kept around and only grow */
+    SOKOL_ASSERT(0 == _sg.gl.image_reads[read_index].fence);
+    if (0 == _sg.gl.image_reads[read_index].pbo) {
+        glGenBuffers(1, &_sg.gl.image_reads[read_index].pbo);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, _sg.gl.image_reads[read_index].pbo);
+    if (_sg.gl.image_reads[read_index].pbo_size < (GLsizeiptr)num_bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)num_bytes, 0, GL_STREAM_READ);
+        _sg.gl.image_reads[read_index].pbo_size = (GLsizeiptr)num_bytes;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    const sg_pixel_format fmt = img->cmn.pixel_format;
+    glReadPixels(rect->x, rect->y, rect->width, rect->height, _sg_gl_teximage_format(fmt), _sg_gl_teximage_type(fmt), 0);
+    _sg.gl.image_reads[read_index].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _sg.gl.cur_context ? _sg.gl.cur_context->default_framebuffer : 0);
+    _SG_GL_CHECK_ERROR();
+    return true;
+    #endif
+}
+
+/* returns false without blocking if the pixel data hasn't arrived yet */
+_SOKOL_PRIVATE bool _sg_gl_poll_read_image(int read_index, void* dst, size_t num_bytes, bool* out_success) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < SG_MAX_IMAGE_READS));
+    SOKOL_ASSERT(dst && (num_bytes > 0) && out_success);
+    #if defined(SOKOL_GLES2)
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(dst);
+    _SOKOL_UNUSED(num_bytes);
+    *out_success = false;
+    return true;
+    #else
+    SOKOL_ASSERT(_sg.gl.image_reads[read_index].fence);
+    const GLenum wait_res = glClientWaitSync(_sg.gl.image_reads[read_index].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if ((wait_res != GL_ALREADY_SIGNALED) && (wait_res != GL_CONDITION_SATISFIED)) {
+        return false;
+    }
+    glDeleteSync(_sg.gl.image_reads[read_index].fence);
+    _sg.gl.image_reads[read_index].fence = 0;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, _sg.gl.image_reads[read_index].pbo);
+    const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)num_bytes, GL_MAP_READ_BIT);
+    if (src) {
+        memcpy(dst, src, num_bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+    *out_success = (0 != src);
+    return true;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_discard_read_image(int read_index) {
+    SOKOL_ASSERT((read_index >= 0) && (read_index < SG_MAX_IMAGE_READS));
+    #if defined(SOKOL_GLES2)
+    _SOKOL_UNUSED(read_index);
+    #else
+    if (_sg.gl.image_reads[read_index].fence) {
+        glDeleteSync(_sg.gl.image_reads[read_index].fence);
+        _sg.gl.image_reads[read_index].fence = 0;
+    }
+    #endif
+}
+
+/* returns false without blocking if the query results are not available yet */
+_SOKOL_PRIVATE bool _sg_gl_resolve_timestamps(int frame_slot, int num_queries) {
+    SOKOL_ASSERT((frame_slot >= 0) && (frame_slot < _SG_TIMING_NUM_FRAMES));
+    SOKOL_ASSERT((num_queries > 0) && (num_queries <= _SG_TIMING_MAX_QUERIES));
+    #if defined(SOKOL_GLCORE33)
+    SOKOL_ASSERT(_sg.gl.timer_queries_valid);
+    const GLuint* queries = &_sg.gl.timer_queries[frame_slot][0];
+    for (int i = 0; i < num_queries; i++) {
+        GLint available = 0;
+        glGetQueryObjectiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+    uint64_t* timestamps = &_sg.timing.frames[frame_slot].timestamps[0];
+    for (int i = 0; i < num_queries; i++) {
+        GLuint64 t = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &t);
+        timestamps[i] = (uint64_t) t;
+    }
+    _SG_GL_CHECK_ERROR();
+    return true;
+    #else
+    _SOKOL_UNUSED(frame_slot);
+    _SOKOL_UNUSED(num_queries);
+    return false;
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
     /* only one update per buffer per frame allowed */
@@ -7798,16 +8664,8 @@ _SOKOL_PRIVATE int _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data,
     return _sg_roundup((int)data->size, 4);
 }
 
-_SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* data) {
-    SOKOL_ASSERT(img && data);
-    /* only one update per image per frame allowed */
-    if (++img->cmn.active_slot >= img->cmn.num_slots) {
-        img->cmn.active_slot = 0;
-    }
-    SOKOL_ASSERT(img->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
-    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
-    _sg_gl_cache_store_texture_binding(0);
-    _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
+/* upload new content into the currently bound texture, data may contain offsets into a bound pixel unpack buffer */
+_SOKOL_PRIVATE void _sg_gl_tex_sub_images(const _sg_image_t* img, const sg_image_data* data) {
     const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
     const GLenum gl_img_type = _sg_gl_teximage_type(img->cmn.pixel_format);
     const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
@@ -7850,9 +8708,102 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
             #endif
         }
     }
+}
+
+#if !defined(SOKOL_GLES2)
+/* map the next pixel unpack buffer of an image for writing (orphans the previous buffer content) */
+_SOKOL_PRIVATE void* _sg_gl_map_upload_pbo(_sg_image_t* img) {
+    SOKOL_ASSERT(img->gl.upload_pbo[0] && !img->gl.mapped);
+    if (++img->gl.cur_upload_pbo >= _SG_NUM_UPLOAD_BUFFERS) {
+        img->gl.cur_upload_pbo = 0;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, img->gl.upload_pbo[img->gl.cur_upload_pbo]);
+    void* ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, img->gl.upload_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    img->gl.mapped = (0 != ptr);
+    return ptr;
+}
+
+/* unmap the current pixel unpack buffer and start the texture upload from it */
+_SOKOL_PRIVATE void _sg_gl_upload_from_pbo(_sg_image_t* img) {
+    SOKOL_ASSERT(img->gl.mapped);
+    img->gl.mapped = false;
+    if (++img->cmn.active_slot >= img->cmn.num_slots) {
+        img->cmn.active_slot = 0;
+    }
+    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, img->gl.upload_pbo[img->gl.cur_upload_pbo]);
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        sg_image_data offsets;
+        _sg_gl_upload_layout(img, &offsets);
+        _sg_gl_cache_store_texture_binding(0);
+        _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
+        _sg_gl_tex_sub_images(img, &offsets);
+        _sg_gl_cache_restore_texture_binding(0);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _SG_GL_CHECK_ERROR();
+}
+#endif
+
+_SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* data) {
+    SOKOL_ASSERT(img && data);
+    #if !defined(SOKOL_GLES2)
+    if (img->gl.upload_pbo[0]) {
+        uint8_t* dst = (uint8_t*) _sg_gl_map_upload_pbo(img);
+        if (dst) {
+            sg_image_data offsets;
+            _sg_gl_upload_layout(img, &offsets);
+            const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
+            for (int face_index = 0; face_index < num_faces; face_index++) {
+                for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+                    const sg_range* src = &data->subimage[face_index][mip_index];
+                    const sg_range* dst_range = &offsets.subimage[face_index][mip_index];
+                    SOKOL_ASSERT(src->size == dst_range->size);
+                    memcpy(dst + (uintptr_t)dst_range->ptr, src->ptr, dst_range->size);
+                }
+            }
+            _sg_gl_upload_from_pbo(img);
+            return;
+        }
+        /* mapping failed, fall back to uploading from client memory */
+    }
+    #endif
+    /* only one update per image per frame allowed */
+    if (++img->cmn.active_slot >= img->cmn.num_slots) {
+        img->cmn.active_slot = 0;
+    }
+    SOKOL_ASSERT(img->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
+    SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    _sg_gl_cache_store_texture_binding(0);
+    _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
+    _sg_gl_tex_sub_images(img, data);
     _sg_gl_cache_restore_texture_binding(0);
 }
 
+_SOKOL_PRIVATE sg_range _sg_gl_map_image(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    sg_range res = { 0, 0 };
+    #if !defined(SOKOL_GLES2)
+    if (img->gl.upload_pbo[0]) {
+        res.ptr = _sg_gl_map_upload_pbo(img);
+        res.size = res.ptr ? (size_t)img->gl.upload_size : 0;
+    }
+    #endif
+    return res;
+}
+
+_SOKOL_PRIVATE void _sg_gl_unmap_image(_sg_image_t* img) {
+    SOKOL_ASSERT(img);
+    #if !defined(SOKOL_GLES2)
+    if (img->gl.mapped) {
+        _sg_gl_upload_from_pbo(img);
+    }
+    #else
+    _SOKOL_UNUSED(img);
+    #endif
+}
+
 /*== D3D11 BACKEND IMPLEMENTATION ============================================*/
 #elif defined(SOKOL_D3D11)
 
@@ -13203,6 +14154,70 @@ static inline void _sg_discard_backend(void) {
     #endif
 }
 
+static inline void _sg_write_timestamp(int frame_slot, int query_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_write_timestamp(frame_slot, query_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_write_timestamp(frame_slot, query_index);
+    #else
+    /* pass timing not implemented, sg_features.pass_timing is false */
+    _SOKOL_UNUSED(frame_slot);
+    _SOKOL_UNUSED(query_index);
+    #endif
+}
+
+static inline bool _sg_read_image(int read_index, const _sg_image_t* img, const sg_rect* rect, void* dst, size_t num_bytes) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_read_image(read_index, img, rect, dst, num_bytes);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_read_image(read_index, img, rect, dst, num_bytes);
+    #else
+    /* image readback not implemented, sg_features.image_readback is false */
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(img);
+    _SOKOL_UNUSED(rect);
+    _SOKOL_UNUSED(dst);
+    _SOKOL_UNUSED(num_bytes);
+    return false;
+    #endif
+}
+
+static inline bool _sg_poll_read_image(int read_index, void* dst, size_t num_bytes, bool* out_success) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_poll_read_image(read_index, dst, num_bytes, out_success);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_poll_read_image(read_index, dst, num_bytes, out_success);
+    #else
+    _SOKOL_UNUSED(read_index);
+    _SOKOL_UNUSED(dst);
+    _SOKOL_UNUSED(num_bytes);
+    *out_success = false;
+    return true;
+    #endif
+}
+
+static inline void _sg_discard_read_image(int read_index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_discard_read_image(read_index);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    _sg_dummy_discard_read_image(read_index);
+    #else
+    _SOKOL_UNUSED(read_index);
+    #endif
+}
+
+static inline bool _sg_resolve_timestamps(int frame_slot, int num_queries) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_resolve_timestamps(frame_slot, num_queries);
+    #elif defined(SOKOL_DUMMY_BACKEND)
+    return _sg_dummy_resolve_timestamps(frame_slot, num_queries);
+    #else
+    _SOKOL_UNUSED(frame_slot);
+    _SOKOL_UNUSED(num_queries);
+    return false;
+    #endif
+}
+
 static inline void _sg_reset_state_cache(void) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_reset_state_cache();
@@ -13657,6 +14672,24 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data)
     #endif
 }
 
+static inline sg_range _sg_map_image(_sg_image_t* img) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_map_image(img);
+    #else
+    _SOKOL_UNUSED(img);
+    sg_range res = { 0, 0 };
+    return res;
+    #endif
+}
+
+static inline void _sg_unmap_image(_sg_image_t* img) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_unmap_image(img);
+    #else
+    _SOKOL_UNUSED(img);
+    #endif
+}
+
 /*== RESOURCE POOLS ==========================================================*/
 
 _SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
@@ -14133,6 +15166,17 @@ _SOKOL_PRIVATE const char* _sg_validate_string(_sg_validate_error_t err) {
         /* sg_update_image */
         case _SG_VALIDATE_UPDIMG_USAGE:         return "sg_update_image: cannot update immutable image";
         case _SG_VALIDATE_UPDIMG_ONCE:          return "sg_update_image: only one update allowed per image and frame";
+        case _SG_VALIDATE_MAPIMG_USAGE:         return "sg_map_image: cannot map immutable image";
+        case _SG_VALIDATE_MAPIMG_ONCE:          return "sg_map_image: only one update or map allowed per image and frame";
+
+        /* sg_read_image_async */
+        case _SG_VALIDATE_READIMG_IN_PASS:      return "sg_read_image_async: cannot be called inside a render pass";
+        case _SG_VALIDATE_READIMG_RT:           return "sg_read_image_async: image must be a render target";
+        case _SG_VALIDATE_READIMG_TYPE:         return "sg_read_image_async: image must be of type SG_IMAGETYPE_2D";
+        case _SG_VALIDATE_READIMG_FORMAT:       return "sg_read_image_async: image must have a color render target pixel format";
+        case _SG_VALIDATE_READIMG_RECT:         return "sg_read_image_async: rect must be inside the image";
+        case _SG_VALIDATE_READIMG_BUFFER:       return "sg_read_image_async: buffer too small (must be at least rect.width * rect.height * bytes-per-pixel)";
+        case _SG_VALIDATE_READIMG_CALLBACK:     return "sg_read_image_async: callback must be provided";
 
         default: return "unknown validation error";
     }
@@ -14751,6 +15795,42 @@ _SOKOL_PRIVATE bool _sg_validate_update_image(const _sg_image_t* img, const sg_i
     #endif
 }
 
+_SOKOL_PRIVATE bool _sg_validate_map_image(const _sg_image_t* img) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        return true;
+    #else
+        SOKOL_ASSERT(img);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(img->cmn.usage != SG_USAGE_IMMUTABLE, _SG_VALIDATE_MAPIMG_USAGE);
+        SOKOL_VALIDATE(img->cmn.upd_frame_index != _sg.frame_index, _SG_VALIDATE_MAPIMG_ONCE);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_read_image(const _sg_image_t* img, const sg_rect* rect, const sg_range* buffer, sg_read_image_callback callback) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(img);
+        _SOKOL_UNUSED(rect);
+        _SOKOL_UNUSED(buffer);
+        _SOKOL_UNUSED(callback);
+        return true;
+    #else
+        SOKOL_ASSERT(img && rect && buffer);
+        SOKOL_VALIDATE_BEGIN();
+        SOKOL_VALIDATE(!_sg.pass_valid, _SG_VALIDATE_READIMG_IN_PASS);
+        SOKOL_VALIDATE(img->cmn.render_target, _SG_VALIDATE_READIMG_RT);
+        SOKOL_VALIDATE(img->cmn.type == SG_IMAGETYPE_2D, _SG_VALIDATE_READIMG_TYPE);
+        SOKOL_VALIDATE(_sg_is_valid_rendertarget_color_format(img->cmn.pixel_format), _SG_VALIDATE_READIMG_FORMAT);
+        SOKOL_VALIDATE((rect->x >= 0) && (rect->y >= 0) && (rect->width > 0) && (rect->height > 0) &&
+                       ((rect->x + rect->width) <= img->cmn.width) &&
+                       ((rect->y + rect->height) <= img->cmn.height), _SG_VALIDATE_READIMG_RECT);
+        SOKOL_VALIDATE(buffer->ptr && (buffer->size >= (size_t)_sg_surface_pitch(img->cmn.pixel_format, rect->width, rect->height, 1)), _SG_VALIDATE_READIMG_BUFFER);
+        SOKOL_VALIDATE(0 != callback, _SG_VALIDATE_READIMG_CALLBACK);
+        return SOKOL_VALIDATE_END();
+    #endif
+}
+
 /*== fill in desc default values =============================================*/
 _SOKOL_PRIVATE sg_buffer_desc _sg_buffer_desc_defaults(const sg_buffer_desc* desc) {
     sg_buffer_desc def = *desc;
@@ -15230,6 +16310,209 @@ _SOKOL_PRIVATE sg_desc _sg_desc_defaults(const sg_desc* desc) {
     return res;
 }
 
+/*== PASS TIMING =============================================================*/
+_SOKOL_PRIVATE void _sg_timing_begin_scope(const char* name, bool is_pass) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    const int frame_slot = _sg.timing.cur_frame;
+    _sg_timing_frame_t* frame = &_sg.timing.frames[frame_slot];
+    int scope_index = -1;
+    if (frame->num_scopes < SG_MAX_TIMING_SCOPES) {
+        scope_index = frame->num_scopes++;
+        _sg_timing_scope_t* scope = &frame->scopes[scope_index];
+        _sg_timing_copy_name(scope->name, name);
+        scope->is_pass = is_pass;
+        scope->depth = _sg.timing.stack_depth;
+        scope->begin_query = frame->num_queries++;
+        scope->end_query = -1;
+        _sg_write_timestamp(frame_slot, scope->begin_query);
+    }
+    if (_sg.timing.stack_depth < SG_MAX_TIMING_SCOPES) {
+        _sg_timing_stack_item_t* item = &_sg.timing.stack[_sg.timing.stack_depth];
+        item->scope_index = scope_index;
+        item->is_pass = is_pass;
+    }
+    _sg.timing.stack_depth++;
+}
+
+/* returns true if the closed scope was a pass scope */
+_SOKOL_PRIVATE bool _sg_timing_end_scope(void) {
+    SOKOL_ASSERT(_sg.timing.enabled && (_sg.timing.stack_depth > 0));
+    _sg.timing.stack_depth--;
+    if (_sg.timing.stack_depth >= SG_MAX_TIMING_SCOPES) {
+        return false;
+    }
+    const _sg_timing_stack_item_t* item = &_sg.timing.stack[_sg.timing.stack_depth];
+    if (item->scope_index >= 0) {
+        const int frame_slot = _sg.timing.cur_frame;
+        _sg_timing_frame_t* frame = &_sg.timing.frames[frame_slot];
+        _sg_timing_scope_t* scope = &frame->scopes[item->scope_index];
+        SOKOL_ASSERT(scope->end_query == -1);
+        scope->end_query = frame->num_queries++;
+        _sg_write_timestamp(frame_slot, scope->end_query);
+    }
+    return item->is_pass;
+}
+
+/* close the current pass scope and any debug groups left open inside the pass */
+_SOKOL_PRIVATE void _sg_timing_end_pass(void) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    while (_sg.timing.stack_depth > 0) {
+        if (_sg_timing_end_scope()) {
+            break;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_timing_pop_debug_group(void) {
+    if (!_sg.timing.enabled || (0 == _sg.timing.stack_depth)) {
+        return;
+    }
+    /* a debug group pop must not close a pass scope */
+    const int top = _sg.timing.stack_depth - 1;
+    if ((top < SG_MAX_TIMING_SCOPES) && _sg.timing.stack[top].is_pass) {
+        return;
+    }
+    _sg_timing_end_scope();
+}
+
+_SOKOL_PRIVATE void _sg_timing_resolve_frame(int frame_slot) {
+    _sg_timing_frame_t* frame = &_sg.timing.frames[frame_slot];
+    SOKOL_ASSERT(frame->pending && (frame->num_queries > 0));
+    if (!_sg_resolve_timestamps(frame_slot, frame->num_queries)) {
+        return;
+    }
+    frame->pending = false;
+    sg_frame_timings* res = &_sg.timing.resolved;
+    _sg_clear(res, sizeof(sg_frame_timings));
+    res->valid = true;
+    res->frame_index = frame->frame_index;
+    res->num_scopes = frame->num_scopes;
+    for (int i = 0; i < frame->num_scopes; i++) {
+        const _sg_timing_scope_t* src = &frame->scopes[i];
+        sg_timing_scope* dst = &res->scopes[i];
+        memcpy(dst->name, src->name, SG_TIMING_NAME_SIZE);
+        dst->is_pass = src->is_pass;
+        dst->depth = src->depth;
+        SOKOL_ASSERT((src->begin_query >= 0) && (src->end_query > src->begin_query));
+        const uint64_t t0 = frame->timestamps[src->begin_query];
+        const uint64_t t1 = frame->timestamps[src->end_query];
+        dst->duration_ms = (t1 > t0) ? ((double)(t1 - t0) / 1000000.0) : 0.0;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_timing_commit(void) {
+    if (!_sg.timing.enabled) {
+        return;
+    }
+    /* close any scopes left open by the application */
+    while (_sg.timing.stack_depth > 0) {
+        _sg_timing_end_scope();
+    }
+    _sg_timing_frame_t* cur = &_sg.timing.frames[_sg.timing.cur_frame];
+    cur->frame_index = _sg.frame_index;
+    cur->pending = cur->num_scopes > 0;
+
+    /* pick up the results of all finished frames, oldest first, never wait for the GPU */
+    for (int i = 1; i <= _SG_TIMING_NUM_FRAMES; i++) {
+        const int frame_slot = (_sg.timing.cur_frame + i) % _SG_TIMING_NUM_FRAMES;
+        if (_sg.timing.frames[frame_slot].pending) {
+            _sg_timing_resolve_frame(frame_slot);
+        }
+    }
+
+    /* if the GPU is too far behind, the oldest frame's results are dropped here */
+    _sg.timing.cur_frame = (_sg.timing.cur_frame + 1) % _SG_TIMING_NUM_FRAMES;
+    _sg_timing_frame_t* next = &_sg.timing.frames[_sg.timing.cur_frame];
+    next->pending = false;
+    next->num_scopes = 0;
+    next->num_queries = 0;
+}
+
+/*== UNIFORM BLOCK CACHE =====================================================*/
+
+_SOKOL_PRIVATE void _sg_ub_cache_invalidate(void) {
+    _sg.ub_cache.shader_id = SG_INVALID_ID;
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            _sg.ub_cache.slots[stage_index][ub_index].size = 0;
+        }
+    }
+}
+
+/* forget the cached uniform block content if the shader changes */
+_SOKOL_PRIVATE void _sg_ub_cache_apply_shader(uint32_t shader_id) {
+    if (_sg.ub_cache.shader_id != shader_id) {
+        _sg_ub_cache_invalidate();
+        _sg.ub_cache.shader_id = shader_id;
+    }
+}
+
+/* returns true if the uniform data is the same as last time, otherwise updates the cache slot */
+_SOKOL_PRIVATE bool _sg_ub_cache_match(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    _sg_ub_cache_slot_t* slot = &_sg.ub_cache.slots[stage][ub_index];
+    if (data->size > _SG_UB_CACHE_MAX_COPY_SIZE) {
+        /* too big to remember, a hash could produce false matches */
+        slot->size = 0;
+        return false;
+    }
+    if ((slot->size == data->size) && (0 == memcmp(slot->data, data->ptr, data->size))) {
+        return true;
+    }
+    memcpy(slot->data, data->ptr, data->size);
+    slot->size = data->size;
+    return false;
+}
+
+/*== IMAGE READBACK ==========================================================*/
+
+/* returns the index of the oldest image read in flight, or -1 */
+_SOKOL_PRIVATE int _sg_oldest_image_read(void) {
+    int oldest = -1;
+    for (int i = 0; i < SG_MAX_IMAGE_READS; i++) {
+        if (_sg.image_reads[i].active) {
+            if ((oldest == -1) || (_sg.image_reads[i].seq < _sg.image_reads[oldest].seq)) {
+                oldest = i;
+            }
+        }
+    }
+    return oldest;
+}
+
+/* called from sg_commit(), invokes callbacks of finished reads in order without waiting */
+_SOKOL_PRIVATE void _sg_poll_image_reads(void) {
+    int read_index;
+    while ((read_index = _sg_oldest_image_read()) >= 0) {
+        _sg_image_read_t* read = &_sg.image_reads[read_index];
+        bool success = false;
+        if (!_sg_poll_read_image(read_index, (void*)read->result.data.ptr, read->result.data.size, &success)) {
+            break;
+        }
+        /* free the slot before invoking the callback, so that the callback may start a new read */
+        sg_read_image_result result = read->result;
+        sg_read_image_callback callback = read->callback;
+        read->active = false;
+        result.success = success;
+        callback(&result);
+    }
+}
+
+/* called from sg_shutdown(), reads in flight are dropped */
+_SOKOL_PRIVATE void _sg_discard_image_reads(void) {
+    int read_index;
+    while ((read_index = _sg_oldest_image_read()) >= 0) {
+        _sg_image_read_t* read = &_sg.image_reads[read_index];
+        _sg_discard_read_image(read_index);
+        sg_read_image_result result = read->result;
+        read->active = false;
+        result.success = false;
+        read->callback(&result);
+    }
+}
+
 /*== PUBLIC API FUNCTIONS ====================================================*/
 
 SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
@@ -15241,6 +16524,7 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg_setup_pools(&_sg.pools, &_sg.desc);
     _sg.frame_index = 1;
     _sg_setup_backend(&_sg.desc);
+    _sg.timing.enabled = _sg.desc.pass_timing && _sg.features.pass_timing;
     _sg.valid = true;
     sg_setup_context();
 }
@@ -15250,6 +16534,7 @@ SOKOL_API_IMPL void sg_shutdown(void) {
     contexts are used, the app code must take care of properly releasing them
     (since only the app code can switch between 3D-API contexts)
     */
+    _sg_discard_image_reads();
     if (_sg.active_context.id != SG_INVALID_ID) {
         _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, _sg.active_context.id);
         if (ctx) {
@@ -15326,12 +16611,43 @@ SOKOL_API_IMPL void sg_discard_context(sg_context ctx_id) {
     _sg_activate_context(0);
 }
 
+SOKOL_API_IMPL sg_instance sg_make_instance(const sg_instance_desc* desc) {
+    SOKOL_ASSERT(desc);
+    SOKOL_ASSERT((desc->allocator.alloc && desc->allocator.free) || (!desc->allocator.alloc && !desc->allocator.free));
+    _sg_instance_t* inst = (_sg_instance_t*) _sg_malloc_with_allocator(&desc->allocator, sizeof(_sg_instance_t));
+    _sg_clear(inst, sizeof(_sg_instance_t));
+    inst->allocator = desc->allocator;
+    sg_instance res;
+    res.ptr = inst;
+    return res;
+}
+
+SOKOL_API_IMPL void sg_destroy_instance(sg_instance inst_handle) {
+    _sg_instance_t* inst = (_sg_instance_t*) inst_handle.ptr;
+    SOKOL_ASSERT(inst);
+    /* instance must have been shut down and must not be current */
+    SOKOL_ASSERT(!inst->state.valid);
+    SOKOL_ASSERT(_sg_state_ptr != &inst->state);
+    /* copy the allocator, since it lives in the memory which is freed */
+    const sg_allocator allocator = inst->allocator;
+    _sg_free_with_allocator(&allocator, inst);
+}
+
+SOKOL_API_IMPL sg_instance sg_set_instance(sg_instance inst_handle) {
+    sg_instance prev;
+    prev.ptr = (_sg_state_ptr == &_sg_default_state) ? 0 : (void*)_sg_state_ptr;
+    _sg_instance_t* inst = (_sg_instance_t*) inst_handle.ptr;
+    _sg_state_ptr = inst ? &inst->state : &_sg_default_state;
+    return prev;
+}
+
 SOKOL_API_IMPL void sg_activate_context(sg_context ctx_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg.active_context = ctx_id;
     _sg_context_t* ctx = _sg_lookup_context(&_sg.pools, ctx_id.id);
     /* NOTE: ctx can be 0 here if the context is no longer valid */
     _sg_activate_context(ctx);
+    _sg_ub_cache_invalidate();
 }
 
 SOKOL_API_IMPL sg_trace_hooks sg_install_trace_hooks(const sg_trace_hooks* trace_hooks) {
@@ -15700,6 +17016,8 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
+    _sg_ub_cache_invalidate();
+    _sg_timing_begin_scope("default", true);
     _sg_begin_pass(0, &pa, width, height);
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
@@ -15722,6 +17040,8 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        _sg_ub_cache_invalidate();
+        _sg_timing_begin_scope(pass->cmn.label, true);
         _sg_begin_pass(pass, &pa, w, h);
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
@@ -15776,6 +17096,7 @@ SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(pip);
     _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
     SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+    _sg_ub_cache_apply_shader(pip->cmn.shader_id.id);
     _sg_apply_pipeline(pip);
     _SG_TRACE_ARGS(apply_pipeline, pip_id);
 }
@@ -15870,7 +17191,15 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
-    _sg_apply_uniforms(stage, ub_index, data);
+    _sg.cur_stats.uniforms.num_apply++;
+    _sg.cur_stats.uniforms.size_apply += data->size;
+    if (_sg_ub_cache_match(stage, ub_index, data)) {
+        _sg.cur_stats.uniforms.num_skipped++;
+        _sg.cur_stats.uniforms.size_skipped += data->size;
+    }
+    else {
+        _sg_apply_uniforms(stage, ub_index, data);
+    }
     _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
 }
 
@@ -15914,6 +17243,7 @@ SOKOL_API_IMPL void sg_end_pass(void) {
         return;
     }
     _sg_end_pass();
+    _sg_timing_end_pass();
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
     _sg.pass_valid = false;
@@ -15923,13 +17253,19 @@ SOKOL_API_IMPL void sg_end_pass(void) {
 SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_commit();
+    _sg_timing_commit();
+    _sg_poll_image_reads();
     _SG_TRACE_NOARGS(commit);
+    _sg.cur_stats.frame_index = _sg.frame_index;
+    _sg.prev_stats = _sg.cur_stats;
+    _sg_clear(&_sg.cur_stats, sizeof(_sg.cur_stats));
     _sg.frame_index++;
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
     SOKOL_ASSERT(_sg.valid);
     _sg_reset_state_cache();
+    _sg_ub_cache_invalidate();
     _SG_TRACE_NOARGS(reset_state_cache);
 }
 
@@ -16024,18 +17360,121 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
     _SG_TRACE_ARGS(update_image, img_id, data);
 }
 
+SOKOL_API_IMPL sg_range sg_map_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_range res = { 0, 0 };
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        if (_sg_validate_map_image(img)) {
+            SOKOL_ASSERT(img->cmn.upd_frame_index != _sg.frame_index);
+            res = _sg_map_image(img);
+            if (res.ptr) {
+                img->cmn.upd_frame_index = _sg.frame_index;
+            }
+        }
+    }
+    _SG_TRACE_ARGS(map_image, img_id, res);
+    return res;
+}
+
+SOKOL_API_IMPL void sg_unmap_image(sg_image img_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
+        _sg_unmap_image(img);
+    }
+    _SG_TRACE_ARGS(unmap_image, img_id);
+}
+
+_SOKOL_PRIVATE bool _sg_read_image_async(sg_image img_id, const sg_rect* rect, const sg_range* buffer, sg_read_image_callback callback, void* user_data) {
+    if (!_sg.features.image_readback) {
+        return false;
+    }
+    const _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+    if (!(img && (img->slot.state == SG_RESOURCESTATE_VALID))) {
+        return false;
+    }
+    if (!_sg_validate_read_image(img, rect, buffer, callback)) {
+        return false;
+    }
+    int read_index = -1;
+    for (int i = 0; i < SG_MAX_IMAGE_READS; i++) {
+        if (!_sg.image_reads[i].active) {
+            read_index = i;
+            break;
+        }
+    }
+    if (read_index < 0) {
+        return false;
+    }
+    const int row_pitch = _sg_row_pitch(img->cmn.pixel_format, rect->width, 1);
+    const size_t num_bytes = (size_t)row_pitch * (size_t)rect->height;
+    if ((0 == buffer->ptr) || (num_bytes > buffer->size)) {
+        return false;
+    }
+    if (!_sg_read_image(read_index, img, rect, (void*)buffer->ptr, num_bytes)) {
+        return false;
+    }
+    _sg_image_read_t* read = &_sg.image_reads[read_index];
+    _sg_clear(read, sizeof(_sg_image_read_t));
+    read->active = true;
+    read->seq = ++_sg.image_read_seq;
+    read->callback = callback;
+    read->result.image = img_id;
+    read->result.rect = *rect;
+    read->result.pixel_format = img->cmn.pixel_format;
+    read->result.row_pitch = row_pitch;
+    read->result.data.ptr = buffer->ptr;
+    read->result.data.size = num_bytes;
+    read->result.frame_index = _sg.frame_index;
+    read->result.user_data = user_data;
+    return true;
+}
+
+SOKOL_API_IMPL bool sg_read_image_async(sg_image img_id, const sg_rect* rect, const sg_range* buffer, sg_read_image_callback callback, void* user_data) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(rect && buffer);
+    const bool result = _sg_read_image_async(img_id, rect, buffer, callback, user_data);
+    _SG_TRACE_ARGS(read_image_async, img_id, rect, buffer, result);
+    return result;
+}
+
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
-    _SOKOL_UNUSED(name);
+    _sg_timing_begin_scope(name, false);
     _SG_TRACE_ARGS(push_debug_group, name);
 }
 
 SOKOL_API_IMPL void sg_pop_debug_group(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_timing_pop_debug_group();
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
+SOKOL_API_IMPL sg_frame_timings sg_query_frame_timings(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.timing.resolved;
+}
+
+SOKOL_API_IMPL double sg_query_timing(const char* name) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(name);
+    const sg_frame_timings* res = &_sg.timing.resolved;
+    double duration_ms = -1.0;
+    for (int i = 0; i < res->num_scopes; i++) {
+        if (0 == strncmp(res->scopes[i].name, name, SG_TIMING_NAME_SIZE - 1)) {
+            duration_ms = (duration_ms < 0.0) ? res->scopes[i].duration_ms : (duration_ms + res->scopes[i].duration_ms);
+        }
+    }
+    return duration_ms;
+}
+
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.prev_stats;
+}
+
 SOKOL_API_IMPL sg_buffer_info sg_query_buffer_info(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
     sg_buffer_info info;
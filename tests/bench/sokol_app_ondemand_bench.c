@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//  sokol-app-ondemand-bench.c
+//
+//  Measures CPU time, context switches and the number of rendered frames
+//  of a mostly idle sokol_app.h application, once with the default
+//  continuous frame loop and once with sapp_desc.render_on_demand.
+//
+//  The application simulates a typical tool: a text cursor blinks every
+//  500ms (sapp_request_redraw_after()), and a background thread requests
+//  a redraw every 250ms (sapp_request_redraw()).
+//
+//  Needs an X server, for instance:
+//
+//      xvfb-run ./sokol-app-ondemand-bench
+//      xvfb-run ./sokol-app-ondemand-bench ondemand
+//
+//  An optional second argument sets the run time in seconds (default 5).
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#include "sokol_app.h"
+#include "sokol_gfx.h"
+#include "sokol_glue.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#define BLINK_INTERVAL (0.5)
+#define REDRAW_THREAD_INTERVAL_NS (250000000)
+
+static struct {
+    bool on_demand;
+    double run_time;
+    struct timespec start;
+    uint64_t num_frames;
+    bool cursor_visible;
+    volatile bool thread_done;
+    pthread_t thread;
+} state;
+
+static double elapsed(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - state.start.tv_sec) + (double)(now.tv_nsec - state.start.tv_nsec) * 1.0e-9;
+}
+
+static void* redraw_thread(void* arg) {
+    (void)arg;
+    const struct timespec interval = { 0, REDRAW_THREAD_INTERVAL_NS };
+    while (!state.thread_done) {
+        nanosleep(&interval, 0);
+        sapp_request_redraw();
+    }
+    return 0;
+}
+
+static void init(void) {
+    sg_setup(&(sg_desc){ .context = sapp_sgcontext() });
+    clock_gettime(CLOCK_MONOTONIC, &state.start);
+    pthread_create(&state.thread, 0, redraw_thread, 0);
+}
+
+static void frame(void) {
+    state.num_frames++;
+    const double t = elapsed();
+    state.cursor_visible = ((int)(t / BLINK_INTERVAL) & 1) == 0;
+    sg_pass_action pass_action = {
+        .colors[0] = { .action = SG_ACTION_CLEAR, .value = { 0.2f, 0.2f, state.cursor_visible ? 0.6f : 0.2f, 1.0f } }
+    };
+    sg_begin_default_pass(&pass_action, sapp_width(), sapp_height());
+    sg_end_pass();
+    sg_commit();
+    // request the next cursor blink
+    sapp_request_redraw_after(BLINK_INTERVAL - fmod(t, BLINK_INTERVAL));
+    if (t >= state.run_time) {
+        sapp_request_quit();
+    }
+}
+
+static void cleanup(void) {
+    state.thread_done = true;
+    pthread_join(state.thread, 0);
+    sg_shutdown();
+    const double t = elapsed();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    const double cpu_time = (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                            (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1.0e-6;
+    printf("mode: %s\n", state.on_demand ? "render on demand" : "continuous");
+    printf("  run time:          %.2f s\n", t);
+    printf("  frames:            %llu (%.1f per second)\n", (unsigned long long)state.num_frames, (double)state.num_frames / t);
+    printf("  cpu time:          %.3f s (%.1f%% of one core)\n", cpu_time, 100.0 * cpu_time / t);
+    printf("  context switches:  %ld voluntary, %ld involuntary\n", usage.ru_nvcsw, usage.ru_nivcsw);
+}
+
+sapp_desc sokol_main(int argc, char* argv[]) {
+    state.on_demand = (argc > 1) && (0 == strcmp(argv[1], "ondemand"));
+    state.run_time = (argc > 2) ? atof(argv[2]) : 5.0;
+    return (sapp_desc){
+        .init_cb = init,
+        .frame_cb = frame,
+        .cleanup_cb = cleanup,
+        .width = 320,
+        .height = 240,
+        .render_on_demand = state.on_demand,
+        .window_title = "sokol-app-ondemand-bench",
+    };
+}
@@ -0,0 +1,176 @@
+//------------------------------------------------------------------------------
+//  sokol-fetch-bench.c
+//
+//  Measures the throughput and per-request latency of sokol_fetch.h when
+//  loading many small files. The same source is built twice, once with
+//  the regular IO threads (sokol-fetch-bench) and once with io_uring
+//  (sokol-fetch-bench-uring).
+//
+//  The test files are created in a temporary directory, so the data will
+//  usually come from the page cache. Drop the caches between runs to
+//  measure cold reads (needs root):
+//
+//      sync && echo 3 > /proc/sys/vm/drop_caches
+//
+//  Optional arguments: number of files (default 4096), file size in bytes
+//  (default 16384), number of lanes (default 64), number of IO threads
+//  per channel (default 1, ignored with io_uring).
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#include "sokol_fetch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static struct {
+    int num_files;
+    int file_size;
+    int num_lanes;
+    int num_threads;
+    char dir[64];
+    uint8_t* buffers;
+    double* latencies;
+    int num_done;
+    int num_failed;
+    uint64_t num_bytes;
+} state;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+static void file_path(char* buf, size_t buf_size, int index) {
+    snprintf(buf, buf_size, "%s/file%05d.bin", state.dir, index);
+}
+
+static void create_files(void) {
+    strcpy(state.dir, "/tmp/sokol-fetch-bench-XXXXXX");
+    if (0 == mkdtemp(state.dir)) {
+        perror("mkdtemp");
+        exit(10);
+    }
+    uint8_t* data = (uint8_t*) malloc((size_t)state.file_size);
+    for (int i = 0; i < state.file_size; i++) {
+        data[i] = (uint8_t)i;
+    }
+    char path[128];
+    for (int i = 0; i < state.num_files; i++) {
+        file_path(path, sizeof(path), i);
+        FILE* fp = fopen(path, "wb");
+        if (!fp || (fwrite(data, (size_t)state.file_size, 1, fp) != 1)) {
+            perror("fwrite");
+            exit(10);
+        }
+        fclose(fp);
+    }
+    free(data);
+}
+
+static void delete_files(void) {
+    char path[128];
+    for (int i = 0; i < state.num_files; i++) {
+        file_path(path, sizeof(path), i);
+        unlink(path);
+    }
+    rmdir(state.dir);
+}
+
+typedef struct {
+    int index;
+    double send_time;
+} request_t;
+
+static void response_callback(const sfetch_response_t* response) {
+    if (response->finished) {
+        const request_t* req = (const request_t*) response->user_data;
+        state.latencies[req->index] = now() - req->send_time;
+        if (response->failed) {
+            state.num_failed++;
+        }
+        else {
+            state.num_bytes += response->fetched_size;
+        }
+        state.num_done++;
+    }
+}
+
+static int cmp_double(const void* a, const void* b) {
+    const double da = *(const double*)a;
+    const double db = *(const double*)b;
+    return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+static void print_latency(const char* name, const sfetch_latency_t* l) {
+    printf("  %-16s avg %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+        name, 1000.0 * l->avg, 1000.0 * l->p50, 1000.0 * l->p99, 1000.0 * l->max);
+}
+
+int main(int argc, char* argv[]) {
+    state.num_files = (argc > 1) ? atoi(argv[1]) : 4096;
+    state.file_size = (argc > 2) ? atoi(argv[2]) : 16384;
+    state.num_lanes = (argc > 3) ? atoi(argv[3]) : 64;
+    state.num_threads = (argc > 4) ? atoi(argv[4]) : 1;
+    create_files();
+    state.buffers = (uint8_t*) malloc((size_t)state.num_files * (size_t)state.file_size);
+    state.latencies = (double*) calloc((size_t)state.num_files, sizeof(double));
+
+    sfetch_setup(&(sfetch_desc_t){
+        .max_requests = (uint32_t)state.num_files,
+        .num_channels = 1,
+        .num_lanes = (uint32_t)state.num_lanes,
+        .num_threads = (uint32_t)state.num_threads,
+    });
+    const double start = now();
+    char path[128];
+    for (int i = 0; i < state.num_files; i++) {
+        file_path(path, sizeof(path), i);
+        const request_t req = { .index = i, .send_time = now() };
+        sfetch_send(&(sfetch_request_t){
+            .path = path,
+            .callback = response_callback,
+            .buffer_ptr = state.buffers + (size_t)i * (size_t)state.file_size,
+            .buffer_size = (uint64_t)state.file_size,
+            .user_data_ptr = &req,
+            .user_data_size = sizeof(req),
+        });
+    }
+    // no sleep between sfetch_dowork() calls, this measures the IO side and not the frame rate
+    while (state.num_done < state.num_files) {
+        sfetch_dowork();
+    }
+    const double elapsed = now() - start;
+    const sfetch_stats_t stats = sfetch_query_stats(0);
+    sfetch_shutdown();
+
+    qsort(state.latencies, (size_t)state.num_files, sizeof(double), cmp_double);
+    double sum = 0.0;
+    for (int i = 0; i < state.num_files; i++) {
+        sum += state.latencies[i];
+    }
+    #if defined(SFETCH_USE_IO_URING)
+    printf("backend: io_uring\n");
+    #else
+    printf("backend: IO threads (%d per channel)\n", state.num_threads);
+    #endif
+    printf("  files:      %d x %d bytes, %d lanes, %d failed\n", state.num_files, state.file_size, state.num_lanes, state.num_failed);
+    printf("  run time:   %.3f s\n", elapsed);
+    printf("  throughput: %.0f files/s, %.1f MB/s\n", (double)state.num_files / elapsed, (double)state.num_bytes / (elapsed * 1024.0 * 1024.0));
+    printf("  latency:    avg %.3f ms, p50 %.3f ms, p99 %.3f ms\n",
+        1000.0 * sum / state.num_files,
+        1000.0 * state.latencies[state.num_files / 2],
+        1000.0 * state.latencies[(state.num_files * 99) / 100]);
+    // where the time goes, according to sokol_fetch.h itself
+    printf("  lane utilization: %.1f%%\n", 100.0 * stats.lane_utilization);
+    print_latency("queue wait:", &stats.queue_wait);
+    print_latency("IO time:", &stats.io_time);
+    print_latency("callback wait:", &stats.callback_wait);
+
+    free(state.latencies);
+    free(state.buffers);
+    delete_files();
+    return (state.num_failed == 0) ? 0 : 10;
+}
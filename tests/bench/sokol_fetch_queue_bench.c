@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+//  sokol-fetch-queue-bench.c
+//
+//  Measures the number of requests per second sokol_fetch.h can move
+//  through its message queues. The requests load tiny files from a
+//  mounted pack file, so that there's no file open/close per request
+//  and the per-request overhead of the user thread <=> IO thread
+//  handoff dominates.
+//
+//  Optional arguments: number of requests (default 200000), number of
+//  lanes (default 32), number of IO threads per channel (default 1).
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#include "sokol_fetch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#define NUM_FILES (64)
+#define FILE_SIZE (16)
+#define PACK_PATH "sokol-fetch-queue-bench.pack"
+
+static struct {
+    int num_requests;
+    int num_lanes;
+    int num_threads;
+    int num_sent;
+    int num_done;
+    int num_failed;
+    uint8_t buffers[1024][FILE_SIZE];
+} state;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+static uint64_t path_hash(const char* str) {
+    uint64_t hash = 0xCBF29CE484222325;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+static void put(FILE* fp, uint64_t val, int num_bytes) {
+    for (int i = 0; i < num_bytes; i++) {
+        fputc((int)((val >> (i * 8)) & 0xFF), fp);
+    }
+}
+
+static void file_path(char* buf, size_t buf_size, int index) {
+    snprintf(buf, buf_size, "file%02d.bin", index);
+}
+
+static int cmp_hash(const void* a, const void* b) {
+    const uint64_t ha = *(const uint64_t*)a;
+    const uint64_t hb = *(const uint64_t*)b;
+    return (ha < hb) ? -1 : ((ha > hb) ? 1 : 0);
+}
+
+// see util/sokol_fetch_pack.py for the file format
+static void write_pack(void) {
+    uint64_t hashes[NUM_FILES];
+    char path[32];
+    for (int i = 0; i < NUM_FILES; i++) {
+        file_path(path, sizeof(path), i);
+        hashes[i] = path_hash(path);
+    }
+    qsort(hashes, NUM_FILES, sizeof(uint64_t), cmp_hash);
+    FILE* fp = fopen(PACK_PATH, "wb");
+    if (!fp) {
+        perror("fopen");
+        exit(10);
+    }
+    put(fp, 0x4B504653, 4);
+    put(fp, 1, 4);
+    put(fp, NUM_FILES, 4);
+    put(fp, 0, 4);
+    const uint64_t data_offset = 16 + NUM_FILES * 32;
+    for (int i = 0; i < NUM_FILES; i++) {
+        put(fp, hashes[i], 8);
+        put(fp, data_offset + (uint64_t)i * FILE_SIZE, 8);
+        put(fp, FILE_SIZE, 8);
+        put(fp, 0, 8);
+    }
+    for (int i = 0; i < NUM_FILES * FILE_SIZE; i++) {
+        fputc(i & 0xFF, fp);
+    }
+    fclose(fp);
+}
+
+static void response_callback(const sfetch_response_t* response) {
+    if (response->finished) {
+        if (response->failed) {
+            state.num_failed++;
+        }
+        state.num_done++;
+    }
+}
+
+static void send_requests(void) {
+    // keep the lanes busy, but don't flood the request pool
+    char path[32];
+    while ((state.num_sent < state.num_requests) && ((state.num_sent - state.num_done) < 1024)) {
+        file_path(path, sizeof(path), state.num_sent % NUM_FILES);
+        sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+            .path = path,
+            .callback = response_callback,
+            .buffer_ptr = state.buffers[state.num_sent % 1024],
+            .buffer_size = FILE_SIZE,
+        });
+        if (0 == h.id) {
+            break;
+        }
+        state.num_sent++;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    state.num_requests = (argc > 1) ? atoi(argv[1]) : 200000;
+    state.num_lanes = (argc > 2) ? atoi(argv[2]) : 32;
+    state.num_threads = (argc > 3) ? atoi(argv[3]) : 1;
+    write_pack();
+    sfetch_setup(&(sfetch_desc_t){
+        .max_requests = 2048,
+        .num_channels = 1,
+        .num_lanes = (uint32_t)state.num_lanes,
+        .num_threads = (uint32_t)state.num_threads,
+    });
+    if (!sfetch_mount(PACK_PATH)) {
+        fprintf(stderr, "failed to mount pack file\n");
+        return 10;
+    }
+    struct rusage usage_start, usage_end;
+    getrusage(RUSAGE_SELF, &usage_start);
+    const double start = now();
+    uint64_t num_frames = 0;
+    while (state.num_done < state.num_requests) {
+        send_requests();
+        sfetch_dowork();
+        num_frames++;
+    }
+    const double elapsed = now() - start;
+    getrusage(RUSAGE_SELF, &usage_end);
+    sfetch_shutdown();
+    remove(PACK_PATH);
+
+    const long ctx_switches = (usage_end.ru_nvcsw - usage_start.ru_nvcsw) + (usage_end.ru_nivcsw - usage_start.ru_nivcsw);
+    printf("requests: %d x %d bytes, %d lanes, %d IO threads, %d failed\n", state.num_requests, FILE_SIZE, state.num_lanes, state.num_threads, state.num_failed);
+    printf("  run time:          %.3f s (%llu sfetch_dowork() calls)\n", elapsed, (unsigned long long)num_frames);
+    printf("  throughput:        %.0f requests/s\n", (double)state.num_requests / elapsed);
+    printf("  context switches:  %ld (%.2f per request)\n", ctx_switches, (double)ctx_switches / state.num_requests);
+    return (state.num_failed == 0) ? 0 : 10;
+}
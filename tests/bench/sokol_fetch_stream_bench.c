@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//  sokol-fetch-stream-bench.c
+//
+//  Measures how long it takes to stream a big file through a response
+//  callback which does some work per chunk (simulated by a busy loop),
+//  with and without request.readahead. Without readahead, reading and
+//  processing alternate, with readahead the next chunk is read while the
+//  callback processes the current chunk.
+//
+//  The file is evicted from the page cache before each run with
+//  posix_fadvise(POSIX_FADV_DONTNEED), so that the reads actually go to
+//  the storage device (this doesn't need root, but doesn't work on all
+//  file systems, e.g. not on tmpfs).
+//
+//  Optional arguments: file size in MB (default 256), chunk size in KB
+//  (default 1024), simulated work per chunk in microseconds (default 2000),
+//  directory for the test file (default: current directory).
+//------------------------------------------------------------------------------
+#define SOKOL_IMPL
+#include "sokol_fetch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static struct {
+    uint64_t file_size;
+    uint32_t chunk_size;
+    double work_time;
+    char path[1024];
+    uint8_t* buffer;
+    uint64_t num_bytes;
+    uint64_t num_chunks;
+    uint32_t checksum;
+    bool finished;
+    bool failed;
+} state;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+static void create_file(void) {
+    const size_t block_size = 1024 * 1024;
+    uint8_t* data = (uint8_t*) malloc(block_size);
+    for (size_t i = 0; i < block_size; i++) {
+        data[i] = (uint8_t)(i ^ (i >> 12));
+    }
+    FILE* fp = fopen(state.path, "wb");
+    if (!fp) {
+        perror("fopen");
+        exit(10);
+    }
+    for (uint64_t pos = 0; pos < state.file_size; pos += block_size) {
+        if (fwrite(data, block_size, 1, fp) != 1) {
+            perror("fwrite");
+            exit(10);
+        }
+    }
+    fclose(fp);
+    free(data);
+}
+
+// the pages must be written back before they can be dropped
+static void evict_file(void) {
+    int fd = open(state.path, O_RDONLY);
+    if (fd < 0) {
+        perror("open");
+        exit(10);
+    }
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static void response_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        // touch the data, and burn the rest of the per-chunk work time
+        const double start = now();
+        const uint8_t* ptr = (const uint8_t*)response->buffer_ptr;
+        for (uint64_t i = 0; i < response->fetched_size; i += 4096) {
+            state.checksum += ptr[i];
+        }
+        while ((now() - start) < state.work_time) {
+        }
+        state.num_bytes += response->fetched_size;
+        state.num_chunks++;
+    }
+    if (response->finished) {
+        state.failed = response->failed;
+        state.finished = true;
+    }
+}
+
+static double run(bool readahead) {
+    evict_file();
+    state.num_bytes = 0;
+    state.num_chunks = 0;
+    state.finished = false;
+    state.failed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_channels = 1, .num_lanes = 1 });
+    const double start = now();
+    sfetch_send(&(sfetch_request_t){
+        .path = state.path,
+        .callback = response_callback,
+        .buffer_ptr = state.buffer,
+        .buffer_size = 2 * (uint64_t)state.chunk_size,
+        .chunk_size = state.chunk_size,
+        .readahead = readahead,
+    });
+    while (!state.finished) {
+        sfetch_dowork();
+    }
+    const double elapsed = now() - start;
+    sfetch_shutdown();
+    if (state.failed || (state.num_bytes != state.file_size)) {
+        fprintf(stderr, "streaming failed\n");
+        exit(10);
+    }
+    return elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    state.file_size = (uint64_t)((argc > 1) ? atoi(argv[1]) : 256) * 1024 * 1024;
+    state.chunk_size = (uint32_t)((argc > 2) ? atoi(argv[2]) : 1024) * 1024;
+    state.work_time = (double)((argc > 3) ? atoi(argv[3]) : 2000) * 1.0e-6;
+    snprintf(state.path, sizeof(state.path), "%s/sokol-fetch-stream-bench.bin", (argc > 4) ? argv[4] : ".");
+    state.buffer = (uint8_t*) malloc(2 * (size_t)state.chunk_size);
+    create_file();
+    const double t_off = run(false);
+    const double t_on = run(true);
+    remove(state.path);
+    free(state.buffer);
+
+    const double mb = (double)state.file_size / (1024.0 * 1024.0);
+    const double t_work = (double)state.num_chunks * state.work_time;
+    printf("streaming %.0f MB in %u KB chunks, %.0f us work per chunk (%.3f s total)\n", mb, state.chunk_size / 1024, state.work_time * 1.0e6, t_work);
+    printf("  without readahead: %.3f s (%.1f MB/s)\n", t_off, mb / t_off);
+    printf("  with readahead:    %.3f s (%.1f MB/s)\n", t_on, mb / t_on);
+    printf("  checksum: %u\n", state.checksum);
+    return 0;
+}
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+//  sokol-gfx-pipeline-bench.c
+//
+//  Measures the CPU cost of switching between N pipeline objects with
+//  different render states on the GL backend (sg_apply_pipeline() followed
+//  by a small draw call), reported as nanoseconds per switch.
+//
+//  Runs headless through an EGL surfaceless context (requires the
+//  EGL_MESA_platform_surfaceless extension, e.g. Mesa's llvmpipe driver).
+//------------------------------------------------------------------------------
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define SOKOL_IMPL
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#include <stdio.h>
+
+#define MAX_PIPELINES (64)
+#define NUM_SWITCHES (20000)
+#define NUM_DRAW_SWITCHES (2000)
+#define NUM_FRAMES (10)
+
+static sg_pass pass;
+static sg_shader shd;
+static sg_buffer vbuf;
+
+static bool init_egl(void) {
+    EGLDisplay dpy = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if ((dpy == EGL_NO_DISPLAY) || !eglInitialize(dpy, 0, 0) || !eglBindAPI(EGL_OPENGL_API)) {
+        return false;
+    }
+    const EGLint ctx_attrs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext ctx = eglCreateContext(dpy, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, ctx_attrs);
+    if (ctx == EGL_NO_CONTEXT) {
+        return false;
+    }
+    return eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx);
+}
+
+// pipelines which differ in one render state group each (like typical
+// material variations), so most groups stay the same between switches
+static sg_pipeline make_pipeline(int index) {
+    sg_pipeline_desc desc = {
+        .shader = shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT2,
+        .depth = {
+            .pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL,
+            .compare = SG_COMPAREFUNC_LESS_EQUAL,
+            .write_enabled = true,
+        },
+    };
+    switch (index % 6) {
+        case 0:
+            break;
+        case 1:
+            desc.colors[0].blend = (sg_blend_state){
+                .enabled = true,
+                .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+                .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+            };
+            desc.depth.write_enabled = false;
+            break;
+        case 2:
+            desc.cull_mode = SG_CULLMODE_BACK;
+            break;
+        case 3:
+            desc.stencil = (sg_stencil_state){
+                .enabled = true,
+                .front = { .compare = SG_COMPAREFUNC_EQUAL },
+                .back = { .compare = SG_COMPAREFUNC_EQUAL },
+                .read_mask = 0xFF,
+                .ref = 1,
+            };
+            break;
+        case 4:
+            desc.colors[0].write_mask = SG_COLORMASK_RGB;
+            break;
+        case 5:
+            desc.depth.bias = 1.0f;
+            desc.depth.bias_slope_scale = 1.0f;
+            break;
+    }
+    return sg_make_pipeline(&desc);
+}
+
+static void bench(int num_pipelines, bool with_draw) {
+    sg_pipeline pips[MAX_PIPELINES];
+    for (int i = 0; i < num_pipelines; i++) {
+        pips[i] = make_pipeline(i);
+    }
+    const int num_switches = with_draw ? NUM_DRAW_SWITCHES : NUM_SWITCHES;
+    double best_sec = 1.0e9;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        sg_begin_pass(pass, &(sg_pass_action){0});
+        const uint64_t start = stm_now();
+        for (int i = 0; i < num_switches; i++) {
+            sg_apply_pipeline(pips[i % num_pipelines]);
+            if (with_draw) {
+                sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf });
+                sg_draw(0, 3, 1);
+            }
+        }
+        const double sec = stm_sec(stm_since(start));
+        sg_end_pass();
+        sg_commit();
+        if (sec < best_sec) {
+            best_sec = sec;
+        }
+    }
+    for (int i = 0; i < num_pipelines; i++) {
+        sg_destroy_pipeline(pips[i]);
+    }
+    printf("%3d pipelines, %-12s %8.1f ns per switch\n",
+        num_pipelines, with_draw ? "with draw:" : "apply only:", (best_sec * 1.0e9) / num_switches);
+}
+
+int main(void) {
+    if (!init_egl()) {
+        printf("failed to create EGL surfaceless context\n");
+        return 10;
+    }
+    stm_setup();
+    sg_setup(&(sg_desc){ .pipeline_pool_size = MAX_PIPELINES + 1 });
+    sg_image_desc img_desc = { .render_target = true, .width = 64, .height = 64 };
+    sg_image color_img = sg_make_image(&img_desc);
+    img_desc.pixel_format = SG_PIXELFORMAT_DEPTH_STENCIL;
+    sg_image depth_img = sg_make_image(&img_desc);
+    pass = sg_make_pass(&(sg_pass_desc){
+        .color_attachments[0].image = color_img,
+        .depth_stencil_attachment.image = depth_img,
+    });
+    shd = sg_make_shader(&(sg_shader_desc){
+        .attrs[0].name = "pos",
+        .vs.source =
+            "#version 330\n"
+            "in vec2 pos;\n"
+            "void main() {\n"
+            "  gl_Position = vec4(pos, 0.5, 1.0);\n"
+            "}\n",
+        .fs.source =
+            "#version 330\n"
+            "out vec4 frag_color;\n"
+            "void main() {\n"
+            "  frag_color = vec4(1.0, 0.5, 0.25, 0.5);\n"
+            "}\n",
+    });
+    // a tiny triangle, so that rasterization cost doesn't dominate
+    const float vertices[] = { 0.0f, 0.0f, 0.01f, 0.0f, 0.0f, 0.01f };
+    vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+    const int num_pipelines[] = { 2, 8, 64 };
+    for (int i = 0; i < 3; i++) {
+        bench(num_pipelines[i], false);
+        bench(num_pipelines[i], true);
+    }
+    sg_shutdown();
+    return 0;
+}
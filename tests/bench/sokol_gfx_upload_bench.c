@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//  sokol-gfx-upload-bench.c
+//
+//  Measures dynamic texture upload throughput (MB/s, based on the time
+//  spent inside sokol-gfx calls) and the resulting CPU frame time
+//  (including generating the pixel data) of the GL backend when a large
+//  texture is updated and sampled each frame, with and without
+//  sg_image_desc.gl_pbo_streaming.
+//
+//  Runs headless through an EGL surfaceless context (requires the
+//  EGL_MESA_platform_surfaceless extension, e.g. Mesa's llvmpipe driver).
+//------------------------------------------------------------------------------
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define SOKOL_IMPL
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_FRAMES (60)
+
+typedef enum {
+    MODE_UPDATE,        // sg_update_image() from client memory
+    MODE_PBO_UPDATE,    // sg_update_image() through pixel unpack buffers
+    MODE_PBO_MAP,       // write directly into the mapped pixel unpack buffer
+} mode_t_;
+
+static const char* mode_names[] = { "update", "pbo update", "pbo map" };
+
+static uint8_t* pixels;
+
+static bool init_egl(void) {
+    EGLDisplay dpy = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if ((dpy == EGL_NO_DISPLAY) || !eglInitialize(dpy, 0, 0) || !eglBindAPI(EGL_OPENGL_API)) {
+        return false;
+    }
+    const EGLint ctx_attrs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext ctx = eglCreateContext(dpy, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, ctx_attrs);
+    if (ctx == EGL_NO_CONTEXT) {
+        return false;
+    }
+    return eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx);
+}
+
+// generate new frame content, touches all bytes like a video decoder would
+static void generate(uint8_t* dst, size_t size, int frame) {
+    uint32_t* p = (uint32_t*) dst;
+    const uint32_t v = 0xFF000000 | (uint32_t)(frame * 0x010203);
+    for (size_t i = 0; i < size / 4; i++) {
+        p[i] = v ^ (uint32_t)i;
+    }
+}
+
+static void bench(int width, int height, mode_t_ mode) {
+    const size_t size = (size_t)(width * height * 4);
+    sg_image img = sg_make_image(&(sg_image_desc){
+        .usage = SG_USAGE_STREAM,
+        .width = width,
+        .height = height,
+        .gl_pbo_streaming = mode != MODE_UPDATE,
+    });
+    // sample the texture into a small render target so the upload must complete each frame
+    sg_image rt = sg_make_image(&(sg_image_desc){ .render_target = true, .width = 64, .height = 64 });
+    sg_pass pass = sg_make_pass(&(sg_pass_desc){ .color_attachments[0].image = rt });
+    sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .attrs[0].name = "pos",
+        .vs.source =
+            "#version 330\n"
+            "in vec2 pos;\n"
+            "out vec2 uv;\n"
+            "void main() {\n"
+            "  uv = pos * 0.5 + 0.5;\n"
+            "  gl_Position = vec4(pos, 0.0, 1.0);\n"
+            "}\n",
+        .fs = {
+            .images[0] = { .name = "tex", .image_type = SG_IMAGETYPE_2D },
+            .source =
+                "#version 330\n"
+                "uniform sampler2D tex;\n"
+                "in vec2 uv;\n"
+                "out vec4 frag_color;\n"
+                "void main() {\n"
+                "  frag_color = texture(tex, uv);\n"
+                "}\n",
+        },
+    });
+    sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .shader = shd,
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT2,
+        .depth.pixel_format = SG_PIXELFORMAT_NONE,
+    });
+    // a single fullscreen triangle
+    const float vertices[] = { -1.0f, -1.0f, 3.0f, -1.0f, -1.0f, 3.0f };
+    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices) });
+
+    double upload_sec = 0.0;
+    double frame_sec = 0.0;
+    for (int frame = 0; frame < NUM_FRAMES + 2; frame++) {
+        const uint64_t frame_start = stm_now();
+        // upload time only counts the time spent inside sokol-gfx
+        uint64_t upload_ticks = 0;
+        if (mode == MODE_PBO_MAP) {
+            uint64_t start = stm_now();
+            sg_range dst = sg_map_image(img);
+            upload_ticks += stm_since(start);
+            if (dst.ptr) {
+                generate((uint8_t*)dst.ptr, dst.size, frame);
+                start = stm_now();
+                sg_unmap_image(img);
+                upload_ticks += stm_since(start);
+            }
+        }
+        else {
+            generate(pixels, size, frame);
+            const uint64_t start = stm_now();
+            sg_update_image(img, &(sg_image_data){ .subimage[0][0] = { .ptr = pixels, .size = size } });
+            upload_ticks = stm_since(start);
+        }
+        const double upload = stm_sec(upload_ticks);
+        sg_begin_pass(pass, &(sg_pass_action){0});
+        sg_apply_pipeline(pip);
+        sg_apply_bindings(&(sg_bindings){ .vertex_buffers[0] = vbuf, .fs_images[0] = img });
+        sg_draw(0, 3, 1);
+        sg_end_pass();
+        sg_commit();
+        // skip the first frames to exclude resource setup cost
+        if (frame >= 2) {
+            upload_sec += upload;
+            frame_sec += stm_sec(stm_since(frame_start));
+        }
+    }
+    sg_destroy_buffer(vbuf);
+    sg_destroy_pipeline(pip);
+    sg_destroy_shader(shd);
+    sg_destroy_pass(pass);
+    sg_destroy_image(rt);
+    sg_destroy_image(img);
+    const double mb = (double)size * NUM_FRAMES / (1024.0 * 1024.0);
+    printf("%4dx%-4d %-12s upload: %8.1f MB/s   frame time: %7.2f ms\n",
+        width, height, mode_names[mode], mb / upload_sec, (frame_sec * 1000.0) / NUM_FRAMES);
+}
+
+int main(void) {
+    if (!init_egl()) {
+        printf("failed to create EGL surfaceless context\n");
+        return 10;
+    }
+    stm_setup();
+    sg_setup(&(sg_desc){0});
+    pixels = (uint8_t*) malloc(3840 * 2160 * 4);
+    if (!pixels) {
+        return 10;
+    }
+    for (int mode = MODE_UPDATE; mode <= MODE_PBO_MAP; mode++) {
+        bench(1920, 1080, (mode_t_)mode);
+    }
+    for (int mode = MODE_UPDATE; mode <= MODE_PBO_MAP; mode++) {
+        bench(3840, 2160, (mode_t_)mode);
+    }
+    free(pixels);
+    sg_shutdown();
+    return 0;
+}
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+//  sokol-pixconv-bench.c
+//
+//  Measures the throughput of the sokol_pixconv.h conversion functions
+//  in GB/s (bytes read plus bytes written per second). Build with
+//  different SIMD compile options to compare code paths.
+//------------------------------------------------------------------------------
+#include "sokol_gfx.h"
+#define SOKOL_IMPL
+#include "sokol_pixconv.h"
+#include "sokol_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WIDTH (2048)
+#define HEIGHT (2048)
+#define NUM_PIXELS ((size_t)WIDTH * HEIGHT)
+#define NUM_ITERS (20)
+
+static uint8_t* src;
+static uint8_t* dst;
+
+typedef void (*convert_func_t)(void* dst, const void* src, size_t num_pixels);
+
+static void f32_to_f16_rgba(void* d, const void* s, size_t num_pixels) {
+    spconv_f32_to_f16(d, (const float*)s, num_pixels * 4);
+}
+
+static void swap_u16_rgba(void* d, const void* s, size_t num_pixels) {
+    spconv_swap_u16(d, s, num_pixels * 4);
+}
+
+static void bench(const char* name, convert_func_t func, size_t src_pixel_size, size_t dst_pixel_size) {
+    // warm up caches and page mappings
+    func(dst, src, NUM_PIXELS);
+    double best_sec = 1.0e9;
+    for (int i = 0; i < NUM_ITERS; i++) {
+        const uint64_t start = stm_now();
+        func(dst, src, NUM_PIXELS);
+        const double sec = stm_sec(stm_since(start));
+        if (sec < best_sec) {
+            best_sec = sec;
+        }
+    }
+    const double bytes = (double)(NUM_PIXELS * (src_pixel_size + dst_pixel_size));
+    printf("%-36s %8.3f ms  %7.2f GB/s\n", name, best_sec * 1000.0, (bytes / best_sec) / 1.0e9);
+}
+
+int main(void) {
+    stm_setup();
+    src = (uint8_t*) malloc(NUM_PIXELS * 16);
+    dst = (uint8_t*) malloc(NUM_PIXELS * 16);
+    if (!src || !dst) {
+        return 10;
+    }
+    float* fsrc = (float*) src;
+    for (size_t i = 0; i < NUM_PIXELS * 4; i++) {
+        fsrc[i] = (float)(i & 0xFFFF) / 4096.0f;
+    }
+    memset(dst, 0, NUM_PIXELS * 16);
+
+    printf("sokol_pixconv.h (%s), %dx%d pixels, best of %d runs\n\n", spconv_query_simd(), WIDTH, HEIGHT, NUM_ITERS);
+    bench("rgb8_to_rgba8", spconv_rgb8_to_rgba8, 3, 4);
+    bench("bgra8_to_rgba8", spconv_bgra8_to_rgba8, 4, 4);
+    bench("f32_to_f16 (RGBA32F => RGBA16F)", f32_to_f16_rgba, 16, 8);
+    bench("swap_u16 (RGBA16 big-endian)", swap_u16_rgba, 8, 8);
+    bench("premultiply_rgba8", spconv_premultiply_rgba8, 4, 4);
+    bench("srgb_to_linear_rgba8", spconv_srgb_to_linear_rgba8, 4, 4);
+    bench("linear_to_srgb_rgba8", spconv_linear_to_srgb_rgba8, 4, 4);
+    bench("srgb_rgba8_to_linear_rgba16f", spconv_srgb_rgba8_to_linear_rgba16f, 4, 8);
+    free(src);
+    free(dst);
+    return 0;
+}
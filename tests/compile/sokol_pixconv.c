@@ -0,0 +1,9 @@
+#include "sokol_gfx.h"
+#define SOKOL_IMPL
+#include "sokol_pixconv.h"
+
+void use_pixconv_impl(void) {
+    uint8_t src[3] = { 0 };
+    uint8_t dst[4] = { 0 };
+    spconv_rgb8_to_rgba8(dst, src, 1);
+}
@@ -0,0 +1,8 @@
+#include "sokol_gfx.h"
+#define SOKOL_IMPL
+#include "sokol_texfile.h"
+
+void use_texfile_impl(void) {
+    static const uint8_t data[4] = { 0 };
+    stexf_parse(&(sg_range){ data, sizeof(data) });
+}
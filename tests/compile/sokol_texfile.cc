@@ -0,0 +1,9 @@
+#include "sokol_gfx.h"
+#define SOKOL_IMPL
+#include "sokol_texfile.h"
+
+void use_texfile_impl() {
+    static const uint8_t data[4] = { 0 };
+    const sg_range range = { data, sizeof(data) };
+    stexf_parse(&range);
+}
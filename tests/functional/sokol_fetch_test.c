@@ -8,6 +8,7 @@
 #define SFETCH_MAX_PATH (32)
 #include "sokol_fetch.h"
 #include "utest.h"
+#include <stdio.h>
 
 #define T(b) EXPECT_TRUE(b)
 #define TSTR(s0, s1) EXPECT_TRUE(0 == strcmp(s0,s1))
@@ -320,14 +321,15 @@ UTEST(sokol_fetch, channel_init_discard) {
     _sfetch_channel_t chn = {0};
     const uint32_t num_slots = 12;
     const uint32_t num_lanes = 64;
-    _sfetch_channel_init(&chn, 0, num_slots, num_lanes, channel_worker);
+    _sfetch_channel_init(&chn, 0, num_slots, num_lanes, 1, channel_worker);
     T(chn.valid);
     T(_sfetch_ring_full(&chn.free_lanes));
     T(_sfetch_ring_empty(&chn.user_sent));
     T(_sfetch_ring_empty(&chn.user_incoming));
     #if !defined(__EMSCRIPTEN__)
-    T(_sfetch_ring_empty(&chn.thread_incoming));
-    T(_sfetch_ring_empty(&chn.thread_outgoing));
+    T(chn.thread.num_threads == 1);
+    T(_sfetch_ring_empty(&chn.thread.workers[0].incoming));
+    T(_sfetch_ring_empty(&chn.thread.workers[0].outgoing));
     #endif
     T(_sfetch_ring_empty(&chn.user_outgoing));
     _sfetch_channel_discard(&chn);
@@ -818,3 +820,1051 @@ UTEST(sokol_fetch, load_file_cancel) {
     sfetch_shutdown();
 }
 
+
+/* load a file via memory mapping, once as a whole and once in chunks, and
+   compare with the content loaded into a regular buffer
+*/
+static bool load_file_mapped_passed;
+static uint8_t load_file_mapped_content[500000];
+static void load_file_mapped_callback(const sfetch_response_t* response) {
+    if (response->dispatched) {
+        // memory-mapped requests don't need a buffer
+        load_file_mapped_passed = false;
+        return;
+    }
+    if (response->fetched && response->finished) {
+        if ((response->fetched_offset == 0) &&
+            (response->fetched_size == combatsignal_file_size) &&
+            (response->buffer_ptr != 0) &&
+            (response->buffer_size == combatsignal_file_size))
+        {
+            memcpy(load_file_mapped_content, response->buffer_ptr, response->fetched_size);
+            load_file_mapped_passed = true;
+        }
+    }
+}
+
+static bool load_file_mapped_chunked_passed;
+static int load_file_mapped_chunked_num_chunks;
+static void load_file_mapped_chunked_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if ((response->buffer_ptr == 0) || (response->fetched_size > 7000)) {
+            return;
+        }
+        memcpy(&load_file_chunked_content[response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        load_file_mapped_chunked_num_chunks++;
+        if (response->finished) {
+            load_file_mapped_chunked_passed = true;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_file_mapped) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_file_mapped_content, 0, sizeof(load_file_mapped_content));
+    memset(load_file_chunked_content, 0, sizeof(load_file_chunked_content));
+    load_file_fixed_buffer_passed = false;
+    load_file_mapped_passed = false;
+    load_file_mapped_chunked_passed = false;
+    load_file_mapped_chunked_num_chunks = 0;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 3 });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mapped_callback,
+        .memory_mapped = true
+    });
+    // a chunk size which isn't a multiple of the page size
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mapped_chunked_callback,
+        .chunk_size = 7000,
+        .memory_mapped = true
+    });
+    sfetch_handle_t h2 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf)
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1) || sfetch_handle_valid(h2)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_fixed_buffer_passed);
+    T(load_file_mapped_passed);
+    T(load_file_mapped_chunked_passed);
+    T(load_file_mapped_chunked_num_chunks == (int)((combatsignal_file_size + 6999) / 7000));
+    T(0 == memcmp(load_file_mapped_content, load_file_buf, combatsignal_file_size));
+    T(0 == memcmp(load_file_chunked_content, load_file_buf, combatsignal_file_size));
+    sfetch_shutdown();
+}
+
+/* cancel a memory-mapped streaming request after the first chunk */
+static bool load_file_mapped_cancel_passed;
+static void load_file_mapped_cancel_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        sfetch_cancel(response->handle);
+    }
+    if (response->failed) {
+        if (response->cancelled && response->finished && (response->error_code == SFETCH_ERROR_CANCELLED)) {
+            load_file_mapped_cancel_passed = true;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_file_mapped_cancel) {
+    load_file_mapped_cancel_passed = false;
+    sfetch_setup(&(sfetch_desc_t){0});
+    sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_mapped_cancel_callback,
+        .chunk_size = 8192,
+        .memory_mapped = true
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (sfetch_handle_valid(h) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_mapped_cancel_passed);
+    sfetch_shutdown();
+}
+
+/* load the file from an offset, once as a whole and once in chunks */
+#define LOAD_FILE_OFFSET (100000)
+static bool load_file_offset_passed;
+static uint8_t load_file_offset_content[500000];
+static void load_file_offset_callback(const sfetch_response_t* response) {
+    if (response->fetched && response->finished) {
+        if ((response->fetched_offset == LOAD_FILE_OFFSET) &&
+            (response->fetched_size == (combatsignal_file_size - LOAD_FILE_OFFSET)))
+        {
+            memcpy(load_file_offset_content, response->buffer_ptr, response->fetched_size);
+            load_file_offset_passed = true;
+        }
+    }
+}
+
+static bool load_file_offset_chunked_passed;
+static uint64_t load_file_offset_chunked_min_offset;
+static void load_file_offset_chunked_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if (response->fetched_offset < load_file_offset_chunked_min_offset) {
+            load_file_offset_chunked_min_offset = response->fetched_offset;
+        }
+        memcpy(&load_file_chunked_content[response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        if (response->finished) {
+            load_file_offset_chunked_passed = true;
+        }
+    }
+}
+
+static bool load_file_offset_eof_passed;
+static void load_file_offset_eof_callback(const sfetch_response_t* response) {
+    if (response->failed && response->finished && (response->error_code == SFETCH_ERROR_UNEXPECTED_EOF)) {
+        load_file_offset_eof_passed = true;
+    }
+}
+
+UTEST(sokol_fetch, load_file_offset) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_chunk_buf, 0, sizeof(load_chunk_buf));
+    memset(load_file_offset_content, 0, sizeof(load_file_offset_content));
+    memset(load_file_chunked_content, 0, sizeof(load_file_chunked_content));
+    load_file_fixed_buffer_passed = false;
+    load_file_offset_passed = false;
+    load_file_offset_chunked_passed = false;
+    load_file_offset_chunked_min_offset = UINT64_MAX;
+    load_file_offset_eof_passed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 4 });
+    static uint8_t offset_buf[500000];
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_offset_callback,
+        .buffer_ptr = offset_buf,
+        .buffer_size = sizeof(offset_buf),
+        .offset = LOAD_FILE_OFFSET
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_offset_chunked_callback,
+        .buffer_ptr = load_chunk_buf,
+        .buffer_size = sizeof(load_chunk_buf),
+        .chunk_size = sizeof(load_chunk_buf),
+        .offset = LOAD_FILE_OFFSET
+    });
+    sfetch_handle_t h2 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf)
+    });
+    sfetch_handle_t h3 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_offset_eof_callback,
+        .buffer_ptr = load_file_too_small_buf,
+        .buffer_size = sizeof(load_file_too_small_buf),
+        .offset = combatsignal_file_size + 1
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1) || sfetch_handle_valid(h2) || sfetch_handle_valid(h3)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_fixed_buffer_passed);
+    T(load_file_offset_passed);
+    T(load_file_offset_chunked_passed);
+    T(load_file_offset_eof_passed);
+    T(load_file_offset_chunked_min_offset == LOAD_FILE_OFFSET);
+    const uint64_t num_bytes = combatsignal_file_size - LOAD_FILE_OFFSET;
+    T(0 == memcmp(load_file_offset_content, load_file_buf + LOAD_FILE_OFFSET, num_bytes));
+    T(0 == memcmp(load_file_chunked_content + LOAD_FILE_OFFSET, load_file_buf + LOAD_FILE_OFFSET, num_bytes));
+    sfetch_shutdown();
+}
+
+#if !defined(_WIN32)
+/* stream the tail of a sparse file which is bigger than 4 GBytes */
+#include <fcntl.h>
+#define LARGE_FILE_SIZE ((uint64_t)0x100000000 + 12345)
+#define LARGE_FILE_OFFSET ((uint64_t)0x100000000 - 1000)
+static const char* large_file_path = "large_file.bin";
+static bool load_large_file_passed;
+static uint64_t load_large_file_num_bytes;
+static uint8_t load_large_file_content[16384];
+static void load_large_file_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        const uint64_t dst_offset = response->fetched_offset - LARGE_FILE_OFFSET;
+        if ((dst_offset + response->fetched_size) <= sizeof(load_large_file_content)) {
+            memcpy(&load_large_file_content[dst_offset], response->buffer_ptr, response->fetched_size);
+        }
+        load_large_file_num_bytes += response->fetched_size;
+        if (response->finished && (response->fetched_offset + response->fetched_size == LARGE_FILE_SIZE)) {
+            load_large_file_passed = true;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_large_file) {
+    int fd = open(large_file_path, O_CREAT|O_TRUNC|O_WRONLY, 0644);
+    T(fd >= 0);
+    bool file_ok = (fd >= 0) && (0 == ftruncate(fd, (off_t)LARGE_FILE_SIZE));
+    uint8_t pattern[12345 + 1000];
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 7 + 3);
+    }
+    file_ok = file_ok && ((ssize_t)sizeof(pattern) == pwrite(fd, pattern, sizeof(pattern), (off_t)LARGE_FILE_OFFSET));
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (!file_ok) {
+        // the filesystem doesn't support big sparse files
+        unlink(large_file_path);
+        return;
+    }
+    for (int mapped = 0; mapped < 2; mapped++) {
+        memset(load_large_file_content, 0, sizeof(load_large_file_content));
+        load_large_file_passed = false;
+        load_large_file_num_bytes = 0;
+        sfetch_setup(&(sfetch_desc_t){0});
+        sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+            .path = large_file_path,
+            .callback = load_large_file_callback,
+            .buffer_ptr = mapped ? 0 : load_chunk_buf,
+            .buffer_size = mapped ? 0 : sizeof(load_chunk_buf),
+            .chunk_size = 4096,
+            .offset = LARGE_FILE_OFFSET,
+            .memory_mapped = (mapped != 0)
+        });
+        int frame_count = 0;
+        const int max_frames = 10000;
+        while (sfetch_handle_valid(h) && (frame_count++ < max_frames)) {
+            sfetch_dowork();
+            sleep_ms(1);
+        }
+        T(frame_count < max_frames);
+        T(load_large_file_passed);
+        T(load_large_file_num_bytes == sizeof(pattern));
+        T(0 == memcmp(load_large_file_content, pattern, sizeof(pattern)));
+        sfetch_shutdown();
+    }
+    unlink(large_file_path);
+}
+#endif
+
+/* stream the same file through many lanes which are served by multiple IO threads,
+   each request must see its chunks in order
+*/
+#define LOAD_FILE_THREADS_NUM_LANES (8)
+#define LOAD_FILE_THREADS_NUM_REQUESTS (16)
+static uint8_t load_file_threads_chunk_buf[LOAD_FILE_THREADS_NUM_REQUESTS][4096];
+static uint8_t load_file_threads_content[LOAD_FILE_THREADS_NUM_REQUESTS][500000];
+static int load_file_threads_passed[LOAD_FILE_THREADS_NUM_REQUESTS];
+static bool load_file_threads_in_order = true;
+static void load_file_threads_callback(const sfetch_response_t* response) {
+    const int index = *(const int*)response->user_data;
+    if (response->fetched) {
+        static uint64_t next_offset[LOAD_FILE_THREADS_NUM_REQUESTS];
+        if (response->fetched_offset != next_offset[index]) {
+            load_file_threads_in_order = false;
+        }
+        next_offset[index] = response->fetched_offset + response->fetched_size;
+        memcpy(&load_file_threads_content[index][response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        if (response->finished) {
+            load_file_threads_passed[index]++;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_file_threads) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    load_file_fixed_buffer_passed = false;
+    sfetch_setup(&(sfetch_desc_t){
+        .num_channels = 1,
+        .num_lanes = LOAD_FILE_THREADS_NUM_LANES,
+        .num_threads = 4
+    });
+    T(sfetch_desc().num_threads == 4);
+    sfetch_handle_t h[LOAD_FILE_THREADS_NUM_REQUESTS + 1];
+    for (int i = 0; i < LOAD_FILE_THREADS_NUM_REQUESTS; i++) {
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = "comsi.s3m",
+            .callback = load_file_threads_callback,
+            .buffer_ptr = load_file_threads_chunk_buf[i],
+            .buffer_size = sizeof(load_file_threads_chunk_buf[0]),
+            .chunk_size = sizeof(load_file_threads_chunk_buf[0]),
+            .user_data_ptr = &i,
+            .user_data_size = sizeof(i)
+        });
+    }
+    h[LOAD_FILE_THREADS_NUM_REQUESTS] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf)
+    });
+    bool done = false;
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i <= LOAD_FILE_THREADS_NUM_REQUESTS; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_file_fixed_buffer_passed);
+    T(load_file_threads_in_order);
+    for (int i = 0; i < LOAD_FILE_THREADS_NUM_REQUESTS; i++) {
+        T(1 == load_file_threads_passed[i]);
+        T(0 == memcmp(load_file_buf, load_file_threads_content[i], combatsignal_file_size));
+    }
+    sfetch_shutdown();
+}
+
+/* build a pack file with a few generated files, and load them through
+   a mounted pack together with a loose file
+*/
+#define LOAD_PACK_NUM_FILES (3)
+static const char* load_pack_paths[LOAD_PACK_NUM_FILES] = { "data/a.bin", "data/b.bin", "data/empty.bin" };
+static const uint32_t load_pack_sizes[LOAD_PACK_NUM_FILES] = { 1000, 70000, 0 };
+static uint8_t load_pack_content[LOAD_PACK_NUM_FILES][70000];
+static uint8_t load_pack_result[LOAD_PACK_NUM_FILES][70000];
+static uint8_t load_pack_chunk_buf[4096];
+static int load_pack_finished[LOAD_PACK_NUM_FILES];
+static uint64_t load_pack_num_bytes[LOAD_PACK_NUM_FILES];
+static sfetch_error_t load_pack_missing_error;
+
+static uint64_t load_pack_hash(const char* str) {
+    uint64_t hash = 0xCBF29CE484222325;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+static void load_pack_put(FILE* fp, uint64_t val, int num_bytes) {
+    for (int i = 0; i < num_bytes; i++) {
+        fputc((int)((val >> (i * 8)) & 0xFF), fp);
+    }
+}
+
+static bool load_pack_write(const char* pack_path) {
+    FILE* fp = fopen(pack_path, "wb");
+    if (!fp) {
+        return false;
+    }
+    // index entries must be sorted by path hash
+    int order[LOAD_PACK_NUM_FILES] = { 0, 1, 2 };
+    for (int i = 0; i < LOAD_PACK_NUM_FILES; i++) {
+        for (int j = i + 1; j < LOAD_PACK_NUM_FILES; j++) {
+            if (load_pack_hash(load_pack_paths[order[j]]) < load_pack_hash(load_pack_paths[order[i]])) {
+                int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+            }
+        }
+    }
+    load_pack_put(fp, 0x4B504653, 4);
+    load_pack_put(fp, 1, 4);
+    load_pack_put(fp, LOAD_PACK_NUM_FILES, 4);
+    load_pack_put(fp, 0, 4);
+    uint64_t offset = 16 + LOAD_PACK_NUM_FILES * 32;
+    uint64_t offsets[LOAD_PACK_NUM_FILES];
+    for (int i = 0; i < LOAD_PACK_NUM_FILES; i++) {
+        offsets[i] = offset;
+        offset += load_pack_sizes[i] + 7;   // some unaligned padding between files
+    }
+    for (int i = 0; i < LOAD_PACK_NUM_FILES; i++) {
+        const int f = order[i];
+        load_pack_put(fp, load_pack_hash(load_pack_paths[f]), 8);
+        load_pack_put(fp, offsets[f], 8);
+        load_pack_put(fp, load_pack_sizes[f], 8);
+        load_pack_put(fp, 0, 8);
+    }
+    for (int i = 0; i < LOAD_PACK_NUM_FILES; i++) {
+        for (uint32_t j = 0; j < load_pack_sizes[i]; j++) {
+            load_pack_content[i][j] = (uint8_t)((j * 7) + (uint32_t)i);
+        }
+        fwrite(load_pack_content[i], 1, load_pack_sizes[i], fp);
+        fwrite("PADDING", 1, 7, fp);
+    }
+    fclose(fp);
+    return true;
+}
+
+static void load_pack_callback(const sfetch_response_t* response) {
+    const int index = *(const int*)response->user_data;
+    if (response->fetched) {
+        // the buffer pointer of an empty memory-mapped file is null
+        if (response->fetched_size > 0) {
+            memcpy(&load_pack_result[index][response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        }
+        load_pack_num_bytes[index] += response->fetched_size;
+    }
+    if (response->finished && !response->failed) {
+        load_pack_finished[index]++;
+    }
+}
+
+static void load_pack_missing_callback(const sfetch_response_t* response) {
+    if (response->finished) {
+        load_pack_missing_error = response->error_code;
+    }
+}
+
+UTEST(sokol_fetch, load_pack) {
+    const char* pack_path = "sokol-fetch-test.pack";
+    T(load_pack_write(pack_path));
+    memset(load_pack_result, 0, sizeof(load_pack_result));
+    memset(load_pack_num_bytes, 0, sizeof(load_pack_num_bytes));
+    memset(load_pack_finished, 0, sizeof(load_pack_finished));
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    load_file_fixed_buffer_passed = false;
+    load_pack_missing_error = SFETCH_ERROR_NO_ERROR;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 4, .num_threads = 2 });
+    T(!sfetch_mount("does-not-exist.pack"));
+    T(!sfetch_mount("comsi.s3m"));
+    T(sfetch_mount(pack_path));
+    static uint8_t whole_buf[1000];
+    int index = 0;
+    sfetch_handle_t h[5];
+    // a whole file
+    h[0] = sfetch_send(&(sfetch_request_t){
+        .path = "data/a.bin",
+        .callback = load_pack_callback,
+        .buffer_ptr = whole_buf,
+        .buffer_size = sizeof(whole_buf),
+        .user_data_ptr = &index,
+        .user_data_size = sizeof(index)
+    });
+    // a streamed file
+    index = 1;
+    h[1] = sfetch_send(&(sfetch_request_t){
+        .path = "data/b.bin",
+        .callback = load_pack_callback,
+        .buffer_ptr = load_pack_chunk_buf,
+        .buffer_size = sizeof(load_pack_chunk_buf),
+        .chunk_size = sizeof(load_pack_chunk_buf),
+        .user_data_ptr = &index,
+        .user_data_size = sizeof(index)
+    });
+    // a memory-mapped empty file
+    index = 2;
+    h[2] = sfetch_send(&(sfetch_request_t){
+        .path = "data/empty.bin",
+        .callback = load_pack_callback,
+        .memory_mapped = true,
+        .user_data_ptr = &index,
+        .user_data_size = sizeof(index)
+    });
+    // a loose file which isn't in the pack
+    h[3] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf)
+    });
+    // neither in the pack nor a loose file
+    h[4] = sfetch_send(&(sfetch_request_t){
+        .path = "data/missing.bin",
+        .callback = load_pack_missing_callback,
+        .buffer_ptr = whole_buf,
+        .buffer_size = sizeof(whole_buf)
+    });
+    bool done = false;
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i < 5; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    for (int i = 0; i < LOAD_PACK_NUM_FILES; i++) {
+        T(1 == load_pack_finished[i]);
+        T(load_pack_num_bytes[i] == load_pack_sizes[i]);
+        T(0 == memcmp(load_pack_result[i], load_pack_content[i], load_pack_sizes[i]));
+    }
+    T(load_file_fixed_buffer_passed);
+    T(load_pack_missing_error == SFETCH_ERROR_FILE_NOT_FOUND);
+    sfetch_shutdown();
+    remove(pack_path);
+}
+
+/* requests waiting for a lane are dispatched by priority */
+static int load_priority_order[8];
+static int load_priority_num_finished;
+static void load_priority_callback(const sfetch_response_t* response) {
+    if (response->finished && !response->failed) {
+        load_priority_order[load_priority_num_finished++] = *(const int*)response->user_data;
+    }
+}
+
+UTEST(sokol_fetch, load_priority) {
+    load_priority_num_finished = 0;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 1 });
+    const int priorities[4] = { 0, 5, 1, 5 };
+    sfetch_handle_t h[4];
+    for (int i = 0; i < 4; i++) {
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = "comsi.s3m",
+            .callback = load_priority_callback,
+            .buffer_ptr = load_file_buf,
+            .buffer_size = sizeof(load_file_buf),
+            .priority = priorities[i],
+            .user_data_ptr = &i,
+            .user_data_size = sizeof(i)
+        });
+    }
+    // reprioritize a request which is still waiting for a lane
+    sfetch_set_priority(h[2], 9);
+    bool done = false;
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i < 4; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_priority_num_finished == 4);
+    T(load_priority_order[0] == 2);
+    T(load_priority_order[1] == 1);
+    T(load_priority_order[2] == 3);
+    T(load_priority_order[3] == 0);
+    sfetch_shutdown();
+}
+
+/* a low priority streaming request yields its lane to a high priority request */
+static uint8_t load_yield_chunk_buf[1024];
+static uint8_t load_yield_content[500000];
+static uint64_t load_yield_num_bytes;
+static bool load_yield_in_order;
+static bool load_yield_finished;
+static bool load_yield_high_finished_first;
+static void load_yield_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if (response->fetched_offset != load_yield_num_bytes) {
+            load_yield_in_order = false;
+        }
+        memcpy(&load_yield_content[response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        load_yield_num_bytes += response->fetched_size;
+    }
+    if (response->finished) {
+        load_yield_finished = true;
+    }
+}
+
+static void load_yield_high_callback(const sfetch_response_t* response) {
+    if (response->finished && !response->failed) {
+        load_yield_high_finished_first = !load_yield_finished;
+    }
+}
+
+UTEST(sokol_fetch, load_yield_lane) {
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_yield_content, 0, sizeof(load_yield_content));
+    load_yield_num_bytes = 0;
+    load_yield_in_order = true;
+    load_yield_finished = false;
+    load_yield_high_finished_first = false;
+    load_file_fixed_buffer_passed = false;
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 1 });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_yield_callback,
+        .buffer_ptr = load_yield_chunk_buf,
+        .buffer_size = sizeof(load_yield_chunk_buf),
+        .chunk_size = sizeof(load_yield_chunk_buf),
+        .priority = -1,
+        .yield_lane = true
+    });
+    sfetch_handle_t h1 = { 0 };
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1)) && (frame_count++ < max_frames)) {
+        // send the high priority request after the streaming request occupies the only lane
+        if ((0 == h1.id) && (load_yield_num_bytes > 0)) {
+            h1 = sfetch_send(&(sfetch_request_t){
+                .path = "comsi.s3m",
+                .callback = load_yield_high_callback,
+                .buffer_ptr = load_file_buf,
+                .buffer_size = sizeof(load_file_buf),
+            });
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(0 != h1.id);
+    T(load_yield_high_finished_first);
+    T(load_yield_finished);
+    T(load_yield_in_order);
+    T(load_yield_num_bytes == combatsignal_file_size);
+    T(0 == memcmp(load_file_buf, load_yield_content, combatsignal_file_size));
+    sfetch_shutdown();
+}
+
+/* load LZ4 compressed versions of comsi.s3m, once as a whole with dependent
+   blocks, and once streamed block by block with independent blocks
+*/
+static uint8_t load_lz4_reference[409482];
+static uint8_t load_lz4_stream_content[409482];
+static uint8_t load_lz4_chunk_buf[64 * 1024];
+static uint64_t load_lz4_whole_size;
+static uint64_t load_lz4_stream_num_bytes;
+static int load_lz4_stream_num_chunks;
+static bool load_lz4_stream_in_order;
+static int load_lz4_num_finished;
+static int load_lz4_num_failed;
+
+static bool load_lz4_read_reference(void) {
+    FILE* fp = fopen("comsi.s3m", "rb");
+    if (!fp) {
+        return false;
+    }
+    const size_t num_bytes = fread(load_lz4_reference, 1, sizeof(load_lz4_reference), fp);
+    fclose(fp);
+    return num_bytes == sizeof(load_lz4_reference);
+}
+
+static void load_lz4_whole_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        load_lz4_whole_size = response->fetched_size;
+    }
+    if (response->finished) {
+        load_lz4_num_finished++;
+        if (response->failed) {
+            load_lz4_num_failed++;
+        }
+    }
+}
+
+static void load_lz4_stream_callback(const sfetch_response_t* response) {
+    if (response->fetched) {
+        if ((response->fetched_offset != load_lz4_stream_num_bytes) ||
+            ((response->fetched_offset + response->fetched_size) > sizeof(load_lz4_stream_content)))
+        {
+            load_lz4_stream_in_order = false;
+        }
+        else {
+            memcpy(&load_lz4_stream_content[response->fetched_offset], response->buffer_ptr, response->fetched_size);
+            load_lz4_stream_num_bytes += response->fetched_size;
+        }
+        load_lz4_stream_num_chunks++;
+    }
+    if (response->finished) {
+        load_lz4_num_finished++;
+        if (response->failed) {
+            load_lz4_num_failed++;
+        }
+    }
+}
+
+UTEST(sokol_fetch, load_lz4) {
+    T(load_lz4_read_reference());
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    memset(load_lz4_stream_content, 0, sizeof(load_lz4_stream_content));
+    load_lz4_whole_size = 0;
+    load_lz4_stream_num_bytes = 0;
+    load_lz4_stream_num_chunks = 0;
+    load_lz4_stream_in_order = true;
+    load_lz4_num_finished = 0;
+    load_lz4_num_failed = 0;
+    sfetch_setup(&(sfetch_desc_t){
+        .num_lanes = 2,
+        .num_threads = 2,
+        .max_lz4_block_size = 64 * 1024
+    });
+    sfetch_handle_t h0 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi_bd.lz4",
+        .callback = load_lz4_whole_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf),
+        .lz4 = true
+    });
+    sfetch_handle_t h1 = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.lz4",
+        .callback = load_lz4_stream_callback,
+        .buffer_ptr = load_lz4_chunk_buf,
+        .buffer_size = sizeof(load_lz4_chunk_buf),
+        .chunk_size = sizeof(load_lz4_chunk_buf),
+        .lz4 = true
+    });
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while ((sfetch_handle_valid(h0) || sfetch_handle_valid(h1)) && (frame_count++ < max_frames)) {
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_lz4_num_finished == 2);
+    T(load_lz4_num_failed == 0);
+    T(load_lz4_whole_size == combatsignal_file_size);
+    T(0 == memcmp(load_file_buf, load_lz4_reference, combatsignal_file_size));
+    // one chunk per 64 KB block
+    T(load_lz4_stream_in_order);
+    T(load_lz4_stream_num_chunks == 7);
+    T(load_lz4_stream_num_bytes == combatsignal_file_size);
+    T(0 == memcmp(load_lz4_stream_content, load_lz4_reference, combatsignal_file_size));
+    sfetch_shutdown();
+}
+
+/* hand-made LZ4 frames with a stored block, and invalid or unsupported frames */
+#define LOAD_LZ4_ERRORS_NUM_REQUESTS (5)
+static uint8_t load_lz4_errors_buf[LOAD_LZ4_ERRORS_NUM_REQUESTS][64 * 1024];
+static uint64_t load_lz4_errors_size[LOAD_LZ4_ERRORS_NUM_REQUESTS];
+static sfetch_error_t load_lz4_errors_code[LOAD_LZ4_ERRORS_NUM_REQUESTS];
+static int load_lz4_errors_finished[LOAD_LZ4_ERRORS_NUM_REQUESTS];
+
+static bool load_lz4_write_file(const char* path, const uint8_t* data, size_t num_bytes) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    const size_t num_written = fwrite(data, 1, num_bytes, fp);
+    fclose(fp);
+    return num_written == num_bytes;
+}
+
+static void load_lz4_errors_callback(const sfetch_response_t* response) {
+    const int index = *(const int*)response->user_data;
+    if (response->fetched) {
+        memcpy(load_lz4_errors_buf[index], response->buffer_ptr, response->fetched_size);
+        load_lz4_errors_size[index] = response->fetched_size;
+    }
+    if (response->finished) {
+        load_lz4_errors_code[index] = response->error_code;
+        load_lz4_errors_finished[index]++;
+    }
+}
+
+UTEST(sokol_fetch, load_lz4_errors) {
+    // a stored block with 'hello', and a compressed block with 'ab', a match (offset 2, length 6) and '!'
+    static const uint8_t valid_frame[] = {
+        0x04, 0x22, 0x4D, 0x18, 0x60, 0x40, 0x82,
+        0x05, 0x00, 0x00, 0x80, 'h', 'e', 'l', 'l', 'o',
+        0x07, 0x00, 0x00, 0x00, 0x22, 'a', 'b', 0x02, 0x00, 0x10, '!',
+        0x00, 0x00, 0x00, 0x00
+    };
+    // a match which reaches before the start of the block
+    static const uint8_t invalid_frame[] = {
+        0x04, 0x22, 0x4D, 0x18, 0x60, 0x40, 0x82,
+        0x05, 0x00, 0x00, 0x00, 0x10, 'a', 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+    };
+    T(load_lz4_write_file("lz4_valid.bin", valid_frame, sizeof(valid_frame)));
+    T(load_lz4_write_file("lz4_invalid.bin", invalid_frame, sizeof(invalid_frame)));
+    memset(load_lz4_errors_buf, 0, sizeof(load_lz4_errors_buf));
+    memset(load_lz4_errors_size, 0, sizeof(load_lz4_errors_size));
+    memset(load_lz4_errors_code, 0, sizeof(load_lz4_errors_code));
+    memset(load_lz4_errors_finished, 0, sizeof(load_lz4_errors_finished));
+    sfetch_setup(&(sfetch_desc_t){
+        .num_lanes = LOAD_LZ4_ERRORS_NUM_REQUESTS,
+        .max_lz4_block_size = 64 * 1024
+    });
+    const char* paths[LOAD_LZ4_ERRORS_NUM_REQUESTS] = {
+        "lz4_valid.bin",    // valid
+        "lz4_invalid.bin",  // invalid match offset
+        "comsi.s3m",        // not an LZ4 frame
+        "comsi_bd.lz4",     // dependent blocks can't be streamed
+        "comsi_bd.lz4",     // content size is bigger than the buffer
+    };
+    const uint32_t chunk_sizes[LOAD_LZ4_ERRORS_NUM_REQUESTS] = { 0, 0, 0, 1024, 0 };
+    sfetch_handle_t h[LOAD_LZ4_ERRORS_NUM_REQUESTS];
+    for (int i = 0; i < LOAD_LZ4_ERRORS_NUM_REQUESTS; i++) {
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = paths[i],
+            .callback = load_lz4_errors_callback,
+            .buffer_ptr = load_lz4_errors_buf[i],
+            .buffer_size = sizeof(load_lz4_errors_buf[i]),
+            .chunk_size = chunk_sizes[i],
+            .user_data_ptr = &i,
+            .user_data_size = sizeof(i),
+            .lz4 = true
+        });
+    }
+    bool done = false;
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i < LOAD_LZ4_ERRORS_NUM_REQUESTS; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    for (int i = 0; i < LOAD_LZ4_ERRORS_NUM_REQUESTS; i++) {
+        T(1 == load_lz4_errors_finished[i]);
+    }
+    T(load_lz4_errors_code[0] == SFETCH_ERROR_NO_ERROR);
+    T(load_lz4_errors_size[0] == 14);
+    T(0 == memcmp(load_lz4_errors_buf[0], "helloabababab!", 14));
+    T(load_lz4_errors_code[1] == SFETCH_ERROR_INVALID_LZ4_DATA);
+    T(load_lz4_errors_code[2] == SFETCH_ERROR_INVALID_LZ4_DATA);
+    T(load_lz4_errors_code[3] == SFETCH_ERROR_INVALID_LZ4_DATA);
+    T(load_lz4_errors_code[4] == SFETCH_ERROR_BUFFER_TOO_SMALL);
+    sfetch_shutdown();
+    remove("lz4_valid.bin");
+    remove("lz4_invalid.bin");
+}
+
+/* without max_lz4_block_size there are no scratch buffers, so LZ4 requests are rejected */
+UTEST(sokol_fetch, load_lz4_disabled) {
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 1 });
+    sfetch_handle_t h = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.lz4",
+        .callback = load_lz4_whole_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf),
+        .lz4 = true
+    });
+    T(!sfetch_handle_valid(h));
+    sfetch_shutdown();
+}
+
+/* stream a file with readahead into a double buffer, from multiple IO threads */
+#define LOAD_READAHEAD_NUM_REQUESTS (3)
+static uint8_t load_readahead_buf[LOAD_READAHEAD_NUM_REQUESTS][2 * 8192];
+static uint8_t load_readahead_content[LOAD_READAHEAD_NUM_REQUESTS][500000];
+static uint64_t load_readahead_offset[LOAD_READAHEAD_NUM_REQUESTS];
+static int load_readahead_num_chunks[LOAD_READAHEAD_NUM_REQUESTS];
+static int load_readahead_finished[LOAD_READAHEAD_NUM_REQUESTS];
+static bool load_readahead_failed;
+static sfetch_handle_t load_readahead_paused;
+static void load_readahead_callback(const sfetch_response_t* response) {
+    const int index = *(const int*)response->user_data;
+    if (response->fetched) {
+        // chunks arrive in order, alternating between the buffer halves
+        const uint64_t half_size = sizeof(load_readahead_buf[index]) / 2;
+        const uint8_t* half_ptr = load_readahead_buf[index] + (load_readahead_num_chunks[index] & 1) * half_size;
+        if ((response->fetched_offset != load_readahead_offset[index]) ||
+            (response->buffer_ptr != half_ptr) ||
+            (response->buffer_size != half_size))
+        {
+            load_readahead_failed = true;
+        }
+        memcpy(&load_readahead_content[index][response->fetched_offset], response->buffer_ptr, response->fetched_size);
+        load_readahead_offset[index] += response->fetched_size;
+        load_readahead_num_chunks[index]++;
+        // pause while a readahead is in flight
+        if ((0 == index) && (3 == load_readahead_num_chunks[index])) {
+            sfetch_pause(response->handle);
+            load_readahead_paused = response->handle;
+        }
+    }
+    if (response->finished) {
+        if (response->failed) {
+            load_readahead_failed = true;
+        }
+        load_readahead_finished[index]++;
+    }
+}
+
+UTEST(sokol_fetch, load_file_readahead) {
+    memset(load_readahead_buf, 0, sizeof(load_readahead_buf));
+    memset(load_readahead_content, 0, sizeof(load_readahead_content));
+    memset(load_readahead_num_chunks, 0, sizeof(load_readahead_num_chunks));
+    memset(load_readahead_finished, 0, sizeof(load_readahead_finished));
+    memset(load_file_buf, 0, sizeof(load_file_buf));
+    load_file_fixed_buffer_passed = false;
+    load_readahead_failed = false;
+    load_readahead_paused = (sfetch_handle_t){0};
+    sfetch_setup(&(sfetch_desc_t){ .num_lanes = 4, .num_threads = 2 });
+    const uint64_t offsets[LOAD_READAHEAD_NUM_REQUESTS] = { 0, 1000, 0 };
+    const uint32_t chunk_sizes[LOAD_READAHEAD_NUM_REQUESTS] = { 8192, 8192, 3000 };
+    sfetch_handle_t h[LOAD_READAHEAD_NUM_REQUESTS + 1];
+    for (int i = 0; i < LOAD_READAHEAD_NUM_REQUESTS; i++) {
+        load_readahead_offset[i] = offsets[i];
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = "comsi.s3m",
+            .callback = load_readahead_callback,
+            .buffer_ptr = load_readahead_buf[i],
+            .buffer_size = sizeof(load_readahead_buf[i]),
+            .chunk_size = chunk_sizes[i],
+            .offset = offsets[i],
+            .user_data_ptr = &i,
+            .user_data_size = sizeof(i),
+            .readahead = true
+        });
+    }
+    // the entire file for comparison
+    h[LOAD_READAHEAD_NUM_REQUESTS] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_file_fixed_buffer_callback,
+        .buffer_ptr = load_file_buf,
+        .buffer_size = sizeof(load_file_buf)
+    });
+    bool done = false;
+    int frame_count = 0;
+    int paused_frames = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i <= LOAD_READAHEAD_NUM_REQUESTS; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        if ((0 != load_readahead_paused.id) && (++paused_frames == 5)) {
+            sfetch_continue(load_readahead_paused);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(!load_readahead_failed);
+    T(load_file_fixed_buffer_passed);
+    for (int i = 0; i < LOAD_READAHEAD_NUM_REQUESTS; i++) {
+        T(1 == load_readahead_finished[i]);
+        T(load_readahead_offset[i] == combatsignal_file_size);
+        T(0 == memcmp(load_readahead_content[i] + offsets[i], load_file_buf + offsets[i], combatsignal_file_size - offsets[i]));
+    }
+    sfetch_shutdown();
+}
+
+/* statistics and per-response timing */
+static uint8_t load_stats_buf[3][500000];
+static uint8_t load_stats_chunk_buf[8192];
+static int load_stats_num_responses;
+static bool load_stats_timing_valid;
+static void load_stats_callback(const sfetch_response_t* response) {
+    if (response->dispatched) {
+        return;
+    }
+    const sfetch_timing_t* t = &response->timing;
+    if ((t->queue_wait < 0.0) || (t->io_time <= 0.0) || (t->callback_wait < 0.0)) {
+        load_stats_timing_valid = false;
+    }
+    load_stats_num_responses++;
+}
+
+static bool load_stats_latency_valid(const sfetch_latency_t* l, uint64_t num) {
+    uint64_t bucket_sum = 0;
+    for (int i = 0; i < SFETCH_NUM_LATENCY_BUCKETS; i++) {
+        bucket_sum += l->buckets[i];
+    }
+    return (l->num == num) && (bucket_sum == num) &&
+           (l->min <= l->p50) && (l->p50 <= l->p95) && (l->p95 <= l->p99) && (l->p99 <= l->max) &&
+           (l->min <= l->avg) && (l->avg <= l->max);
+}
+
+UTEST(sokol_fetch, load_stats) {
+    load_stats_num_responses = 0;
+    load_stats_timing_valid = true;
+    sfetch_setup(&(sfetch_desc_t){ .num_channels = 2, .num_lanes = 2 });
+    sfetch_stats_t stats = sfetch_query_stats(0);
+    T(stats.num_lanes == 2);
+    T((stats.num_completed == 0) && (stats.num_failed == 0) && (stats.io_time.num == 0));
+    sfetch_handle_t h[5];
+    // more requests than lanes, so that some have to wait
+    for (int i = 0; i < 3; i++) {
+        h[i] = sfetch_send(&(sfetch_request_t){
+            .path = "comsi.s3m",
+            .callback = load_stats_callback,
+            .buffer_ptr = load_stats_buf[i],
+            .buffer_size = sizeof(load_stats_buf[i])
+        });
+    }
+    h[3] = sfetch_send(&(sfetch_request_t){
+        .path = "does_not_exist.s3m",
+        .callback = load_stats_callback,
+        .buffer_ptr = load_stats_chunk_buf,
+        .buffer_size = sizeof(load_stats_chunk_buf)
+    });
+    h[4] = sfetch_send(&(sfetch_request_t){
+        .path = "comsi.s3m",
+        .callback = load_stats_callback,
+        .buffer_ptr = load_stats_chunk_buf,
+        .buffer_size = sizeof(load_stats_chunk_buf),
+        .chunk_size = sizeof(load_stats_chunk_buf)
+    });
+    stats = sfetch_query_stats(0);
+    T(stats.num_queued == 5);
+    bool done = false;
+    int frame_count = 0;
+    const int max_frames = 10000;
+    while (!done && (frame_count++ < max_frames)) {
+        done = true;
+        for (int i = 0; i < 5; i++) {
+            done &= !sfetch_handle_valid(h[i]);
+        }
+        sfetch_dowork();
+        sleep_ms(1);
+    }
+    T(frame_count < max_frames);
+    T(load_stats_timing_valid);
+    // 3 whole files, 1 failed open, and 50 chunks of 8 KB
+    const uint64_t num_ops = 3 + 1 + 50;
+    T(load_stats_num_responses == (int)num_ops);
+    stats = sfetch_query_stats(0);
+    T((stats.num_queued == 0) && (stats.num_in_flight == 0));
+    T((stats.lane_utilization > 0.0) && (stats.lane_utilization <= 1.0));
+    T(stats.num_bytes == 4 * combatsignal_file_size);
+    T(stats.num_completed == 4);
+    T(stats.num_failed == 1);
+    T(load_stats_latency_valid(&stats.queue_wait, num_ops));
+    T(load_stats_latency_valid(&stats.io_time, num_ops));
+    T(load_stats_latency_valid(&stats.callback_wait, num_ops));
+    // the other channel wasn't used
+    stats = sfetch_query_stats(1);
+    T((stats.num_completed == 0) && (stats.io_time.num == 0) && (stats.lane_utilization == 0.0));
+    sfetch_reset_stats();
+    stats = sfetch_query_stats(0);
+    T((stats.num_bytes == 0) && (stats.num_completed == 0) && (stats.io_time.num == 0));
+    sfetch_shutdown();
+}
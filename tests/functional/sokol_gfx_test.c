@@ -836,3 +836,288 @@ UTEST(sokol_gfx, query_buffer_will_overflow) {
     T(sg_query_buffer_will_overflow(buf, 33));
     sg_shutdown();
 }
+
+UTEST(sokol_gfx, pass_timing_disabled) {
+    sg_setup(&(sg_desc){0});
+    T(sg_query_features().pass_timing);
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_end_pass();
+    sg_commit();
+    const sg_frame_timings timings = sg_query_frame_timings();
+    T(!timings.valid);
+    T(timings.num_scopes == 0);
+    T(sg_query_timing("default") < 0.0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pass_timing) {
+    sg_setup(&(sg_desc){ .pass_timing = true });
+    sg_pass pass = sg_make_pass(&(sg_pass_desc){
+        .color_attachments[0].image = sg_make_image(&(sg_image_desc){ .render_target=true, .width=16, .height=16 }),
+        .label = "shadow",
+    });
+    sg_push_debug_group("frame");
+    sg_begin_pass(pass, &(sg_pass_action){0});
+    sg_push_debug_group("casters");
+    sg_pop_debug_group();
+    sg_end_pass();
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    // an unbalanced debug group inside a pass is closed by sg_end_pass()
+    sg_push_debug_group("unbalanced");
+    sg_end_pass();
+    sg_pop_debug_group();
+    sg_commit();
+
+    const sg_frame_timings timings = sg_query_frame_timings();
+    T(timings.valid);
+    T(timings.frame_index == 1);
+    T(timings.num_scopes == 5);
+    T(0 == strcmp(timings.scopes[0].name, "frame"));
+    T(!timings.scopes[0].is_pass);
+    T(timings.scopes[0].depth == 0);
+    T(0 == strcmp(timings.scopes[1].name, "shadow"));
+    T(timings.scopes[1].is_pass);
+    T(timings.scopes[1].depth == 1);
+    T(0 == strcmp(timings.scopes[2].name, "casters"));
+    T(timings.scopes[2].depth == 2);
+    T(0 == strcmp(timings.scopes[3].name, "default"));
+    T(timings.scopes[3].depth == 1);
+    T(0 == strcmp(timings.scopes[4].name, "unbalanced"));
+    T(timings.scopes[4].depth == 2);
+    for (int i = 0; i < timings.num_scopes; i++) {
+        T(timings.scopes[i].duration_ms >= 0.0);
+    }
+    T(timings.scopes[0].duration_ms >= timings.scopes[1].duration_ms);
+    T(sg_query_timing("shadow") == timings.scopes[1].duration_ms);
+    T(sg_query_timing("default") >= 0.0);
+    T(sg_query_timing("missing") < 0.0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, pass_timing_overflow) {
+    sg_setup(&(sg_desc){ .pass_timing = true });
+    for (int frame = 0; frame < 8; frame++) {
+        for (int i = 0; i < SG_MAX_TIMING_SCOPES + 8; i++) {
+            sg_push_debug_group("group");
+        }
+        for (int i = 0; i < SG_MAX_TIMING_SCOPES + 8; i++) {
+            sg_pop_debug_group();
+        }
+        // an extra pop must be ignored
+        sg_pop_debug_group();
+        sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+        sg_end_pass();
+        sg_commit();
+    }
+    const sg_frame_timings timings = sg_query_frame_timings();
+    T(timings.valid);
+    T(timings.frame_index == 8);
+    T(timings.num_scopes == SG_MAX_TIMING_SCOPES);
+    T(timings.scopes[SG_MAX_TIMING_SCOPES-1].depth == SG_MAX_TIMING_SCOPES-1);
+    // the default pass didn't fit into the frame anymore
+    T(sg_query_timing("default") < 0.0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, instances) {
+    sg_setup(&(sg_desc){ .buffer_pool_size = 16 });
+    sg_buffer buf0 = sg_make_buffer(&(sg_buffer_desc){ .size = 128, .usage = SG_USAGE_STREAM });
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_VALID);
+
+    sg_instance inst = sg_make_instance(&(sg_instance_desc){0});
+    T(inst.ptr);
+    sg_instance prev = sg_set_instance(inst);
+    T(prev.ptr == 0);
+    T(!sg_isvalid());
+    sg_setup(&(sg_desc){ .buffer_pool_size = 32 });
+    T(sg_isvalid());
+    T(sg_query_desc().buffer_pool_size == 32);
+    T(_sg.pools.buffer_pool.size == 33);
+    // resource handles are per instance
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_INVALID);
+    sg_buffer buf1 = sg_make_buffer(&(sg_buffer_desc){ .size = 256, .usage = SG_USAGE_STREAM });
+    T(sg_query_buffer_state(buf1) == SG_RESOURCESTATE_VALID);
+    T(sg_query_buffer_info(buf1).append_pos == 0);
+    sg_commit();
+    sg_commit();
+    T(_sg.frame_index == 3);
+
+    // switch back to the default instance, which must be unaffected
+    prev = sg_set_instance((sg_instance){0});
+    T(prev.ptr == inst.ptr);
+    T(sg_isvalid());
+    T(sg_query_desc().buffer_pool_size == 16);
+    T(_sg.frame_index == 1);
+    T(sg_query_buffer_state(buf0) == SG_RESOURCESTATE_VALID);
+    sg_shutdown();
+    T(!sg_isvalid());
+
+    sg_set_instance(inst);
+    T(sg_isvalid());
+    T(sg_query_buffer_state(buf1) == SG_RESOURCESTATE_VALID);
+    sg_shutdown();
+    sg_set_instance((sg_instance){0});
+    sg_destroy_instance(inst);
+}
+
+static struct {
+    int num_calls;
+    sg_read_image_result results[SG_MAX_IMAGE_READS + 1];
+} read_image_state;
+
+static void read_image_cb(const sg_read_image_result* res) {
+    read_image_state.results[read_image_state.num_calls++] = *res;
+}
+
+UTEST(sokol_gfx, read_image_async) {
+    sg_setup(&(sg_desc){0});
+    T(sg_query_features().image_readback);
+    memset(&read_image_state, 0, sizeof(read_image_state));
+    sg_image img = sg_make_image(&(sg_image_desc){ .render_target = true, .width = 64, .height = 32 });
+    static uint8_t buf[SG_MAX_IMAGE_READS][16 * 8 * 4];
+    memset(buf, 0xFF, sizeof(buf));
+    for (int i = 0; i < SG_MAX_IMAGE_READS; i++) {
+        T(sg_read_image_async(img, &(sg_rect){ .x = i, .y = 2, .width = 16, .height = 8 }, &SG_RANGE(buf[i]), read_image_cb, (void*)(intptr_t)(i + 1)));
+    }
+    // all slots in flight
+    T(!sg_read_image_async(img, &(sg_rect){ .width = 16, .height = 8 }, &SG_RANGE(buf[0]), read_image_cb, 0));
+    // callbacks are only called from inside sg_commit()
+    T(read_image_state.num_calls == 0);
+    sg_commit();
+    T(read_image_state.num_calls == SG_MAX_IMAGE_READS);
+    for (int i = 0; i < SG_MAX_IMAGE_READS; i++) {
+        const sg_read_image_result* res = &read_image_state.results[i];
+        T(res->success);
+        T(res->image.id == img.id);
+        T(res->rect.x == i);
+        T(res->rect.width == 16);
+        T(res->rect.height == 8);
+        T(res->pixel_format == SG_PIXELFORMAT_RGBA8);
+        T(res->row_pitch == 16 * 4);
+        T(res->data.ptr == buf[i]);
+        T(res->data.size == sizeof(buf[i]));
+        T(res->frame_index == 1);
+        T(res->user_data == (void*)(intptr_t)(i + 1));
+        // the dummy backend clears the destination
+        T(buf[i][0] == 0);
+        T(buf[i][sizeof(buf[i]) - 1] == 0);
+    }
+    // a buffer which is too small is rejected in release mode
+    #if !defined(SOKOL_DEBUG)
+    uint8_t small[16];
+    T(!sg_read_image_async(img, &(sg_rect){ .width = 16, .height = 8 }, &SG_RANGE(small), read_image_cb, 0));
+    #endif
+    // reads in flight during sg_shutdown() are reported as failed
+    T(sg_read_image_async(img, &(sg_rect){ .width = 16, .height = 8 }, &SG_RANGE(buf[0]), read_image_cb, 0));
+    sg_shutdown();
+    T(read_image_state.num_calls == SG_MAX_IMAGE_READS + 1);
+    T(!read_image_state.results[SG_MAX_IMAGE_READS].success);
+}
+
+UTEST(sokol_gfx, map_image) {
+    sg_setup(&(sg_desc){0});
+    sg_image img = sg_make_image(&(sg_image_desc){
+        .usage = SG_USAGE_STREAM,
+        .width = 64,
+        .height = 32,
+        .gl_pbo_streaming = true
+    });
+    T(sg_query_image_state(img) == SG_RESOURCESTATE_VALID);
+    // pixel unpack buffers only exist on GL, other backends return an empty range
+    const sg_range dst = sg_map_image(img);
+    T(dst.ptr == 0);
+    T(dst.size == 0);
+    sg_unmap_image(img);
+    // a failed map doesn't count as an update
+    static uint8_t pixels[64 * 32 * 4];
+    sg_update_image(img, &(sg_image_data){ .subimage[0][0] = SG_RANGE(pixels) });
+    sg_commit();
+    T(sg_map_image((sg_image){ SG_INVALID_ID }).ptr == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, skip_unchanged_uniforms) {
+    sg_setup(&(sg_desc){0});
+    sg_shader_desc shd_desc = {
+        .attrs[0].name = "pos",
+        .vs.uniform_blocks[0].size = 16,
+        .fs.uniform_blocks[0].size = 1024,
+    };
+    sg_shader shd0 = sg_make_shader(&shd_desc);
+    sg_shader shd1 = sg_make_shader(&shd_desc);
+    sg_pipeline_desc pip_desc = {
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd0,
+    };
+    sg_pipeline pip0 = sg_make_pipeline(&pip_desc);
+    sg_pipeline pip1 = sg_make_pipeline(&pip_desc);
+    pip_desc.shader = shd1;
+    sg_pipeline pip2 = sg_make_pipeline(&pip_desc);
+    float vs_params[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    static float fs_params[256];
+
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip0);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &SG_RANGE(fs_params));
+    // same content again => skipped
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &SG_RANGE(fs_params));
+    // a different pipeline with the same shader keeps the cached content
+    sg_apply_pipeline(pip1);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    // changed content => not skipped
+    vs_params[3] = 5.0f;
+    fs_params[255] = 1.0f;
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &SG_RANGE(fs_params));
+    // a different shader invalidates the cache
+    sg_apply_pipeline(pip2);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_end_pass();
+    // stats are only available after sg_commit()
+    T(sg_query_frame_stats().uniforms.num_apply == 0);
+    sg_commit();
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.frame_index == 1);
+    T(stats.uniforms.num_apply == 8);
+    T(stats.uniforms.num_skipped == 3);
+    T(stats.uniforms.size_apply == 5 * 16 + 3 * 1024);
+    T(stats.uniforms.size_skipped == 2 * 16 + 1024);
+
+    // a new pass invalidates the cache
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip2);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_end_pass();
+    sg_commit();
+    stats = sg_query_frame_stats();
+    T(stats.frame_index == 2);
+    T(stats.uniforms.num_apply == 1);
+    T(stats.uniforms.num_skipped == 0);
+    sg_shutdown();
+}
+
+UTEST(sokol_gfx, dont_skip_big_uniforms) {
+    sg_setup(&(sg_desc){0});
+    sg_shader shd = sg_make_shader(&(sg_shader_desc){
+        .attrs[0].name = "pos",
+        .vs.uniform_blocks[0].size = 8 * 1024,
+    });
+    sg_pipeline pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout.attrs[0].format = SG_VERTEXFORMAT_FLOAT3,
+        .shader = shd,
+    });
+    // blocks bigger than 4 KBytes aren't remembered, and always uploaded
+    static float vs_params[2048];
+    sg_begin_default_pass(&(sg_pass_action){0}, 256, 256);
+    sg_apply_pipeline(pip);
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
+    sg_end_pass();
+    sg_commit();
+    sg_frame_stats stats = sg_query_frame_stats();
+    T(stats.uniforms.num_apply == 2);
+    T(stats.uniforms.num_skipped == 0);
+    sg_shutdown();
+}
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+//  sokol-pixconv-test.c
+//------------------------------------------------------------------------------
+#include "sokol_gfx.h"
+#define SOKOL_PIXCONV_IMPL
+#include "sokol_pixconv.h"
+#include "utest.h"
+#include <string.h>
+
+#define T(b) EXPECT_TRUE(b)
+
+// odd pixel counts to also exercise the scalar tail loops after the SIMD loops
+#define NUM_PIXELS (67)
+
+static uint8_t src_buf[NUM_PIXELS * 16];
+static uint8_t dst_buf[NUM_PIXELS * 16];
+
+static void fill_src(void) {
+    for (size_t i = 0; i < sizeof(src_buf); i++) {
+        src_buf[i] = (uint8_t)((i * 37 + 11) ^ (i >> 3));
+    }
+    memset(dst_buf, 0xCC, sizeof(dst_buf));
+}
+
+UTEST(sokol_pixconv, rgb8_to_rgba8) {
+    fill_src();
+    spconv_rgb8_to_rgba8(dst_buf, src_buf, NUM_PIXELS);
+    for (size_t i = 0; i < NUM_PIXELS; i++) {
+        T(dst_buf[i*4 + 0] == src_buf[i*3 + 0]);
+        T(dst_buf[i*4 + 1] == src_buf[i*3 + 1]);
+        T(dst_buf[i*4 + 2] == src_buf[i*3 + 2]);
+        T(dst_buf[i*4 + 3] == 0xFF);
+    }
+    // must not write past the end
+    T(dst_buf[NUM_PIXELS * 4] == 0xCC);
+}
+
+UTEST(sokol_pixconv, bgra8_to_rgba8) {
+    fill_src();
+    spconv_bgra8_to_rgba8(dst_buf, src_buf, NUM_PIXELS);
+    for (size_t i = 0; i < NUM_PIXELS; i++) {
+        T(dst_buf[i*4 + 0] == src_buf[i*4 + 2]);
+        T(dst_buf[i*4 + 1] == src_buf[i*4 + 1]);
+        T(dst_buf[i*4 + 2] == src_buf[i*4 + 0]);
+        T(dst_buf[i*4 + 3] == src_buf[i*4 + 3]);
+    }
+    T(dst_buf[NUM_PIXELS * 4] == 0xCC);
+    // in-place round trip
+    spconv_bgra8_to_rgba8(dst_buf, dst_buf, NUM_PIXELS);
+    T(0 == memcmp(dst_buf, src_buf, NUM_PIXELS * 4));
+}
+
+UTEST(sokol_pixconv, swap_u16) {
+    fill_src();
+    spconv_swap_u16(dst_buf, src_buf, NUM_PIXELS);
+    for (size_t i = 0; i < NUM_PIXELS; i++) {
+        T(dst_buf[i*2 + 0] == src_buf[i*2 + 1]);
+        T(dst_buf[i*2 + 1] == src_buf[i*2 + 0]);
+    }
+    T(dst_buf[NUM_PIXELS * 2] == 0xCC);
+}
+
+UTEST(sokol_pixconv, premultiply_rgba8) {
+    fill_src();
+    spconv_premultiply_rgba8(dst_buf, src_buf, NUM_PIXELS);
+    for (size_t i = 0; i < NUM_PIXELS; i++) {
+        const uint32_t a = src_buf[i*4 + 3];
+        for (size_t c = 0; c < 3; c++) {
+            // must be exactly round(c * a / 255)
+            const uint32_t expected = (src_buf[i*4 + c] * a * 2 + 255) / 510;
+            T(dst_buf[i*4 + c] == expected);
+        }
+        T(dst_buf[i*4 + 3] == a);
+    }
+    T(dst_buf[NUM_PIXELS * 4] == 0xCC);
+    uint8_t px[8] = { 255, 128, 0, 255, 255, 128, 64, 0 };
+    spconv_premultiply_rgba8(px, px, 2);
+    T(px[0] == 255); T(px[1] == 128); T(px[2] == 0); T(px[3] == 255);
+    T(px[4] == 0); T(px[5] == 0); T(px[6] == 0); T(px[7] == 0);
+}
+
+UTEST(sokol_pixconv, f32_to_f16) {
+    static const struct { float f; uint16_t h; } values[] = {
+        { 0.0f, 0x0000 },
+        { -0.0f, 0x8000 },
+        { 1.0f, 0x3C00 },
+        { -2.0f, 0xC000 },
+        { 0.5f, 0x3800 },
+        { 65504.0f, 0x7BFF },
+        { 65536.0f, 0x7C00 },       // overflow => inf
+        { 1.0e-7f, 0x0002 },        // denormal
+        { 1.0e-9f, 0x0000 },        // underflow
+        { 1.00048828125f, 0x3C00 }, // exactly halfway, round to even
+        { 1.00146484375f, 0x3C02 }, // exactly halfway, round to even
+        { 0.333333333f, 0x3555 },
+    };
+    const size_t num = sizeof(values) / sizeof(values[0]);
+    float src[64];
+    uint16_t dst[64];
+    for (size_t i = 0; i < 64; i++) {
+        src[i] = values[i % num].f;
+    }
+    spconv_f32_to_f16(dst, src, 64);
+    for (size_t i = 0; i < 64; i++) {
+        T(dst[i] == values[i % num].h);
+    }
+}
+
+UTEST(sokol_pixconv, srgb_linear) {
+    uint8_t px[8] = { 0, 128, 255, 77, 188, 55, 1, 200 };
+    uint8_t lin[8];
+    spconv_srgb_to_linear_rgba8(lin, px, 2);
+    T(lin[0] == 0);
+    T(lin[1] == 55);
+    T(lin[2] == 255);
+    T(lin[3] == 77);
+    T(lin[7] == 200);
+    uint8_t srgb[8];
+    spconv_linear_to_srgb_rgba8(srgb, lin, 2);
+    T(srgb[0] == 0);
+    T(srgb[1] == 128);
+    T(srgb[2] == 255);
+    T(srgb[3] == 77);
+    T(srgb[7] == 200);
+    uint16_t hf[8];
+    spconv_srgb_rgba8_to_linear_rgba16f(hf, px, 2);
+    T(hf[0] == 0x0000);
+    T(hf[2] == 0x3C00);
+    T(hf[7] == 0x3A46);
+}
+
+UTEST(sokol_pixconv, query_simd) {
+    T(spconv_query_simd() != 0);
+}
@@ -0,0 +1,287 @@
+//------------------------------------------------------------------------------
+//  sokol-texfile-test.c
+//------------------------------------------------------------------------------
+#include "sokol_gfx.h"
+#define SOKOL_TEXFILE_IMPL
+#include "sokol_texfile.h"
+#include "utest.h"
+#include <string.h>
+
+#define T(b) EXPECT_TRUE(b)
+
+static uint8_t file_buf[64 * 1024];
+
+static void put_u32(uint8_t* ptr, uint32_t val) {
+    ptr[0] = (uint8_t)val;
+    ptr[1] = (uint8_t)(val >> 8);
+    ptr[2] = (uint8_t)(val >> 16);
+    ptr[3] = (uint8_t)(val >> 24);
+}
+
+static void put_u64(uint8_t* ptr, uint64_t val) {
+    put_u32(ptr, (uint32_t)val);
+    put_u32(ptr + 4, (uint32_t)(val >> 32));
+}
+
+// write a DDS header with a legacy DDS_PIXELFORMAT fourcc, returns offset of pixel data
+static size_t write_dds_header(uint32_t fourcc, uint32_t width, uint32_t height, uint32_t num_mips, uint32_t caps2) {
+    memset(file_buf, 0, sizeof(file_buf));
+    memcpy(file_buf, "DDS ", 4);
+    uint8_t* hdr = file_buf + 4;
+    put_u32(hdr, 124);
+    put_u32(hdr + 4, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+    put_u32(hdr + 8, height);
+    put_u32(hdr + 12, width);
+    put_u32(hdr + 24, num_mips);
+    put_u32(hdr + 72, 32);
+    put_u32(hdr + 76, 0x4);
+    put_u32(hdr + 80, fourcc);
+    put_u32(hdr + 108, caps2);
+    return 128;
+}
+
+static size_t write_dds_dx10_header(uint32_t dxgi_format, uint32_t width, uint32_t height, uint32_t num_mips, uint32_t num_layers) {
+    size_t offset = write_dds_header(0x30315844 /* DX10 */, width, height, num_mips, 0);
+    put_u32(file_buf + offset, dxgi_format);
+    put_u32(file_buf + offset + 4, 3); // DDS_DIMENSION_TEXTURE2D
+    put_u32(file_buf + offset + 12, num_layers);
+    return offset + 20;
+}
+
+static const uint8_t ktx1_identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+static const uint8_t ktx2_identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+static size_t write_ktx1_header(uint32_t gl_internal_format, uint32_t width, uint32_t height, uint32_t num_faces, uint32_t num_mips) {
+    memset(file_buf, 0, sizeof(file_buf));
+    memcpy(file_buf, ktx1_identifier, 12);
+    uint8_t* hdr = file_buf + 12;
+    put_u32(hdr, 0x04030201);
+    put_u32(hdr + 16, gl_internal_format);
+    put_u32(hdr + 24, width);
+    put_u32(hdr + 28, height);
+    put_u32(hdr + 40, num_faces);
+    put_u32(hdr + 44, num_mips);
+    put_u32(hdr + 48, 8);   // bytesOfKeyValueData (skipped)
+    return 64 + 8;
+}
+
+static size_t write_ktx2_header(uint32_t vk_format, uint32_t width, uint32_t height, uint32_t num_layers, uint32_t num_mips, uint32_t supercompression) {
+    memset(file_buf, 0, sizeof(file_buf));
+    memcpy(file_buf, ktx2_identifier, 12);
+    uint8_t* hdr = file_buf + 12;
+    put_u32(hdr, vk_format);
+    put_u32(hdr + 8, width);
+    put_u32(hdr + 12, height);
+    put_u32(hdr + 20, num_layers);
+    put_u32(hdr + 24, 1);
+    put_u32(hdr + 28, num_mips);
+    put_u32(hdr + 32, supercompression);
+    return 80;
+}
+
+UTEST(sokol_texfile, unknown_container) {
+    memset(file_buf, 0, sizeof(file_buf));
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 256 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNKNOWN_CONTAINER);
+    T(tex.container == STEXF_CONTAINER_UNKNOWN);
+}
+
+UTEST(sokol_texfile, dds_bc1_mipmaps) {
+    const size_t data_offset = write_dds_header(0x31545844 /* DXT1 */, 16, 8, 5, 0);
+    // 16x8: 4x2 blocks, 8x4: 2x1, 4x2: 1x1, 2x1: 1x1, 1x1: 1x1
+    const size_t size = data_offset + (64 + 16 + 8 + 8 + 8);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, size });
+    T(tex.valid);
+    T(tex.error == STEXF_ERROR_NO_ERROR);
+    T(tex.container == STEXF_CONTAINER_DDS);
+    T(tex.type == SG_IMAGETYPE_2D);
+    T(tex.pixel_format == SG_PIXELFORMAT_BC1_RGBA);
+    T(tex.width == 16);
+    T(tex.height == 8);
+    T(tex.num_slices == 1);
+    T(tex.num_mipmaps == 5);
+    T(tex.data.subimage[0][0].ptr == file_buf + data_offset);
+    T(tex.data.subimage[0][0].size == 64);
+    T(tex.data.subimage[0][1].ptr == file_buf + data_offset + 64);
+    T(tex.data.subimage[0][1].size == 16);
+    T(tex.data.subimage[0][2].ptr == file_buf + data_offset + 80);
+    T(tex.data.subimage[0][2].size == 8);
+    T(tex.data.subimage[0][4].ptr == file_buf + data_offset + 96);
+    T(tex.data.subimage[0][4].size == 8);
+    T(tex.data.subimage[0][5].ptr == 0);
+}
+
+UTEST(sokol_texfile, dds_truncated) {
+    const size_t data_offset = write_dds_header(0x35545844 /* DXT5 */, 16, 16, 1, 0);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 255 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_TRUNCATED);
+    tex = stexf_parse(&(sg_range){ file_buf, data_offset + 256 });
+    T(tex.valid);
+    T(tex.pixel_format == SG_PIXELFORMAT_BC3_RGBA);
+}
+
+UTEST(sokol_texfile, dds_too_big) {
+    const size_t data_offset = write_dds_header(0x31545844 /* DXT1 */, 0x7FFFFFFF, 0x7FFFFFFF, 1, 0);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 8 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_INVALID_HEADER);
+    // the max dimensions are accepted, but the data is missing
+    write_dds_header(0x31545844 /* DXT1 */, 1<<16, 1<<16, 1, 0);
+    tex = stexf_parse(&(sg_range){ file_buf, data_offset + 8 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_TRUNCATED);
+}
+
+UTEST(sokol_texfile, dds_cubemap) {
+    const size_t data_offset = write_dds_header(0x31545844 /* DXT1 */, 4, 4, 1, 0x200 | 0xFC00);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 6 * 8 });
+    T(tex.valid);
+    T(tex.type == SG_IMAGETYPE_CUBE);
+    for (int i = 0; i < 6; i++) {
+        T(tex.data.subimage[i][0].ptr == file_buf + data_offset + (size_t)i * 8);
+        T(tex.data.subimage[i][0].size == 8);
+    }
+}
+
+UTEST(sokol_texfile, dds_dx10_array) {
+    const size_t data_offset = write_dds_dx10_header(10 /* R16G16B16A16_FLOAT */, 4, 4, 1, 3);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 3 * 4 * 4 * 8 });
+    T(tex.valid);
+    T(tex.type == SG_IMAGETYPE_ARRAY);
+    T(tex.pixel_format == SG_PIXELFORMAT_RGBA16F);
+    T(tex.num_slices == 3);
+    T(tex.data.subimage[0][0].ptr == file_buf + data_offset);
+    T(tex.data.subimage[0][0].size == 3 * 4 * 4 * 8);
+}
+
+UTEST(sokol_texfile, dds_dx10_array_mipmaps_unsupported) {
+    const size_t data_offset = write_dds_dx10_header(98 /* BC7_UNORM */, 8, 8, 2, 2);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 2 * (64 + 16) });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNSUPPORTED_LAYOUT);
+}
+
+UTEST(sokol_texfile, dds_unsupported_format) {
+    const size_t data_offset = write_dds_dx10_header(1 /* R32G32B32A32_TYPELESS */, 4, 4, 1, 1);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, data_offset + 256 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+}
+
+UTEST(sokol_texfile, ktx1_etc2_mipmaps) {
+    size_t offset = write_ktx1_header(0x9278 /* GL_COMPRESSED_RGBA8_ETC2_EAC */, 8, 8, 1, 2);
+    const size_t mip0 = offset + 4;
+    put_u32(file_buf + offset, 64); offset += 4 + 64;
+    const size_t mip1 = offset + 4;
+    put_u32(file_buf + offset, 16); offset += 4 + 16;
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, offset });
+    T(tex.valid);
+    T(tex.container == STEXF_CONTAINER_KTX1);
+    T(tex.type == SG_IMAGETYPE_2D);
+    T(tex.pixel_format == SG_PIXELFORMAT_ETC2_RGBA8);
+    T(tex.num_mipmaps == 2);
+    T(tex.data.subimage[0][0].ptr == file_buf + mip0);
+    T(tex.data.subimage[0][0].size == 64);
+    T(tex.data.subimage[0][1].ptr == file_buf + mip1);
+    T(tex.data.subimage[0][1].size == 16);
+}
+
+UTEST(sokol_texfile, ktx1_cubemap) {
+    size_t offset = write_ktx1_header(0x8058 /* GL_RGBA8 */, 2, 2, 6, 1);
+    put_u32(file_buf + offset, 16);
+    offset += 4;
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, offset + 6 * 16 });
+    T(tex.valid);
+    T(tex.type == SG_IMAGETYPE_CUBE);
+    T(tex.pixel_format == SG_PIXELFORMAT_RGBA8);
+    for (int i = 0; i < 6; i++) {
+        T(tex.data.subimage[i][0].ptr == file_buf + offset + (size_t)i * 16);
+        T(tex.data.subimage[i][0].size == 16);
+    }
+}
+
+UTEST(sokol_texfile, ktx1_padded_rows) {
+    // a 3x3 R8 image has 4-byte aligned rows in KTX1
+    size_t offset = write_ktx1_header(0x8229 /* GL_R8 */, 3, 3, 1, 1);
+    put_u32(file_buf + offset, 12);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, offset + 4 + 12 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNSUPPORTED_LAYOUT);
+}
+
+UTEST(sokol_texfile, ktx1_key_value_data_too_big) {
+    write_ktx1_header(0x8058 /* GL_RGBA8 */, 2, 2, 1, 1);
+    put_u32(file_buf + 12 + 48, 0xFFFFFFF0);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 256 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_TRUNCATED);
+}
+
+UTEST(sokol_texfile, ktx1_big_endian) {
+    write_ktx1_header(0x8058, 2, 2, 1, 1);
+    put_u32(file_buf + 12, 0x01020304);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 256 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNSUPPORTED_LAYOUT);
+}
+
+UTEST(sokol_texfile, ktx2_bc7_mipmaps) {
+    const size_t index_offset = write_ktx2_header(145 /* VK_FORMAT_BC7_UNORM_BLOCK */, 8, 4, 0, 2, 0);
+    // KTX2 stores the smallest mipmap first
+    const size_t mip1 = 256;
+    const size_t mip0 = mip1 + 16;
+    put_u64(file_buf + index_offset, mip0);
+    put_u64(file_buf + index_offset + 8, 32);
+    put_u64(file_buf + index_offset + 24, mip1);
+    put_u64(file_buf + index_offset + 32, 16);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, mip0 + 32 });
+    T(tex.valid);
+    T(tex.container == STEXF_CONTAINER_KTX2);
+    T(tex.pixel_format == SG_PIXELFORMAT_BC7_RGBA);
+    T(tex.width == 8);
+    T(tex.height == 4);
+    T(tex.num_mipmaps == 2);
+    T(tex.data.subimage[0][0].ptr == file_buf + mip0);
+    T(tex.data.subimage[0][0].size == 32);
+    T(tex.data.subimage[0][1].ptr == file_buf + mip1);
+    T(tex.data.subimage[0][1].size == 16);
+
+    sg_image_desc desc = stexf_image_desc(&tex);
+    T(desc.type == SG_IMAGETYPE_2D);
+    T(desc.width == 8);
+    T(desc.height == 4);
+    T(desc.num_mipmaps == 2);
+    T(desc.pixel_format == SG_PIXELFORMAT_BC7_RGBA);
+    T(desc.data.subimage[0][1].ptr == file_buf + mip1);
+}
+
+UTEST(sokol_texfile, ktx2_array) {
+    const size_t index_offset = write_ktx2_header(97 /* VK_FORMAT_R16G16B16A16_SFLOAT */, 2, 2, 4, 1, 0);
+    put_u64(file_buf + index_offset, 128);
+    put_u64(file_buf + index_offset + 8, 4 * 2 * 2 * 8);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 128 + 4 * 2 * 2 * 8 });
+    T(tex.valid);
+    T(tex.type == SG_IMAGETYPE_ARRAY);
+    T(tex.num_slices == 4);
+    T(tex.pixel_format == SG_PIXELFORMAT_RGBA16F);
+    T(tex.data.subimage[0][0].ptr == file_buf + 128);
+    T(tex.data.subimage[0][0].size == 4 * 2 * 2 * 8);
+}
+
+UTEST(sokol_texfile, ktx2_supercompressed) {
+    write_ktx2_header(37, 4, 4, 0, 1, 2 /* zstd */);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 256 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_UNSUPPORTED_SUPERCOMPRESSION);
+}
+
+UTEST(sokol_texfile, ktx2_truncated) {
+    const size_t index_offset = write_ktx2_header(37 /* VK_FORMAT_R8G8B8A8_UNORM */, 4, 4, 0, 1, 0);
+    put_u64(file_buf + index_offset, 128);
+    put_u64(file_buf + index_offset + 8, 64);
+    stexf_texture_t tex = stexf_parse(&(sg_range){ file_buf, 128 + 63 });
+    T(!tex.valid);
+    T(tex.error == STEXF_ERROR_TRUNCATED);
+}
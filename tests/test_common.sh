@@ -145,5 +145,8 @@ runtest() {
     cfg=$1
     cd build/$cfg
     ./sokol-test
+    if [ -f sokol-fetch-test-uring ]; then
+        ./sokol-fetch-test-uring
+    fi
     cd ../../..
 }
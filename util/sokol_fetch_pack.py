@@ -0,0 +1,121 @@
+#-------------------------------------------------------------------------------
+#   Build a pack file for sokol_fetch.h (see PACK FILES in sokol_fetch.h)
+#
+#   Usage:
+#
+#       python3 sokol_fetch_pack.py [--prefix PREFIX] output.pack dir [dir...]
+#
+#   All files below the given directories are added to the pack file. The
+#   path of each file inside the pack is the path relative to its directory,
+#   with '/' as separator and the optional prefix prepended. This must be
+#   exactly the path which is later passed to sfetch_send(), for instance:
+#
+#       python3 sokol_fetch_pack.py --prefix data/ assets.pack assets
+#
+#   ...packs assets/textures/wall.png as 'data/textures/wall.png'.
+#
+#   Pack file layout (all values little-endian):
+#
+#       header:     uint32 magic ('SFPK'), uint32 version (1),
+#                   uint32 num_entries, uint32 reserved (0)
+#       index:      num_entries * { uint64 path_hash, uint64 offset,
+#                   uint64 size, uint32 flags (0), uint32 reserved (0) }
+#                   sorted by path_hash
+#       data:       the file contents at the offsets in the index
+#
+#   The path hash is the 64-bit FNV-1a hash of the UTF-8 path. Since the
+#   pack only stores hashes, the tool fails on hash collisions.
+#-------------------------------------------------------------------------------
+#   LICENSE
+#   =======
+#
+#   zlib/libpng license
+#
+#   This software is provided 'as-is', without any express or implied warranty.
+#   In no event will the authors be held liable for any damages arising from the
+#   use of this software.
+#
+#   Permission is granted to anyone to use this software for any purpose,
+#   including commercial applications, and to alter it and redistribute it
+#   freely, subject to the following restrictions:
+#
+#       1. The origin of this software must not be misrepresented; you must not
+#       claim that you wrote the original software. If you use this software in a
+#       product, an acknowledgment in the product documentation would be
+#       appreciated but is not required.
+#
+#       2. Altered source versions must be plainly marked as such, and must not
+#       be misrepresented as being the original software.
+#
+#       3. This notice may not be removed or altered from any source
+#       distribution.
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x4B504653
+VERSION = 1
+HEADER_SIZE = 16
+ENTRY_SIZE = 32
+DATA_ALIGN = 16
+
+def path_hash(path):
+    h = 0xCBF29CE484222325
+    for b in path.encode('utf-8'):
+        h ^= b
+        h = (h * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+def collect_files(dirs, prefix):
+    files = {}
+    for root_dir in dirs:
+        for dir_path, dir_names, file_names in os.walk(root_dir):
+            dir_names.sort()
+            for file_name in sorted(file_names):
+                src_path = os.path.join(dir_path, file_name)
+                rel_path = os.path.relpath(src_path, root_dir).replace(os.sep, '/')
+                pack_path = prefix + rel_path
+                if pack_path in files:
+                    sys.exit(f"error: '{pack_path}' exists in more than one directory")
+                files[pack_path] = src_path
+    return files
+
+def build_pack(out_path, files):
+    entries = {}
+    for pack_path in files:
+        h = path_hash(pack_path)
+        if h in entries:
+            sys.exit(f"error: hash collision between '{pack_path}' and '{entries[h]}', rename one of the files")
+        entries[h] = pack_path
+    hashes = sorted(entries.keys())
+    offset = HEADER_SIZE + len(hashes) * ENTRY_SIZE
+    index = []
+    for h in hashes:
+        offset = (offset + DATA_ALIGN - 1) & ~(DATA_ALIGN - 1)
+        size = os.path.getsize(files[entries[h]])
+        index.append((h, offset, size))
+        offset += size
+    with open(out_path, 'wb') as out:
+        out.write(struct.pack('<IIII', MAGIC, VERSION, len(hashes), 0))
+        for h, offset, size in index:
+            out.write(struct.pack('<QQQII', h, offset, size, 0, 0))
+        for h, offset, size in index:
+            out.write(b'\0' * (offset - out.tell()))
+            with open(files[entries[h]], 'rb') as src:
+                out.write(src.read())
+        return len(hashes), out.tell()
+
+def main():
+    parser = argparse.ArgumentParser(description='Build a pack file for sokol_fetch.h')
+    parser.add_argument('--prefix', default='', help='prefix for all paths in the pack file')
+    parser.add_argument('output', help='output pack file')
+    parser.add_argument('dirs', nargs='+', help='directories to pack')
+    args = parser.parse_args()
+    files = collect_files(args.dirs, args.prefix)
+    num_files, num_bytes = build_pack(args.output, files)
+    print(f"{args.output}: {num_files} files, {num_bytes} bytes")
+
+if __name__ == '__main__':
+    main()
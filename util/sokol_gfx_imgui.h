@@ -328,6 +328,9 @@ typedef enum sg_imgui_cmd_t {
     SG_IMGUI_CMD_DESTROY_PASS,
     SG_IMGUI_CMD_UPDATE_BUFFER,
     SG_IMGUI_CMD_UPDATE_IMAGE,
+    SG_IMGUI_CMD_MAP_IMAGE,
+    SG_IMGUI_CMD_UNMAP_IMAGE,
+    SG_IMGUI_CMD_READ_IMAGE_ASYNC,
     SG_IMGUI_CMD_APPEND_BUFFER,
     SG_IMGUI_CMD_BEGIN_DEFAULT_PASS,
     SG_IMGUI_CMD_BEGIN_PASS,
@@ -426,6 +429,22 @@ typedef struct sg_imgui_args_update_image_t {
     sg_image image;
 } sg_imgui_args_update_image_t;
 
+typedef struct sg_imgui_args_map_image_t {
+    sg_image image;
+    size_t result_size;
+} sg_imgui_args_map_image_t;
+
+typedef struct sg_imgui_args_unmap_image_t {
+    sg_image image;
+} sg_imgui_args_unmap_image_t;
+
+typedef struct sg_imgui_args_read_image_async_t {
+    sg_image image;
+    sg_rect rect;
+    size_t buffer_size;
+    bool result;
+} sg_imgui_args_read_image_async_t;
+
 typedef struct sg_imgui_args_append_buffer_t {
     sg_buffer buffer;
     size_t data_size;
@@ -592,6 +611,9 @@ typedef union sg_imgui_args_t {
     sg_imgui_args_destroy_pass_t destroy_pass;
     sg_imgui_args_update_buffer_t update_buffer;
     sg_imgui_args_update_image_t update_image;
+    sg_imgui_args_map_image_t map_image;
+    sg_imgui_args_unmap_image_t unmap_image;
+    sg_imgui_args_read_image_async_t read_image_async;
     sg_imgui_args_append_buffer_t append_buffer;
     sg_imgui_args_begin_default_pass_t begin_default_pass;
     sg_imgui_args_begin_pass_t begin_pass;
@@ -1762,6 +1784,34 @@ _SOKOL_PRIVATE sg_imgui_str_t _sg_imgui_capture_item_string(sg_imgui_t* ctx, int
             }
             break;
 
+        case SG_IMGUI_CMD_MAP_IMAGE:
+            {
+                sg_imgui_str_t res_id = _sg_imgui_image_id_string(ctx, item->args.map_image.image);
+                _sg_imgui_snprintf(&str, "%d: sg_map_image(img=%s) => size=%d", index, res_id.buf, item->args.map_image.result_size);
+            }
+            break;
+
+        case SG_IMGUI_CMD_UNMAP_IMAGE:
+            {
+                sg_imgui_str_t res_id = _sg_imgui_image_id_string(ctx, item->args.unmap_image.image);
+                _sg_imgui_snprintf(&str, "%d: sg_unmap_image(img=%s)", index, res_id.buf);
+            }
+            break;
+
+        case SG_IMGUI_CMD_READ_IMAGE_ASYNC:
+            {
+                sg_imgui_str_t res_id = _sg_imgui_image_id_string(ctx, item->args.read_image_async.image);
+                _sg_imgui_snprintf(&str, "%d: sg_read_image_async(img=%s, rect=(%d,%d,%d,%d), buffer.size=%d) => %s",
+                    index, res_id.buf,
+                    item->args.read_image_async.rect.x,
+                    item->args.read_image_async.rect.y,
+                    item->args.read_image_async.rect.width,
+                    item->args.read_image_async.rect.height,
+                    item->args.read_image_async.buffer_size,
+                    _sg_imgui_bool_string(item->args.read_image_async.result));
+            }
+            break;
+
         case SG_IMGUI_CMD_APPEND_BUFFER:
             {
                 sg_imgui_str_t res_id = _sg_imgui_buffer_id_string(ctx, item->args.append_buffer.buffer);
@@ -2281,6 +2331,52 @@ _SOKOL_PRIVATE void _sg_imgui_update_image(sg_image img, const sg_image_data* da
     }
 }
 
+_SOKOL_PRIVATE void _sg_imgui_map_image(sg_image img, sg_range result, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_MAP_IMAGE;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.map_image.image = img;
+        item->args.map_image.result_size = result.size;
+    }
+    if (ctx->hooks.map_image) {
+        ctx->hooks.map_image(img, result, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_unmap_image(sg_image img, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_UNMAP_IMAGE;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.unmap_image.image = img;
+    }
+    if (ctx->hooks.unmap_image) {
+        ctx->hooks.unmap_image(img, ctx->hooks.user_data);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_imgui_read_image_async(sg_image img, const sg_rect* rect, const sg_range* buffer, bool result, void* user_data) {
+    sg_imgui_t* ctx = (sg_imgui_t*) user_data;
+    SOKOL_ASSERT(ctx);
+    sg_imgui_capture_item_t* item = _sg_imgui_capture_next_write_item(ctx);
+    if (item) {
+        item->cmd = SG_IMGUI_CMD_READ_IMAGE_ASYNC;
+        item->color = _SG_IMGUI_COLOR_RSRC;
+        item->args.read_image_async.image = img;
+        item->args.read_image_async.rect = *rect;
+        item->args.read_image_async.buffer_size = buffer->size;
+        item->args.read_image_async.result = result;
+    }
+    if (ctx->hooks.read_image_async) {
+        ctx->hooks.read_image_async(img, rect, buffer, result, ctx->hooks.user_data);
+    }
+}
+
 _SOKOL_PRIVATE void _sg_imgui_append_buffer(sg_buffer buf, const sg_range* data, int result, void* user_data) {
     sg_imgui_t* ctx = (sg_imgui_t*) user_data;
     SOKOL_ASSERT(ctx);
@@ -3803,6 +3899,15 @@ _SOKOL_PRIVATE void _sg_imgui_draw_capture_panel(sg_imgui_t* ctx) {
         case SG_IMGUI_CMD_UPDATE_IMAGE:
             _sg_imgui_draw_image_panel(ctx, item->args.update_image.image);
             break;
+        case SG_IMGUI_CMD_MAP_IMAGE:
+            _sg_imgui_draw_image_panel(ctx, item->args.map_image.image);
+            break;
+        case SG_IMGUI_CMD_UNMAP_IMAGE:
+            _sg_imgui_draw_image_panel(ctx, item->args.unmap_image.image);
+            break;
+        case SG_IMGUI_CMD_READ_IMAGE_ASYNC:
+            _sg_imgui_draw_image_panel(ctx, item->args.read_image_async.image);
+            break;
         case SG_IMGUI_CMD_APPEND_BUFFER:
             _sg_imgui_draw_buffer_panel(ctx, item->args.update_buffer.buffer);
             break;
@@ -3957,6 +4062,9 @@ SOKOL_API_IMPL void sg_imgui_init(sg_imgui_t* ctx, const sg_imgui_desc_t* desc)
     hooks.destroy_pass = _sg_imgui_destroy_pass;
     hooks.update_buffer = _sg_imgui_update_buffer;
     hooks.update_image = _sg_imgui_update_image;
+    hooks.map_image = _sg_imgui_map_image;
+    hooks.unmap_image = _sg_imgui_unmap_image;
+    hooks.read_image_async = _sg_imgui_read_image_async;
     hooks.append_buffer = _sg_imgui_append_buffer;
     hooks.begin_default_pass = _sg_imgui_begin_default_pass;
     hooks.begin_pass = _sg_imgui_begin_pass;
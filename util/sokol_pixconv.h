@@ -0,0 +1,587 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_PIXCONV_IMPL)
+#define SOKOL_PIXCONV_IMPL
+#endif
+#ifndef SOKOL_PIXCONV_INCLUDED
+/*
+    sokol_pixconv.h -- SIMD pixel format conversion for sokol_gfx.h texture uploads
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_PIXCONV_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_pixconv.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)         - your own assert macro (default: assert(c))
+    SOKOL_PIXCONV_API_DECL  - public function declaration prefix (default: extern)
+    SOKOL_API_DECL          - same as SOKOL_PIXCONV_API_DECL
+    SOKOL_API_IMPL          - public function implementation prefix (default: -)
+    SOKOL_PIXCONV_NO_SIMD   - define this to only use the portable scalar code paths
+
+    If sokol_pixconv.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_PIXCONV_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_gfx.h doesn't do any pixel format conversion, the data passed
+    into sg_make_image() and sg_update_image() must already be in the
+    image's pixel format. Image data often comes in a format that
+    doesn't have an SG_PIXELFORMAT_* equivalent though (for instance
+    RGB8 or big-endian 16-bit PNG data), or must be converted to
+    a format which is supported for sampling and filtering on all
+    platforms (like RGBA8 or RGBA16F).
+
+    sokol_pixconv.h provides a small set of conversion functions which
+    write into a caller-provided destination buffer:
+
+        - RGB8 => RGBA8 (alpha is set to 255)
+        - BGRA8 <=> RGBA8
+        - float32 => float16 (for SG_PIXELFORMAT_RGBA16F etc.)
+        - big-endian <=> little-endian 16-bit values (e.g. 16-bit PNG
+          data for SG_PIXELFORMAT_RGBA16)
+        - RGBA8 => premultiplied-alpha RGBA8
+        - sRGB <=> linear for RGBA8 (alpha is left untouched)
+        - sRGB RGBA8 => linear RGBA16F
+
+    The conversion functions use SIMD instructions where they are available
+    at compile time:
+
+        - SSE2 (the baseline on x86-64)
+        - SSSE3 for the RGB8 => RGBA8 expansion
+        - AVX2 for BGRA8 <=> RGBA8, premultiply and 16-bit byte-swapping
+        - F16C for float32 => float16
+        - NEON on ARM (float32 => float16 only on AArch64)
+
+    On x86, SSSE3, AVX2 and F16C must be enabled through compiler options
+    (e.g. -mavx2 -mf16c, -march=haswell or /arch:AVX2), otherwise only
+    the SSE2 code paths are used. The sRGB <=> linear conversions are
+    lookup-table based and always scalar.
+
+    All SIMD code paths produce bit-identical results to the scalar
+    code paths. Source and destination pointers don't need to be aligned.
+    When source and destination pixels have the same size, the conversion
+    may happen in place (source and destination pointers are identical).
+
+    STEP-BY-STEP:
+    =============
+
+    Convert the pixel data into a scratch buffer before passing it into
+    sg_make_image() or sg_update_image():
+
+    ```c
+    // RGB8 data from an image loader into an RGBA8 texture
+    uint32_t* rgba = malloc(width * height * 4);
+    spconv_rgb8_to_rgba8(rgba, rgb, width * height);
+    sg_image img = sg_make_image(&(sg_image_desc){
+        .width = width,
+        .height = height,
+        .pixel_format = SG_PIXELFORMAT_RGBA8,
+        .data.subimage[0][0] = { .ptr = rgba, .size = width * height * 4 }
+    });
+    free(rgba);
+    ```
+
+    For float32 data and an SG_PIXELFORMAT_RGBA16F image:
+
+    ```c
+    spconv_f32_to_f16(halfs, floats, width * height * 4);
+    ```
+
+    Call spconv_query_simd() to get a human-readable string with the SIMD
+    instruction sets that have been compiled in (e.g. "sse2+ssse3+avx2+f16c").
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_PIXCONV_INCLUDED
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_pixconv.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_PIXCONV_API_DECL)
+#define SOKOL_PIXCONV_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_PIXCONV_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_PIXCONV_IMPL)
+#define SOKOL_PIXCONV_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_PIXCONV_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_PIXCONV_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* expand RGB8 to RGBA8 with alpha = 255 (dst: num_pixels*4 bytes, src: num_pixels*3 bytes) */
+SOKOL_PIXCONV_API_DECL void spconv_rgb8_to_rgba8(void* dst, const void* src, size_t num_pixels);
+/* swap the R and B channels of 4-byte pixels (BGRA8 => RGBA8 and RGBA8 => BGRA8), may be in-place */
+SOKOL_PIXCONV_API_DECL void spconv_bgra8_to_rgba8(void* dst, const void* src, size_t num_pixels);
+/* convert float32 to float16 values with round-to-nearest-even, num_values = num_pixels * num_channels */
+SOKOL_PIXCONV_API_DECL void spconv_f32_to_f16(void* dst, const float* src, size_t num_values);
+/* byte-swap 16-bit values (e.g. big-endian 16-bit PNG data => SG_PIXELFORMAT_RGBA16), may be in-place */
+SOKOL_PIXCONV_API_DECL void spconv_swap_u16(void* dst, const void* src, size_t num_values);
+/* multiply RGB with alpha for RGBA8 pixels, may be in-place */
+SOKOL_PIXCONV_API_DECL void spconv_premultiply_rgba8(void* dst, const void* src, size_t num_pixels);
+/* convert the RGB channels of RGBA8 pixels from sRGB to linear color space, may be in-place */
+SOKOL_PIXCONV_API_DECL void spconv_srgb_to_linear_rgba8(void* dst, const void* src, size_t num_pixels);
+/* convert the RGB channels of RGBA8 pixels from linear to sRGB color space, may be in-place */
+SOKOL_PIXCONV_API_DECL void spconv_linear_to_srgb_rgba8(void* dst, const void* src, size_t num_pixels);
+/* convert sRGB RGBA8 pixels to linear RGBA16F pixels (dst: num_pixels*8 bytes) */
+SOKOL_PIXCONV_API_DECL void spconv_srgb_rgba8_to_linear_rgba16f(void* dst, const void* src, size_t num_pixels);
+/* return the compiled-in SIMD instruction sets as string (e.g. "sse2+ssse3", or "scalar") */
+SOKOL_PIXCONV_API_DECL const char* spconv_query_simd(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_PIXCONV_INCLUDED
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_PIXCONV_IMPL
+#define SOKOL_PIXCONV_IMPL_INCLUDED (1)
+
+#include <string.h> // memcpy
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+
+#if !defined(SOKOL_PIXCONV_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define _SPCONV_SSE2 (1)
+        #include <emmintrin.h>
+    #endif
+    #if defined(__SSSE3__) || defined(__AVX2__)
+        #define _SPCONV_SSSE3 (1)
+        #include <tmmintrin.h>
+    #endif
+    #if defined(__AVX2__)
+        #define _SPCONV_AVX2 (1)
+        #include <immintrin.h>
+    #endif
+    // MSVC has no F16C define, but all AVX2 CPUs support F16C
+    #if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define _SPCONV_F16C (1)
+        #include <immintrin.h>
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        #define _SPCONV_NEON (1)
+        #include <arm_neon.h>
+        #if defined(__aarch64__) || defined(_M_ARM64)
+            #define _SPCONV_NEON_FP16 (1)
+        #endif
+    #endif
+#endif
+
+/* generated with: round(255 * srgb_to_linear(i / 255)) etc. */
+static const uint8_t _spconv_srgb_to_linear_u8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,
+      4,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,   6,   7,   7,   7,
+      8,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  12,  12,  12,  13,
+     13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  17,  18,  18,  19,  19,  20,
+     20,  21,  22,  22,  23,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+     30,  30,  31,  32,  32,  33,  34,  35,  35,  36,  37,  37,  38,  39,  40,  41,
+     41,  42,  43,  44,  45,  45,  46,  47,  48,  49,  50,  51,  51,  52,  53,  54,
+     55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,
+     71,  72,  73,  74,  76,  77,  78,  79,  80,  81,  82,  84,  85,  86,  87,  88,
+     90,  91,  92,  93,  95,  96,  97,  99, 100, 101, 103, 104, 105, 107, 108, 109,
+    111, 112, 114, 115, 116, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133,
+    134, 136, 138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159,
+    161, 163, 164, 166, 168, 170, 171, 173, 175, 177, 179, 181, 183, 184, 186, 188,
+    190, 192, 194, 196, 198, 200, 202, 204, 206, 208, 210, 212, 214, 216, 218, 220,
+    222, 224, 226, 229, 231, 233, 235, 237, 239, 242, 244, 246, 248, 250, 253, 255,
+};
+static const uint8_t _spconv_linear_to_srgb_u8[256] = {
+      0,  13,  22,  28,  34,  38,  42,  46,  50,  53,  56,  59,  61,  64,  66,  69,
+     71,  73,  75,  77,  79,  81,  83,  85,  86,  88,  90,  92,  93,  95,  96,  98,
+     99, 101, 102, 104, 105, 106, 108, 109, 110, 112, 113, 114, 115, 117, 118, 119,
+    120, 121, 122, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136,
+    137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 148, 149, 150, 151,
+    152, 153, 154, 155, 155, 156, 157, 158, 159, 159, 160, 161, 162, 163, 163, 164,
+    165, 166, 167, 167, 168, 169, 170, 170, 171, 172, 173, 173, 174, 175, 175, 176,
+    177, 178, 178, 179, 180, 180, 181, 182, 182, 183, 184, 185, 185, 186, 187, 187,
+    188, 189, 189, 190, 190, 191, 192, 192, 193, 194, 194, 195, 196, 196, 197, 197,
+    198, 199, 199, 200, 200, 201, 202, 202, 203, 203, 204, 205, 205, 206, 206, 207,
+    208, 208, 209, 209, 210, 210, 211, 212, 212, 213, 213, 214, 214, 215, 215, 216,
+    216, 217, 218, 218, 219, 219, 220, 220, 221, 221, 222, 222, 223, 223, 224, 224,
+    225, 226, 226, 227, 227, 228, 228, 229, 229, 230, 230, 231, 231, 232, 232, 233,
+    233, 234, 234, 235, 235, 236, 236, 237, 237, 238, 238, 238, 239, 239, 240, 240,
+    241, 241, 242, 242, 243, 243, 244, 244, 245, 245, 246, 246, 246, 247, 247, 248,
+    248, 249, 249, 250, 250, 251, 251, 251, 252, 252, 253, 253, 254, 254, 255, 255,
+};
+static const uint16_t _spconv_srgb_to_linear_f16[256] = {
+    0x0000, 0x0CF9, 0x10F9, 0x1376, 0x14F9, 0x1637, 0x1776, 0x185A, 0x18F9, 0x1998, 0x1A37, 0x1ADB,
+    0x1B88, 0x1C1F, 0x1C7F, 0x1CE4, 0x1D4E, 0x1DBD, 0x1E32, 0x1EAB, 0x1F2A, 0x1FAE, 0x201C, 0x2063,
+    0x20AD, 0x20FA, 0x214A, 0x219D, 0x21F2, 0x224A, 0x22A6, 0x2304, 0x2365, 0x23C9, 0x2418, 0x244D,
+    0x2484, 0x24BC, 0x24F6, 0x2532, 0x256F, 0x25AD, 0x25ED, 0x262F, 0x2673, 0x26B8, 0x26FF, 0x2747,
+    0x2791, 0x27DD, 0x2815, 0x283D, 0x2865, 0x288F, 0x28B9, 0x28E4, 0x2910, 0x293D, 0x296A, 0x2999,
+    0x29C9, 0x29F9, 0x2A2A, 0x2A5D, 0x2A90, 0x2AC4, 0x2AF9, 0x2B2F, 0x2B66, 0x2B9E, 0x2BD7, 0x2C08,
+    0x2C26, 0x2C44, 0x2C62, 0x2C81, 0x2CA0, 0x2CC0, 0x2CE0, 0x2D01, 0x2D22, 0x2D44, 0x2D66, 0x2D89,
+    0x2DAD, 0x2DD0, 0x2DF5, 0x2E1A, 0x2E3F, 0x2E65, 0x2E8B, 0x2EB2, 0x2ED9, 0x2F01, 0x2F2A, 0x2F53,
+    0x2F7C, 0x2FA7, 0x2FD1, 0x2FFC, 0x3014, 0x302A, 0x3040, 0x3057, 0x306E, 0x3085, 0x309D, 0x30B4,
+    0x30CC, 0x30E5, 0x30FD, 0x3116, 0x312F, 0x3149, 0x3162, 0x317C, 0x3197, 0x31B1, 0x31CC, 0x31E7,
+    0x3203, 0x321E, 0x323A, 0x3257, 0x3273, 0x3290, 0x32AD, 0x32CB, 0x32E8, 0x3306, 0x3325, 0x3343,
+    0x3362, 0x3381, 0x33A1, 0x33C1, 0x33E1, 0x3401, 0x3411, 0x3422, 0x3432, 0x3443, 0x3454, 0x3465,
+    0x3476, 0x3488, 0x3499, 0x34AB, 0x34BD, 0x34CF, 0x34E1, 0x34F4, 0x3506, 0x3519, 0x352C, 0x353F,
+    0x3552, 0x3565, 0x3578, 0x358C, 0x35A0, 0x35B4, 0x35C8, 0x35DC, 0x35F1, 0x3605, 0x361A, 0x362F,
+    0x3644, 0x3659, 0x366F, 0x3684, 0x369A, 0x36B0, 0x36C6, 0x36DC, 0x36F2, 0x3709, 0x3720, 0x3736,
+    0x374D, 0x3765, 0x377C, 0x3794, 0x37AB, 0x37C3, 0x37DB, 0x37F3, 0x3806, 0x3812, 0x381F, 0x382B,
+    0x3838, 0x3844, 0x3851, 0x385E, 0x386B, 0x3877, 0x3885, 0x3892, 0x389F, 0x38AC, 0x38BA, 0x38C7,
+    0x38D5, 0x38E2, 0x38F0, 0x38FE, 0x390C, 0x391A, 0x3928, 0x3936, 0x3944, 0x3953, 0x3961, 0x3970,
+    0x397E, 0x398D, 0x399C, 0x39AB, 0x39BA, 0x39C9, 0x39D8, 0x39E7, 0x39F7, 0x3A06, 0x3A16, 0x3A25,
+    0x3A35, 0x3A45, 0x3A55, 0x3A65, 0x3A75, 0x3A85, 0x3A95, 0x3AA5, 0x3AB6, 0x3AC6, 0x3AD7, 0x3AE8,
+    0x3AF9, 0x3B09, 0x3B1A, 0x3B2C, 0x3B3D, 0x3B4E, 0x3B5F, 0x3B71, 0x3B82, 0x3B94, 0x3BA6, 0x3BB8,
+    0x3BCA, 0x3BDC, 0x3BEE, 0x3C00,
+};
+
+/* round-to-nearest-even float32 => float16, identical to F16C and NEON conversions */
+static uint16_t _spconv_f32_to_f16(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000;
+    const uint32_t exp = (x >> 23) & 0xFF;
+    uint32_t mant = x & 0x7FFFFF;
+    if (exp == 0xFF) {
+        // infinity or NaN (NaNs are quieted)
+        return (uint16_t)(sign | 0x7C00 | ((mant != 0) ? (0x200 | (mant >> 13)) : 0));
+    }
+    const int e = (int)exp - 127 + 15;
+    if (e >= 31) {
+        // overflow to infinity
+        return (uint16_t)(sign | 0x7C00);
+    }
+    if (e <= 0) {
+        // result is a denormal or zero
+        if (e < -10) {
+            return (uint16_t)sign;
+        }
+        mant |= 0x800000;
+        const uint32_t shift = (uint32_t)(14 - e);
+        uint32_t half_mant = mant >> shift;
+        const uint32_t rem = mant & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if ((rem > halfway) || ((rem == halfway) && (half_mant & 1))) {
+            half_mant++;
+        }
+        return (uint16_t)(sign | half_mant);
+    }
+    uint32_t half = sign | ((uint32_t)e << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1FFF;
+    // a carry into the exponent is correct (rounds up to the next power of two or infinity)
+    if ((rem > 0x1000) || ((rem == 0x1000) && (half & 1))) {
+        half++;
+    }
+    return (uint16_t)half;
+}
+
+/* (c * a) / 255 with rounding, identical to the SIMD code paths */
+static inline uint8_t _spconv_mul_div255(uint32_t c, uint32_t a) {
+    const uint32_t t = c * a + 128;
+    return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+/*=== PUBLIC API FUNCTIONS ===================================================*/
+SOKOL_API_IMPL void spconv_rgb8_to_rgba8(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    size_t i = 0;
+    #if defined(_SPCONV_SSSE3)
+    {
+        const __m128i shuf = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+        for (; (i + 16) <= num_pixels; i += 16, src += 48, dst += 64) {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(src + 0));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+            const __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+            const __m128i p0 = _mm_shuffle_epi8(a, shuf);
+            const __m128i p1 = _mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuf);
+            const __m128i p2 = _mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuf);
+            const __m128i p3 = _mm_shuffle_epi8(_mm_srli_si128(c, 4), shuf);
+            _mm_storeu_si128((__m128i*)(dst + 0), _mm_or_si128(p0, alpha));
+            _mm_storeu_si128((__m128i*)(dst + 16), _mm_or_si128(p1, alpha));
+            _mm_storeu_si128((__m128i*)(dst + 32), _mm_or_si128(p2, alpha));
+            _mm_storeu_si128((__m128i*)(dst + 48), _mm_or_si128(p3, alpha));
+        }
+    }
+    #elif defined(_SPCONV_NEON)
+    for (; (i + 16) <= num_pixels; i += 16, src += 48, dst += 64) {
+        const uint8x16x3_t rgb = vld3q_u8(src);
+        uint8x16x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst, rgba);
+    }
+    #endif
+    for (; i < num_pixels; i++, src += 3, dst += 4) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 0xFF;
+    }
+}
+
+SOKOL_API_IMPL void spconv_bgra8_to_rgba8(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    size_t i = 0;
+    #if defined(_SPCONV_AVX2)
+    {
+        const __m256i ag_mask = _mm256_set1_epi32((int)0xFF00FF00);
+        const __m256i rb_mask = _mm256_set1_epi32(0x00FF00FF);
+        for (; (i + 8) <= num_pixels; i += 8, src += 32, dst += 32) {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)src);
+            const __m256i ag = _mm256_and_si256(v, ag_mask);
+            const __m256i rb = _mm256_and_si256(v, rb_mask);
+            const __m256i br = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+            _mm256_storeu_si256((__m256i*)dst, _mm256_or_si256(ag, br));
+        }
+    }
+    #endif
+    #if defined(_SPCONV_SSE2)
+    {
+        const __m128i ag_mask = _mm_set1_epi32((int)0xFF00FF00);
+        const __m128i rb_mask = _mm_set1_epi32(0x00FF00FF);
+        for (; (i + 4) <= num_pixels; i += 4, src += 16, dst += 16) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)src);
+            const __m128i ag = _mm_and_si128(v, ag_mask);
+            const __m128i rb = _mm_and_si128(v, rb_mask);
+            const __m128i br = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+            _mm_storeu_si128((__m128i*)dst, _mm_or_si128(ag, br));
+        }
+    }
+    #elif defined(_SPCONV_NEON)
+    for (; (i + 16) <= num_pixels; i += 16, src += 64, dst += 64) {
+        uint8x16x4_t v = vld4q_u8(src);
+        const uint8x16_t tmp = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = tmp;
+        vst4q_u8(dst, v);
+    }
+    #endif
+    for (; i < num_pixels; i++, src += 4, dst += 4) {
+        const uint8_t r = src[2];
+        const uint8_t b = src[0];
+        dst[0] = r;
+        dst[1] = src[1];
+        dst[2] = b;
+        dst[3] = src[3];
+    }
+}
+
+SOKOL_API_IMPL void spconv_f32_to_f16(void* dst_ptr, const float* src, size_t num_values) {
+    SOKOL_ASSERT(dst_ptr && src);
+    uint16_t* dst = (uint16_t*) dst_ptr;
+    size_t i = 0;
+    #if defined(_SPCONV_F16C)
+    for (; (i + 4) <= num_values; i += 4) {
+        const __m128i h = _mm_cvtps_ph(_mm_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storel_epi64((__m128i*)(dst + i), h);
+    }
+    #elif defined(_SPCONV_NEON_FP16)
+    for (; (i + 4) <= num_values; i += 4) {
+        const float16x4_t h = vcvt_f16_f32(vld1q_f32(src + i));
+        vst1_u16(dst + i, vreinterpret_u16_f16(h));
+    }
+    #endif
+    for (; i < num_values; i++) {
+        dst[i] = _spconv_f32_to_f16(src[i]);
+    }
+}
+
+SOKOL_API_IMPL void spconv_swap_u16(void* dst_ptr, const void* src_ptr, size_t num_values) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    size_t i = 0;
+    #if defined(_SPCONV_AVX2)
+    for (; (i + 16) <= num_values; i += 16, src += 32, dst += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)src);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)));
+    }
+    #endif
+    #if defined(_SPCONV_SSE2)
+    for (; (i + 8) <= num_values; i += 8, src += 16, dst += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+    #elif defined(_SPCONV_NEON)
+    for (; (i + 8) <= num_values; i += 8, src += 16, dst += 16) {
+        vst1q_u8(dst, vrev16q_u8(vld1q_u8(src)));
+    }
+    #endif
+    for (; i < num_values; i++, src += 2, dst += 2) {
+        const uint8_t lo = src[0];
+        dst[0] = src[1];
+        dst[1] = lo;
+    }
+}
+
+SOKOL_API_IMPL void spconv_premultiply_rgba8(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    size_t i = 0;
+    #if defined(_SPCONV_AVX2)
+    {
+        // NOTE: unpack, shuffle and pack all operate within 128-bit lanes, so the pixel order is preserved
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i round = _mm256_set1_epi16(128);
+        const __m256i alpha_mask = _mm256_set1_epi32((int)0xFF000000);
+        for (; (i + 8) <= num_pixels; i += 8, src += 32, dst += 32) {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)src);
+            __m256i lo = _mm256_unpacklo_epi8(v, zero);
+            __m256i hi = _mm256_unpackhi_epi8(v, zero);
+            const __m256i alo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xFF), 0xFF);
+            const __m256i ahi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xFF), 0xFF);
+            lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, alo), round);
+            hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, ahi), round);
+            lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+            const __m256i rgb = _mm256_andnot_si256(alpha_mask, _mm256_packus_epi16(lo, hi));
+            _mm256_storeu_si256((__m256i*)dst, _mm256_or_si256(rgb, _mm256_and_si256(v, alpha_mask)));
+        }
+    }
+    #endif
+    #if defined(_SPCONV_SSE2)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi16(128);
+        const __m128i alpha_mask = _mm_set1_epi32((int)0xFF000000);
+        for (; (i + 4) <= num_pixels; i += 4, src += 16, dst += 16) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)src);
+            __m128i lo = _mm_unpacklo_epi8(v, zero);
+            __m128i hi = _mm_unpackhi_epi8(v, zero);
+            const __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+            const __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+            lo = _mm_add_epi16(_mm_mullo_epi16(lo, alo), round);
+            hi = _mm_add_epi16(_mm_mullo_epi16(hi, ahi), round);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            const __m128i rgb = _mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi));
+            _mm_storeu_si128((__m128i*)dst, _mm_or_si128(rgb, _mm_and_si128(v, alpha_mask)));
+        }
+    }
+    #elif defined(_SPCONV_NEON)
+    for (; (i + 8) <= num_pixels; i += 8, src += 32, dst += 32) {
+        uint8x8x4_t v = vld4_u8(src);
+        for (int c = 0; c < 3; c++) {
+            const uint16x8_t x = vmull_u8(v.val[c], v.val[3]);
+            v.val[c] = vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+        }
+        vst4_u8(dst, v);
+    }
+    #endif
+    for (; i < num_pixels; i++, src += 4, dst += 4) {
+        const uint32_t a = src[3];
+        dst[0] = _spconv_mul_div255(src[0], a);
+        dst[1] = _spconv_mul_div255(src[1], a);
+        dst[2] = _spconv_mul_div255(src[2], a);
+        dst[3] = (uint8_t)a;
+    }
+}
+
+SOKOL_API_IMPL void spconv_srgb_to_linear_rgba8(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    for (size_t i = 0; i < num_pixels; i++, src += 4, dst += 4) {
+        dst[0] = _spconv_srgb_to_linear_u8[src[0]];
+        dst[1] = _spconv_srgb_to_linear_u8[src[1]];
+        dst[2] = _spconv_srgb_to_linear_u8[src[2]];
+        dst[3] = src[3];
+    }
+}
+
+SOKOL_API_IMPL void spconv_linear_to_srgb_rgba8(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint8_t* dst = (uint8_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    for (size_t i = 0; i < num_pixels; i++, src += 4, dst += 4) {
+        dst[0] = _spconv_linear_to_srgb_u8[src[0]];
+        dst[1] = _spconv_linear_to_srgb_u8[src[1]];
+        dst[2] = _spconv_linear_to_srgb_u8[src[2]];
+        dst[3] = src[3];
+    }
+}
+
+SOKOL_API_IMPL void spconv_srgb_rgba8_to_linear_rgba16f(void* dst_ptr, const void* src_ptr, size_t num_pixels) {
+    SOKOL_ASSERT(dst_ptr && src_ptr);
+    uint16_t* dst = (uint16_t*) dst_ptr;
+    const uint8_t* src = (const uint8_t*) src_ptr;
+    for (size_t i = 0; i < num_pixels; i++, src += 4, dst += 4) {
+        dst[0] = _spconv_srgb_to_linear_f16[src[0]];
+        dst[1] = _spconv_srgb_to_linear_f16[src[1]];
+        dst[2] = _spconv_srgb_to_linear_f16[src[2]];
+        dst[3] = _spconv_f32_to_f16((float)src[3] / 255.0f);
+    }
+}
+
+SOKOL_API_IMPL const char* spconv_query_simd(void) {
+    #if defined(_SPCONV_AVX2) && defined(_SPCONV_F16C)
+    return "sse2+ssse3+avx2+f16c";
+    #elif defined(_SPCONV_AVX2)
+    return "sse2+ssse3+avx2";
+    #elif defined(_SPCONV_SSSE3) && defined(_SPCONV_F16C)
+    return "sse2+ssse3+f16c";
+    #elif defined(_SPCONV_SSSE3)
+    return "sse2+ssse3";
+    #elif defined(_SPCONV_SSE2)
+    return "sse2";
+    #elif defined(_SPCONV_NEON)
+    return "neon";
+    #else
+    return "scalar";
+    #endif
+}
+
+#endif // SOKOL_PIXCONV_IMPL
@@ -0,0 +1,1029 @@
+#if defined(SOKOL_IMPL) && !defined(SOKOL_TEXFILE_IMPL)
+#define SOKOL_TEXFILE_IMPL
+#endif
+#ifndef SOKOL_TEXFILE_INCLUDED
+/*
+    sokol_texfile.h -- zero-copy DDS and KTX texture file parsing for sokol_gfx.h
+
+    Project URL: https://github.com/floooh/sokol
+
+    Do this:
+        #define SOKOL_IMPL or
+        #define SOKOL_TEXFILE_IMPL
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Include the following headers before including sokol_texfile.h:
+
+        sokol_gfx.h
+
+    ...optionally provide the following macros to override defaults:
+
+    SOKOL_ASSERT(c)         - your own assert macro (default: assert(c))
+    SOKOL_TEXFILE_API_DECL  - public function declaration prefix (default: extern)
+    SOKOL_API_DECL          - same as SOKOL_TEXFILE_API_DECL
+    SOKOL_API_IMPL          - public function implementation prefix (default: -)
+
+    If sokol_texfile.h is compiled as a DLL, define the following before
+    including the declaration or implementation:
+
+    SOKOL_DLL
+
+    On Windows, SOKOL_DLL will define SOKOL_TEXFILE_API_DECL as __declspec(dllexport)
+    or __declspec(dllimport) as needed.
+
+    FEATURE OVERVIEW
+    ================
+    sokol_texfile.h parses the headers of the following texture container
+    file formats which have already been loaded (or memory-mapped) into
+    memory, and fills an sg_image_data struct with pointers *into* that
+    memory, there are no intermediate copies or pixel format conversions:
+
+        - DDS (including the DX10 header extension)
+        - KTX version 1
+        - KTX version 2 (without supercompression)
+
+    The following image types are supported:
+
+        - 2D textures
+        - cubemaps
+        - 3D textures
+        - array textures
+
+    The following pixel formats are recognized (as long as sokol_gfx.h has
+    an equivalent SG_PIXELFORMAT_*):
+
+        - BC1..BC7 (aka DXTn, RGTC and BPTC)
+        - ETC2 and EAC RG11 (ETC1 is loaded as ETC2_RGB8)
+        - PVRTC (version 1)
+        - uncompressed 8-, 16- and 32-bit normalized, integer and float formats
+
+    sokol_gfx.h doesn't have sRGB pixel formats, sRGB variants are mapped
+    to their linear equivalent.
+
+    Files which would require a copy to be consumed by sokol_gfx.h
+    are rejected, this is the case for:
+
+        - big-endian KTX1 files
+        - KTX1 files with padded pixel rows
+        - DDS array textures with more than one mipmap (DDS stores all
+          mipmaps of an array slice together, while sokol_gfx.h expects
+          all array slices of a mipmap together)
+        - supercompressed KTX2 files (Basis Universal, zstd, zlib)
+
+    STEP-BY-STEP:
+    =============
+
+    Load or memory-map a texture file, for instance via sokol_fetch.h,
+    and call stexf_parse() with an sg_range pointing to the file content:
+
+    ```c
+    static void fetch_callback(const sfetch_response_t* response) {
+        if (response->fetched) {
+            stexf_texture_t tex = stexf_parse(&(sg_range){
+                .ptr = response->buffer_ptr,
+                .size = response->fetched_size
+            });
+            if (tex.valid) {
+                sg_image_desc desc = stexf_image_desc(&tex);
+                desc.min_filter = SG_FILTER_LINEAR_MIPMAP_LINEAR;
+                desc.mag_filter = SG_FILTER_LINEAR;
+                sg_init_image(img, &desc);
+            }
+            else {
+                // tex.error contains an stexf_error_t code
+                sg_fail_image(img);
+            }
+        }
+    }
+    ```
+
+    The returned stexf_texture_t struct contains the image type, size,
+    number of slices and mipmaps, the sokol-gfx pixel format and an
+    sg_image_data struct where each subimage range points into the
+    original memory.
+
+    The memory passed into stexf_parse() must remain valid until the
+    sg_image_desc has been passed to sg_make_image() or sg_init_image().
+
+    Check that the pixel format is actually supported at runtime
+    with sg_query_pixelformat(tex.pixel_format).sample before creating
+    the image.
+
+    LICENSE
+    =======
+    zlib/libpng license
+
+    Copyright (c) 2022 Andre Weissflog
+
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#define SOKOL_TEXFILE_INCLUDED
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_texfile.h"
+#endif
+
+#if defined(SOKOL_API_DECL) && !defined(SOKOL_TEXFILE_API_DECL)
+#define SOKOL_TEXFILE_API_DECL SOKOL_API_DECL
+#endif
+#ifndef SOKOL_TEXFILE_API_DECL
+#if defined(_WIN32) && defined(SOKOL_DLL) && defined(SOKOL_TEXFILE_IMPL)
+#define SOKOL_TEXFILE_API_DECL __declspec(dllexport)
+#elif defined(_WIN32) && defined(SOKOL_DLL)
+#define SOKOL_TEXFILE_API_DECL __declspec(dllimport)
+#else
+#define SOKOL_TEXFILE_API_DECL extern
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the detected texture container format */
+typedef enum stexf_container_t {
+    STEXF_CONTAINER_UNKNOWN,
+    STEXF_CONTAINER_DDS,
+    STEXF_CONTAINER_KTX1,
+    STEXF_CONTAINER_KTX2,
+} stexf_container_t;
+
+/* error codes returned in stexf_texture_t.error */
+typedef enum stexf_error_t {
+    STEXF_ERROR_NO_ERROR,
+    STEXF_ERROR_UNKNOWN_CONTAINER,          /* data doesn't start with a DDS or KTX magic number */
+    STEXF_ERROR_TRUNCATED,                  /* data is smaller than the file headers require */
+    STEXF_ERROR_INVALID_HEADER,             /* inconsistent or invalid header values */
+    STEXF_ERROR_UNSUPPORTED_PIXEL_FORMAT,   /* no matching sokol-gfx pixel format */
+    STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE,     /* e.g. cubemap arrays or 1D textures */
+    STEXF_ERROR_UNSUPPORTED_LAYOUT,         /* file data can't be used without a copy */
+    STEXF_ERROR_UNSUPPORTED_SUPERCOMPRESSION,
+    STEXF_ERROR_TOO_MANY_MIPMAPS,           /* more than SG_MAX_MIPMAPS */
+} stexf_error_t;
+
+/* result of stexf_parse() */
+typedef struct stexf_texture_t {
+    bool valid;
+    stexf_error_t error;
+    stexf_container_t container;
+    sg_image_type type;
+    sg_pixel_format pixel_format;
+    int width;
+    int height;
+    int num_slices;         /* 3D textures: depth; array textures: number of layers */
+    int num_mipmaps;
+    sg_image_data data;     /* pointers into the memory passed to stexf_parse() */
+} stexf_texture_t;
+
+/* parse an in-memory DDS, KTX1 or KTX2 file */
+SOKOL_TEXFILE_API_DECL stexf_texture_t stexf_parse(const sg_range* data);
+/* build an sg_image_desc with type, size, pixel format and content from a parsed texture */
+SOKOL_TEXFILE_API_DECL sg_image_desc stexf_image_desc(const stexf_texture_t* tex);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_TEXFILE_INCLUDED
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef SOKOL_TEXFILE_IMPL
+#define SOKOL_TEXFILE_IMPL_INCLUDED (1)
+
+#include <string.h> // memcpy, memcmp
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wmissing-field-initializers"
+#endif
+
+#ifndef SOKOL_API_IMPL
+    #define SOKOL_API_IMPL
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+
+#define _stexf_max(a,b) (((a)>(b))?(a):(b))
+
+/* max width, height and number of slices, far beyond what any GPU supports */
+#define _STEXF_MAX_DIM (1<<16)
+
+/* all header fields are little-endian, and may be unaligned */
+static uint32_t _stexf_u32(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] | ((uint32_t)ptr[1]<<8) | ((uint32_t)ptr[2]<<16) | ((uint32_t)ptr[3]<<24);
+}
+
+static uint64_t _stexf_u64(const uint8_t* ptr) {
+    return (uint64_t)_stexf_u32(ptr) | ((uint64_t)_stexf_u32(ptr + 4) << 32);
+}
+
+#define _STEXF_FOURCC(a,b,c,d) ((uint32_t)(a) | ((uint32_t)(b)<<8) | ((uint32_t)(c)<<16) | ((uint32_t)(d)<<24))
+
+/* row pitch and number of rows, same as _sg_row_pitch() etc in sokol_gfx.h, but
+   computed in size_t since the dimensions come straight from the file header
+*/
+static size_t _stexf_row_pitch(sg_pixel_format fmt, int width) {
+    SOKOL_ASSERT(width > 0);
+    const size_t w = (size_t)width;
+    switch (fmt) {
+        case SG_PIXELFORMAT_BC1_RGBA:
+        case SG_PIXELFORMAT_BC4_R:
+        case SG_PIXELFORMAT_BC4_RSN:
+        case SG_PIXELFORMAT_ETC2_RGB8:
+        case SG_PIXELFORMAT_ETC2_RGB8A1:
+            return ((w + 3) / 4) * 8;
+        case SG_PIXELFORMAT_BC2_RGBA:
+        case SG_PIXELFORMAT_BC3_RGBA:
+        case SG_PIXELFORMAT_BC5_RG:
+        case SG_PIXELFORMAT_BC5_RGSN:
+        case SG_PIXELFORMAT_BC6H_RGBF:
+        case SG_PIXELFORMAT_BC6H_RGBUF:
+        case SG_PIXELFORMAT_BC7_RGBA:
+        case SG_PIXELFORMAT_ETC2_RGBA8:
+        case SG_PIXELFORMAT_ETC2_RG11:
+        case SG_PIXELFORMAT_ETC2_RG11SN:
+            return ((w + 3) / 4) * 16;
+        case SG_PIXELFORMAT_PVRTC_RGB_4BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_4BPP:
+            return (_stexf_max(w, 8) * 4 + 7) / 8;
+        case SG_PIXELFORMAT_PVRTC_RGB_2BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_2BPP:
+            return (_stexf_max(w, 16) * 2 + 7) / 8;
+        case SG_PIXELFORMAT_R8:
+        case SG_PIXELFORMAT_R8SN:
+        case SG_PIXELFORMAT_R8UI:
+        case SG_PIXELFORMAT_R8SI:
+            return w;
+        case SG_PIXELFORMAT_R16:
+        case SG_PIXELFORMAT_R16SN:
+        case SG_PIXELFORMAT_R16UI:
+        case SG_PIXELFORMAT_R16SI:
+        case SG_PIXELFORMAT_R16F:
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_RG8SN:
+        case SG_PIXELFORMAT_RG8UI:
+        case SG_PIXELFORMAT_RG8SI:
+            return w * 2;
+        case SG_PIXELFORMAT_RG32UI:
+        case SG_PIXELFORMAT_RG32SI:
+        case SG_PIXELFORMAT_RG32F:
+        case SG_PIXELFORMAT_RGBA16:
+        case SG_PIXELFORMAT_RGBA16SN:
+        case SG_PIXELFORMAT_RGBA16UI:
+        case SG_PIXELFORMAT_RGBA16SI:
+        case SG_PIXELFORMAT_RGBA16F:
+            return w * 8;
+        case SG_PIXELFORMAT_RGBA32UI:
+        case SG_PIXELFORMAT_RGBA32SI:
+        case SG_PIXELFORMAT_RGBA32F:
+            return w * 16;
+        default:
+            return w * 4;
+    }
+}
+
+static size_t _stexf_num_rows(sg_pixel_format fmt, int height) {
+    SOKOL_ASSERT(height > 0);
+    const size_t h = (size_t)height;
+    switch (fmt) {
+        case SG_PIXELFORMAT_BC1_RGBA:
+        case SG_PIXELFORMAT_BC4_R:
+        case SG_PIXELFORMAT_BC4_RSN:
+        case SG_PIXELFORMAT_ETC2_RGB8:
+        case SG_PIXELFORMAT_ETC2_RGB8A1:
+        case SG_PIXELFORMAT_ETC2_RGBA8:
+        case SG_PIXELFORMAT_ETC2_RG11:
+        case SG_PIXELFORMAT_ETC2_RG11SN:
+        case SG_PIXELFORMAT_BC2_RGBA:
+        case SG_PIXELFORMAT_BC3_RGBA:
+        case SG_PIXELFORMAT_BC5_RG:
+        case SG_PIXELFORMAT_BC5_RGSN:
+        case SG_PIXELFORMAT_BC6H_RGBF:
+        case SG_PIXELFORMAT_BC6H_RGBUF:
+        case SG_PIXELFORMAT_BC7_RGBA:
+            return (h + 3) / 4;
+        case SG_PIXELFORMAT_PVRTC_RGB_4BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_4BPP:
+        case SG_PIXELFORMAT_PVRTC_RGB_2BPP:
+        case SG_PIXELFORMAT_PVRTC_RGBA_2BPP:
+            return ((_stexf_max(h, 8) + 7) / 8) * 8;
+        default:
+            return h;
+    }
+}
+
+/* overflow-checked size_t arithmetic, sizes and offsets from the header may wrap on 32-bit platforms */
+static bool _stexf_mul(size_t a, size_t b, size_t* res) {
+    if ((b > 0) && (a > (SIZE_MAX / b))) {
+        return false;
+    }
+    *res = a * b;
+    return true;
+}
+
+static bool _stexf_add(size_t a, size_t b, size_t* res) {
+    if (a > (SIZE_MAX - b)) {
+        return false;
+    }
+    *res = a + b;
+    return true;
+}
+
+/* size of all depth- or array-slices of a mipmap, false on overflow */
+static bool _stexf_mip_size(sg_pixel_format fmt, int width, int height, int num_slices, size_t* res) {
+    size_t surface_size;
+    return _stexf_mul(_stexf_num_rows(fmt, height), _stexf_row_pitch(fmt, width), &surface_size) &&
+           _stexf_mul(surface_size, (size_t)num_slices, res);
+}
+
+static int _stexf_mip_dim(int dim, int mip_index) {
+    return _stexf_max(dim >> mip_index, 1);
+}
+
+static stexf_texture_t _stexf_error(stexf_texture_t tex, stexf_error_t err) {
+    tex.valid = false;
+    tex.error = err;
+    return tex;
+}
+
+/* check the common image attributes after the container-specific header has been parsed */
+static stexf_error_t _stexf_validate(const stexf_texture_t* tex) {
+    if ((tex->width < 1) || (tex->height < 1) || (tex->num_slices < 1) || (tex->num_mipmaps < 1)) {
+        return STEXF_ERROR_INVALID_HEADER;
+    }
+    if ((tex->width > _STEXF_MAX_DIM) || (tex->height > _STEXF_MAX_DIM) || (tex->num_slices > _STEXF_MAX_DIM)) {
+        return STEXF_ERROR_INVALID_HEADER;
+    }
+    if (tex->num_mipmaps > SG_MAX_MIPMAPS) {
+        return STEXF_ERROR_TOO_MANY_MIPMAPS;
+    }
+    if (tex->pixel_format == SG_PIXELFORMAT_NONE) {
+        return STEXF_ERROR_UNSUPPORTED_PIXEL_FORMAT;
+    }
+    return STEXF_ERROR_NO_ERROR;
+}
+
+/*== DDS =====================================================================*/
+#define _STEXF_DDS_HEADER_SIZE (124)
+#define _STEXF_DDS_DX10_HEADER_SIZE (20)
+#define _STEXF_DDSD_DEPTH (0x800000)
+#define _STEXF_DDPF_ALPHAPIXELS (0x1)
+#define _STEXF_DDPF_FOURCC (0x4)
+#define _STEXF_DDPF_RGB (0x40)
+#define _STEXF_DDPF_LUMINANCE (0x20000)
+#define _STEXF_DDSCAPS2_CUBEMAP (0x200)
+#define _STEXF_DDSCAPS2_CUBEMAP_ALLFACES (0xFC00)
+#define _STEXF_DDSCAPS2_VOLUME (0x200000)
+#define _STEXF_DDS_DIMENSION_TEXTURE2D (3)
+#define _STEXF_DDS_DIMENSION_TEXTURE3D (4)
+#define _STEXF_DDS_RESOURCE_MISC_TEXTURECUBE (0x4)
+
+static sg_pixel_format _stexf_dxgi_format(uint32_t dxgi_fmt) {
+    switch (dxgi_fmt) {
+        case 2:  return SG_PIXELFORMAT_RGBA32F;     // DXGI_FORMAT_R32G32B32A32_FLOAT
+        case 3:  return SG_PIXELFORMAT_RGBA32UI;
+        case 4:  return SG_PIXELFORMAT_RGBA32SI;
+        case 10: return SG_PIXELFORMAT_RGBA16F;     // DXGI_FORMAT_R16G16B16A16_FLOAT
+        case 11: return SG_PIXELFORMAT_RGBA16;
+        case 12: return SG_PIXELFORMAT_RGBA16UI;
+        case 13: return SG_PIXELFORMAT_RGBA16SN;
+        case 14: return SG_PIXELFORMAT_RGBA16SI;
+        case 16: return SG_PIXELFORMAT_RG32F;       // DXGI_FORMAT_R32G32_FLOAT
+        case 17: return SG_PIXELFORMAT_RG32UI;
+        case 18: return SG_PIXELFORMAT_RG32SI;
+        case 24: return SG_PIXELFORMAT_RGB10A2;     // DXGI_FORMAT_R10G10B10A2_UNORM
+        case 26: return SG_PIXELFORMAT_RG11B10F;    // DXGI_FORMAT_R11G11B10_FLOAT
+        case 28: return SG_PIXELFORMAT_RGBA8;       // DXGI_FORMAT_R8G8B8A8_UNORM
+        case 29: return SG_PIXELFORMAT_RGBA8;       // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+        case 30: return SG_PIXELFORMAT_RGBA8UI;
+        case 31: return SG_PIXELFORMAT_RGBA8SN;
+        case 32: return SG_PIXELFORMAT_RGBA8SI;
+        case 34: return SG_PIXELFORMAT_RG16F;       // DXGI_FORMAT_R16G16_FLOAT
+        case 35: return SG_PIXELFORMAT_RG16;
+        case 36: return SG_PIXELFORMAT_RG16UI;
+        case 37: return SG_PIXELFORMAT_RG16SN;
+        case 38: return SG_PIXELFORMAT_RG16SI;
+        case 41: return SG_PIXELFORMAT_R32F;        // DXGI_FORMAT_R32_FLOAT
+        case 42: return SG_PIXELFORMAT_R32UI;
+        case 43: return SG_PIXELFORMAT_R32SI;
+        case 49: return SG_PIXELFORMAT_RG8;         // DXGI_FORMAT_R8G8_UNORM
+        case 50: return SG_PIXELFORMAT_RG8UI;
+        case 51: return SG_PIXELFORMAT_RG8SN;
+        case 52: return SG_PIXELFORMAT_RG8SI;
+        case 54: return SG_PIXELFORMAT_R16F;        // DXGI_FORMAT_R16_FLOAT
+        case 56: return SG_PIXELFORMAT_R16;
+        case 57: return SG_PIXELFORMAT_R16UI;
+        case 58: return SG_PIXELFORMAT_R16SN;
+        case 59: return SG_PIXELFORMAT_R16SI;
+        case 61: return SG_PIXELFORMAT_R8;          // DXGI_FORMAT_R8_UNORM
+        case 62: return SG_PIXELFORMAT_R8UI;
+        case 63: return SG_PIXELFORMAT_R8SN;
+        case 64: return SG_PIXELFORMAT_R8SI;
+        case 71: case 72: return SG_PIXELFORMAT_BC1_RGBA;
+        case 74: case 75: return SG_PIXELFORMAT_BC2_RGBA;
+        case 77: case 78: return SG_PIXELFORMAT_BC3_RGBA;
+        case 80: return SG_PIXELFORMAT_BC4_R;
+        case 81: return SG_PIXELFORMAT_BC4_RSN;
+        case 83: return SG_PIXELFORMAT_BC5_RG;
+        case 84: return SG_PIXELFORMAT_BC5_RGSN;
+        case 87: case 91: return SG_PIXELFORMAT_BGRA8;  // DXGI_FORMAT_B8G8R8A8_UNORM(_SRGB)
+        case 95: return SG_PIXELFORMAT_BC6H_RGBUF;  // DXGI_FORMAT_BC6H_UF16
+        case 96: return SG_PIXELFORMAT_BC6H_RGBF;   // DXGI_FORMAT_BC6H_SF16
+        case 98: case 99: return SG_PIXELFORMAT_BC7_RGBA;
+        default: return SG_PIXELFORMAT_NONE;
+    }
+}
+
+/* map the legacy DDS_PIXELFORMAT struct to a sokol-gfx pixel format */
+static sg_pixel_format _stexf_dds_legacy_format(const uint8_t* pf) {
+    const uint32_t flags = _stexf_u32(pf + 4);
+    const uint32_t fourcc = _stexf_u32(pf + 8);
+    const uint32_t bit_count = _stexf_u32(pf + 12);
+    const uint32_t r_mask = _stexf_u32(pf + 16);
+    const uint32_t g_mask = _stexf_u32(pf + 20);
+    const uint32_t b_mask = _stexf_u32(pf + 24);
+    const uint32_t a_mask = _stexf_u32(pf + 28);
+    if (flags & _STEXF_DDPF_FOURCC) {
+        switch (fourcc) {
+            case _STEXF_FOURCC('D','X','T','1'): return SG_PIXELFORMAT_BC1_RGBA;
+            case _STEXF_FOURCC('D','X','T','2'):
+            case _STEXF_FOURCC('D','X','T','3'): return SG_PIXELFORMAT_BC2_RGBA;
+            case _STEXF_FOURCC('D','X','T','4'):
+            case _STEXF_FOURCC('D','X','T','5'): return SG_PIXELFORMAT_BC3_RGBA;
+            case _STEXF_FOURCC('A','T','I','1'):
+            case _STEXF_FOURCC('B','C','4','U'): return SG_PIXELFORMAT_BC4_R;
+            case _STEXF_FOURCC('B','C','4','S'): return SG_PIXELFORMAT_BC4_RSN;
+            case _STEXF_FOURCC('A','T','I','2'):
+            case _STEXF_FOURCC('B','C','5','U'): return SG_PIXELFORMAT_BC5_RG;
+            case _STEXF_FOURCC('B','C','5','S'): return SG_PIXELFORMAT_BC5_RGSN;
+            // D3DFORMAT values stored directly in the fourcc field
+            case 36:  return SG_PIXELFORMAT_RGBA16;     // D3DFMT_A16B16G16R16
+            case 110: return SG_PIXELFORMAT_RGBA16SN;   // D3DFMT_Q16W16V16U16
+            case 111: return SG_PIXELFORMAT_R16F;       // D3DFMT_R16F
+            case 112: return SG_PIXELFORMAT_RG16F;      // D3DFMT_G16R16F
+            case 113: return SG_PIXELFORMAT_RGBA16F;    // D3DFMT_A16B16G16R16F
+            case 114: return SG_PIXELFORMAT_R32F;       // D3DFMT_R32F
+            case 115: return SG_PIXELFORMAT_RG32F;      // D3DFMT_G32R32F
+            case 116: return SG_PIXELFORMAT_RGBA32F;    // D3DFMT_A32B32G32R32F
+            default:  return SG_PIXELFORMAT_NONE;
+        }
+    }
+    else if (flags & _STEXF_DDPF_RGB) {
+        if (bit_count == 32) {
+            if ((r_mask == 0x000000FF) && (g_mask == 0x0000FF00) && (b_mask == 0x00FF0000)) {
+                if ((a_mask == 0xFF000000) || ((flags & _STEXF_DDPF_ALPHAPIXELS) == 0)) {
+                    return SG_PIXELFORMAT_RGBA8;
+                }
+            }
+            else if ((r_mask == 0x00FF0000) && (g_mask == 0x0000FF00) && (b_mask == 0x000000FF)) {
+                if ((a_mask == 0xFF000000) || ((flags & _STEXF_DDPF_ALPHAPIXELS) == 0)) {
+                    return SG_PIXELFORMAT_BGRA8;
+                }
+            }
+            else if ((r_mask == 0x000003FF) && (g_mask == 0x000FFC00) && (b_mask == 0x3FF00000)) {
+                return SG_PIXELFORMAT_RGB10A2;
+            }
+            else if ((r_mask == 0x0000FFFF) && (g_mask == 0xFFFF0000) && (b_mask == 0)) {
+                return SG_PIXELFORMAT_RG16;
+            }
+        }
+        else if ((bit_count == 16) && (r_mask == 0x00FF) && (g_mask == 0xFF00) && (b_mask == 0)) {
+            return SG_PIXELFORMAT_RG8;
+        }
+        else if ((bit_count == 8) && (r_mask == 0xFF) && (g_mask == 0) && (b_mask == 0)) {
+            return SG_PIXELFORMAT_R8;
+        }
+    }
+    else if (flags & _STEXF_DDPF_LUMINANCE) {
+        if ((bit_count == 8) && (r_mask == 0xFF)) {
+            return SG_PIXELFORMAT_R8;
+        }
+        else if ((bit_count == 16) && (r_mask == 0xFFFF)) {
+            return SG_PIXELFORMAT_R16;
+        }
+    }
+    return SG_PIXELFORMAT_NONE;
+}
+
+static stexf_texture_t _stexf_parse_dds(const uint8_t* ptr, size_t size) {
+    stexf_texture_t tex = { 0 };
+    tex.container = STEXF_CONTAINER_DDS;
+    if (size < (4 + _STEXF_DDS_HEADER_SIZE)) {
+        return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+    }
+    const uint8_t* hdr = ptr + 4;
+    if (_stexf_u32(hdr) != _STEXF_DDS_HEADER_SIZE) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    const uint32_t flags = _stexf_u32(hdr + 4);
+    const uint32_t height = _stexf_u32(hdr + 8);
+    const uint32_t width = _stexf_u32(hdr + 12);
+    const uint32_t depth = _stexf_u32(hdr + 20);
+    const uint32_t mip_count = _stexf_u32(hdr + 24);
+    const uint8_t* pf = hdr + 72;
+    const uint32_t caps2 = _stexf_u32(hdr + 108);
+    size_t data_offset = 4 + _STEXF_DDS_HEADER_SIZE;
+
+    uint32_t num_layers = 1;
+    bool is_cube = false;
+    bool is_3d = false;
+    if ((_stexf_u32(pf + 4) & _STEXF_DDPF_FOURCC) && (_stexf_u32(pf + 8) == _STEXF_FOURCC('D','X','1','0'))) {
+        if (size < (data_offset + _STEXF_DDS_DX10_HEADER_SIZE)) {
+            return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+        }
+        const uint8_t* dx10 = ptr + data_offset;
+        data_offset += _STEXF_DDS_DX10_HEADER_SIZE;
+        tex.pixel_format = _stexf_dxgi_format(_stexf_u32(dx10));
+        const uint32_t dim = _stexf_u32(dx10 + 4);
+        is_cube = 0 != (_stexf_u32(dx10 + 8) & _STEXF_DDS_RESOURCE_MISC_TEXTURECUBE);
+        num_layers = _stexf_u32(dx10 + 12);
+        if (dim == _STEXF_DDS_DIMENSION_TEXTURE3D) {
+            is_3d = true;
+        }
+        else if (dim != _STEXF_DDS_DIMENSION_TEXTURE2D) {
+            return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+        }
+    }
+    else {
+        tex.pixel_format = _stexf_dds_legacy_format(pf);
+        if (caps2 & _STEXF_DDSCAPS2_CUBEMAP) {
+            if ((caps2 & _STEXF_DDSCAPS2_CUBEMAP_ALLFACES) != _STEXF_DDSCAPS2_CUBEMAP_ALLFACES) {
+                // partial cubemaps are not supported
+                return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+            }
+            is_cube = true;
+        }
+        is_3d = (0 != (caps2 & _STEXF_DDSCAPS2_VOLUME)) && (0 != (flags & _STEXF_DDSD_DEPTH));
+    }
+    if (is_cube && (num_layers > 1)) {
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+    }
+    if ((width > 0x7FFFFFFF) || (height > 0x7FFFFFFF) || (depth > 0x7FFFFFFF) || (num_layers > 0x7FFFFFFF)) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    tex.width = (int) width;
+    tex.height = (int) height;
+    tex.num_mipmaps = (mip_count == 0) ? 1 : (int) mip_count;
+    if (is_cube) {
+        tex.type = SG_IMAGETYPE_CUBE;
+        tex.num_slices = 1;
+    }
+    else if (is_3d) {
+        tex.type = SG_IMAGETYPE_3D;
+        tex.num_slices = (int) depth;
+    }
+    else if (num_layers > 1) {
+        tex.type = SG_IMAGETYPE_ARRAY;
+        tex.num_slices = (int) num_layers;
+    }
+    else {
+        tex.type = SG_IMAGETYPE_2D;
+        tex.num_slices = 1;
+    }
+    const stexf_error_t err = _stexf_validate(&tex);
+    if (err != STEXF_ERROR_NO_ERROR) {
+        return _stexf_error(tex, err);
+    }
+    if ((tex.type == SG_IMAGETYPE_ARRAY) && (tex.num_mipmaps > 1)) {
+        // array slices are stored with all their mipmaps, not contiguous per mipmap
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_LAYOUT);
+    }
+
+    // DDS data layout: for each face or array slice, for each mipmap (3D textures: all depth slices)
+    const int num_faces = (tex.type == SG_IMAGETYPE_CUBE) ? SG_CUBEFACE_NUM : 1;
+    size_t offset = data_offset;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < tex.num_mipmaps; mip_index++) {
+            const int mip_width = _stexf_mip_dim(tex.width, mip_index);
+            const int mip_height = _stexf_mip_dim(tex.height, mip_index);
+            int mip_slices = 1;
+            if (tex.type == SG_IMAGETYPE_3D) {
+                mip_slices = _stexf_mip_dim(tex.num_slices, mip_index);
+            }
+            else if (tex.type == SG_IMAGETYPE_ARRAY) {
+                mip_slices = tex.num_slices;
+            }
+            size_t mip_size, mip_end;
+            if (!_stexf_mip_size(tex.pixel_format, mip_width, mip_height, mip_slices, &mip_size) ||
+                !_stexf_add(offset, mip_size, &mip_end) || (mip_end > size))
+            {
+                return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+            }
+            tex.data.subimage[face_index][mip_index].ptr = ptr + offset;
+            tex.data.subimage[face_index][mip_index].size = mip_size;
+            offset += mip_size;
+        }
+    }
+    tex.valid = true;
+    return tex;
+}
+
+/*== KTX1 ====================================================================*/
+#define _STEXF_KTX_IDENTIFIER_SIZE (12)
+#define _STEXF_KTX1_HEADER_SIZE (64)
+#define _STEXF_KTX1_ENDIANNESS (0x04030201)
+
+static sg_pixel_format _stexf_gl_format(uint32_t gl_internal_format, uint32_t gl_format, uint32_t gl_type) {
+    switch (gl_internal_format) {
+        case 0x83F0: case 0x83F1: case 0x8C4C: case 0x8C4D: return SG_PIXELFORMAT_BC1_RGBA; // GL_COMPRESSED_(S)RGB(_ALPHA)_S3TC_DXT1
+        case 0x83F2: case 0x8C4E: return SG_PIXELFORMAT_BC2_RGBA;   // GL_COMPRESSED_(SRGB_ALPHA|RGBA)_S3TC_DXT3
+        case 0x83F3: case 0x8C4F: return SG_PIXELFORMAT_BC3_RGBA;   // GL_COMPRESSED_(SRGB_ALPHA|RGBA)_S3TC_DXT5
+        case 0x8DBB: return SG_PIXELFORMAT_BC4_R;                   // GL_COMPRESSED_RED_RGTC1
+        case 0x8DBC: return SG_PIXELFORMAT_BC4_RSN;                 // GL_COMPRESSED_SIGNED_RED_RGTC1
+        case 0x8DBD: return SG_PIXELFORMAT_BC5_RG;                  // GL_COMPRESSED_RG_RGTC2
+        case 0x8DBE: return SG_PIXELFORMAT_BC5_RGSN;                // GL_COMPRESSED_SIGNED_RG_RGTC2
+        case 0x8E8C: case 0x8E8D: return SG_PIXELFORMAT_BC7_RGBA;   // GL_COMPRESSED_(SRGB_ALPHA|RGBA)_BPTC_UNORM
+        case 0x8E8E: return SG_PIXELFORMAT_BC6H_RGBF;               // GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT
+        case 0x8E8F: return SG_PIXELFORMAT_BC6H_RGBUF;              // GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT
+        case 0x8C00: return SG_PIXELFORMAT_PVRTC_RGB_4BPP;          // GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG
+        case 0x8C01: return SG_PIXELFORMAT_PVRTC_RGB_2BPP;
+        case 0x8C02: return SG_PIXELFORMAT_PVRTC_RGBA_4BPP;
+        case 0x8C03: return SG_PIXELFORMAT_PVRTC_RGBA_2BPP;
+        case 0x8D64: case 0x9274: case 0x9275: return SG_PIXELFORMAT_ETC2_RGB8;  // GL_ETC1_RGB8_OES, GL_COMPRESSED_(S)RGB8_ETC2
+        case 0x9276: case 0x9277: return SG_PIXELFORMAT_ETC2_RGB8A1;             // GL_COMPRESSED_(S)RGB8_PUNCHTHROUGH_ALPHA1_ETC2
+        case 0x9278: case 0x9279: return SG_PIXELFORMAT_ETC2_RGBA8;              // GL_COMPRESSED_(SRGB8_ALPHA8|RGBA8)_ETC2_EAC
+        case 0x9272: return SG_PIXELFORMAT_ETC2_RG11;               // GL_COMPRESSED_RG11_EAC
+        case 0x9273: return SG_PIXELFORMAT_ETC2_RG11SN;             // GL_COMPRESSED_SIGNED_RG11_EAC
+        case 0x8229: return SG_PIXELFORMAT_R8;                      // GL_R8
+        case 0x8F94: return SG_PIXELFORMAT_R8SN;                    // GL_R8_SNORM
+        case 0x8232: return SG_PIXELFORMAT_R8UI;                    // GL_R8UI
+        case 0x8231: return SG_PIXELFORMAT_R8SI;                    // GL_R8I
+        case 0x822A: return SG_PIXELFORMAT_R16;                     // GL_R16
+        case 0x8F98: return SG_PIXELFORMAT_R16SN;                   // GL_R16_SNORM
+        case 0x8234: return SG_PIXELFORMAT_R16UI;                   // GL_R16UI
+        case 0x8233: return SG_PIXELFORMAT_R16SI;                   // GL_R16I
+        case 0x822D: return SG_PIXELFORMAT_R16F;                    // GL_R16F
+        case 0x822B: return SG_PIXELFORMAT_RG8;                     // GL_RG8
+        case 0x8F95: return SG_PIXELFORMAT_RG8SN;                   // GL_RG8_SNORM
+        case 0x8238: return SG_PIXELFORMAT_RG8UI;                   // GL_RG8UI
+        case 0x8237: return SG_PIXELFORMAT_RG8SI;                   // GL_RG8I
+        case 0x8236: return SG_PIXELFORMAT_R32UI;                   // GL_R32UI
+        case 0x8235: return SG_PIXELFORMAT_R32SI;                   // GL_R32I
+        case 0x822E: return SG_PIXELFORMAT_R32F;                    // GL_R32F
+        case 0x822C: return SG_PIXELFORMAT_RG16;                    // GL_RG16
+        case 0x8F99: return SG_PIXELFORMAT_RG16SN;                  // GL_RG16_SNORM
+        case 0x823A: return SG_PIXELFORMAT_RG16UI;                  // GL_RG16UI
+        case 0x8239: return SG_PIXELFORMAT_RG16SI;                  // GL_RG16I
+        case 0x822F: return SG_PIXELFORMAT_RG16F;                   // GL_RG16F
+        case 0x8058: case 0x8C43: return SG_PIXELFORMAT_RGBA8;      // GL_RGBA8, GL_SRGB8_ALPHA8
+        case 0x8F97: return SG_PIXELFORMAT_RGBA8SN;                 // GL_RGBA8_SNORM
+        case 0x8D7C: return SG_PIXELFORMAT_RGBA8UI;                 // GL_RGBA8UI
+        case 0x8D8E: return SG_PIXELFORMAT_RGBA8SI;                 // GL_RGBA8I
+        case 0x93A1: return SG_PIXELFORMAT_BGRA8;                   // GL_BGRA8_EXT
+        case 0x8059: return SG_PIXELFORMAT_RGB10A2;                 // GL_RGB10_A2
+        case 0x8C3A: return SG_PIXELFORMAT_RG11B10F;                // GL_R11F_G11F_B10F
+        case 0x823C: return SG_PIXELFORMAT_RG32UI;                  // GL_RG32UI
+        case 0x823B: return SG_PIXELFORMAT_RG32SI;                  // GL_RG32I
+        case 0x8230: return SG_PIXELFORMAT_RG32F;                   // GL_RG32F
+        case 0x805B: return SG_PIXELFORMAT_RGBA16;                  // GL_RGBA16
+        case 0x8F9B: return SG_PIXELFORMAT_RGBA16SN;                // GL_RGBA16_SNORM
+        case 0x8D76: return SG_PIXELFORMAT_RGBA16UI;                // GL_RGBA16UI
+        case 0x8D88: return SG_PIXELFORMAT_RGBA16SI;                // GL_RGBA16I
+        case 0x881A: return SG_PIXELFORMAT_RGBA16F;                 // GL_RGBA16F
+        case 0x8D70: return SG_PIXELFORMAT_RGBA32UI;                // GL_RGBA32UI
+        case 0x8D82: return SG_PIXELFORMAT_RGBA32SI;                // GL_RGBA32I
+        case 0x8814: return SG_PIXELFORMAT_RGBA32F;                 // GL_RGBA32F
+        case 0x1908:                                                // GL_RGBA (unsized)
+            if ((gl_format == 0x1908) && (gl_type == 0x1401)) {     // GL_RGBA + GL_UNSIGNED_BYTE
+                return SG_PIXELFORMAT_RGBA8;
+            }
+            return SG_PIXELFORMAT_NONE;
+        default:
+            return SG_PIXELFORMAT_NONE;
+    }
+}
+
+static stexf_texture_t _stexf_parse_ktx1(const uint8_t* ptr, size_t size) {
+    stexf_texture_t tex = { 0 };
+    tex.container = STEXF_CONTAINER_KTX1;
+    if (size < _STEXF_KTX1_HEADER_SIZE) {
+        return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+    }
+    const uint8_t* hdr = ptr + _STEXF_KTX_IDENTIFIER_SIZE;
+    if (_stexf_u32(hdr) != _STEXF_KTX1_ENDIANNESS) {
+        // big-endian files would need to be byte-swapped
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_LAYOUT);
+    }
+    const uint32_t gl_type = _stexf_u32(hdr + 4);
+    const uint32_t gl_format = _stexf_u32(hdr + 12);
+    const uint32_t gl_internal_format = _stexf_u32(hdr + 16);
+    const uint32_t width = _stexf_u32(hdr + 24);
+    const uint32_t height = _stexf_u32(hdr + 28);
+    const uint32_t depth = _stexf_u32(hdr + 32);
+    const uint32_t num_layers = _stexf_u32(hdr + 36);
+    const uint32_t num_faces = _stexf_u32(hdr + 40);
+    const uint32_t num_mips = _stexf_u32(hdr + 44);
+    const uint32_t kvd_size = _stexf_u32(hdr + 48);
+    if ((num_faces != 1) && (num_faces != 6)) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    if ((num_faces == 6) && (num_layers > 0)) {
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+    }
+    if ((height == 0) || ((depth > 0) && (num_layers > 0))) {
+        // 1D textures and 3D array textures
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+    }
+    if ((width > 0x7FFFFFFF) || (height > 0x7FFFFFFF) || (depth > 0x7FFFFFFF) || (num_layers > 0x7FFFFFFF)) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    tex.pixel_format = _stexf_gl_format(gl_internal_format, gl_format, gl_type);
+    tex.width = (int) width;
+    tex.height = (int) height;
+    tex.num_mipmaps = (num_mips == 0) ? 1 : (int) num_mips;
+    if (num_faces == 6) {
+        tex.type = SG_IMAGETYPE_CUBE;
+        tex.num_slices = 1;
+    }
+    else if (depth > 0) {
+        tex.type = SG_IMAGETYPE_3D;
+        tex.num_slices = (int) depth;
+    }
+    else if (num_layers > 0) {
+        tex.type = SG_IMAGETYPE_ARRAY;
+        tex.num_slices = (int) num_layers;
+    }
+    else {
+        tex.type = SG_IMAGETYPE_2D;
+        tex.num_slices = 1;
+    }
+    const stexf_error_t err = _stexf_validate(&tex);
+    if (err != STEXF_ERROR_NO_ERROR) {
+        return _stexf_error(tex, err);
+    }
+
+    // KTX1 data layout: for each mipmap: imageSize, then all array layers,
+    // cube faces (each padded to 4 bytes) and depth slices, then padding to 4 bytes
+    size_t offset;
+    if (!_stexf_add(_STEXF_KTX1_HEADER_SIZE, (size_t)kvd_size, &offset)) {
+        return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+    }
+    for (int mip_index = 0; mip_index < tex.num_mipmaps; mip_index++) {
+        if ((offset > size) || (4 > (size - offset))) {
+            return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+        }
+        const size_t image_size = _stexf_u32(ptr + offset);
+        offset += 4;
+        const int mip_width = _stexf_mip_dim(tex.width, mip_index);
+        const int mip_height = _stexf_mip_dim(tex.height, mip_index);
+        int mip_slices = 1;
+        if (tex.type == SG_IMAGETYPE_3D) {
+            mip_slices = _stexf_mip_dim(tex.num_slices, mip_index);
+        }
+        else if (tex.type == SG_IMAGETYPE_ARRAY) {
+            mip_slices = tex.num_slices;
+        }
+        size_t surface_size;
+        if (!_stexf_mip_size(tex.pixel_format, mip_width, mip_height, mip_slices, &surface_size)) {
+            return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+        }
+        if (image_size != surface_size) {
+            // rows are padded to 4 bytes, sokol-gfx expects tightly packed rows
+            return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_LAYOUT);
+        }
+        const size_t padded_size = (surface_size + 3) & ~(size_t)3;
+        for (uint32_t face_index = 0; face_index < num_faces; face_index++) {
+            if ((offset > size) || (surface_size > (size - offset))) {
+                return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+            }
+            tex.data.subimage[face_index][mip_index].ptr = ptr + offset;
+            tex.data.subimage[face_index][mip_index].size = surface_size;
+            offset += padded_size;
+        }
+    }
+    tex.valid = true;
+    return tex;
+}
+
+/*== KTX2 ====================================================================*/
+#define _STEXF_KTX2_HEADER_SIZE (80)
+#define _STEXF_KTX2_LEVEL_INDEX_ENTRY_SIZE (24)
+
+static sg_pixel_format _stexf_vk_format(uint32_t vk_fmt) {
+    switch (vk_fmt) {
+        case 9:   return SG_PIXELFORMAT_R8;             // VK_FORMAT_R8_UNORM
+        case 10:  return SG_PIXELFORMAT_R8SN;
+        case 13:  return SG_PIXELFORMAT_R8UI;
+        case 14:  return SG_PIXELFORMAT_R8SI;
+        case 15:  return SG_PIXELFORMAT_R8;             // VK_FORMAT_R8_SRGB
+        case 16:  return SG_PIXELFORMAT_RG8;            // VK_FORMAT_R8G8_UNORM
+        case 17:  return SG_PIXELFORMAT_RG8SN;
+        case 20:  return SG_PIXELFORMAT_RG8UI;
+        case 21:  return SG_PIXELFORMAT_RG8SI;
+        case 37:  return SG_PIXELFORMAT_RGBA8;          // VK_FORMAT_R8G8B8A8_UNORM
+        case 38:  return SG_PIXELFORMAT_RGBA8SN;
+        case 41:  return SG_PIXELFORMAT_RGBA8UI;
+        case 42:  return SG_PIXELFORMAT_RGBA8SI;
+        case 43:  return SG_PIXELFORMAT_RGBA8;          // VK_FORMAT_R8G8B8A8_SRGB
+        case 44:  case 50: return SG_PIXELFORMAT_BGRA8; // VK_FORMAT_B8G8R8A8_UNORM/SRGB
+        case 64:  return SG_PIXELFORMAT_RGB10A2;        // VK_FORMAT_A2B10G10R10_UNORM_PACK32
+        case 70:  return SG_PIXELFORMAT_R16;            // VK_FORMAT_R16_UNORM
+        case 71:  return SG_PIXELFORMAT_R16SN;
+        case 74:  return SG_PIXELFORMAT_R16UI;
+        case 75:  return SG_PIXELFORMAT_R16SI;
+        case 76:  return SG_PIXELFORMAT_R16F;
+        case 77:  return SG_PIXELFORMAT_RG16;           // VK_FORMAT_R16G16_UNORM
+        case 78:  return SG_PIXELFORMAT_RG16SN;
+        case 81:  return SG_PIXELFORMAT_RG16UI;
+        case 82:  return SG_PIXELFORMAT_RG16SI;
+        case 83:  return SG_PIXELFORMAT_RG16F;
+        case 91:  return SG_PIXELFORMAT_RGBA16;         // VK_FORMAT_R16G16B16A16_UNORM
+        case 92:  return SG_PIXELFORMAT_RGBA16SN;
+        case 95:  return SG_PIXELFORMAT_RGBA16UI;
+        case 96:  return SG_PIXELFORMAT_RGBA16SI;
+        case 97:  return SG_PIXELFORMAT_RGBA16F;
+        case 98:  return SG_PIXELFORMAT_R32UI;          // VK_FORMAT_R32_UINT
+        case 99:  return SG_PIXELFORMAT_R32SI;
+        case 100: return SG_PIXELFORMAT_R32F;
+        case 101: return SG_PIXELFORMAT_RG32UI;         // VK_FORMAT_R32G32_UINT
+        case 102: return SG_PIXELFORMAT_RG32SI;
+        case 103: return SG_PIXELFORMAT_RG32F;
+        case 107: return SG_PIXELFORMAT_RGBA32UI;       // VK_FORMAT_R32G32B32A32_UINT
+        case 108: return SG_PIXELFORMAT_RGBA32SI;
+        case 109: return SG_PIXELFORMAT_RGBA32F;
+        case 122: return SG_PIXELFORMAT_RG11B10F;       // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+        case 131: case 132: case 133: case 134: return SG_PIXELFORMAT_BC1_RGBA;
+        case 135: case 136: return SG_PIXELFORMAT_BC2_RGBA;
+        case 137: case 138: return SG_PIXELFORMAT_BC3_RGBA;
+        case 139: return SG_PIXELFORMAT_BC4_R;
+        case 140: return SG_PIXELFORMAT_BC4_RSN;
+        case 141: return SG_PIXELFORMAT_BC5_RG;
+        case 142: return SG_PIXELFORMAT_BC5_RGSN;
+        case 143: return SG_PIXELFORMAT_BC6H_RGBUF;     // VK_FORMAT_BC6H_UFLOAT_BLOCK
+        case 144: return SG_PIXELFORMAT_BC6H_RGBF;      // VK_FORMAT_BC6H_SFLOAT_BLOCK
+        case 145: case 146: return SG_PIXELFORMAT_BC7_RGBA;
+        case 147: case 148: return SG_PIXELFORMAT_ETC2_RGB8;
+        case 149: case 150: return SG_PIXELFORMAT_ETC2_RGB8A1;
+        case 151: case 152: return SG_PIXELFORMAT_ETC2_RGBA8;
+        case 155: return SG_PIXELFORMAT_ETC2_RG11;      // VK_FORMAT_EAC_R11G11_UNORM_BLOCK
+        case 156: return SG_PIXELFORMAT_ETC2_RG11SN;
+        case 1000054000: case 1000054004: return SG_PIXELFORMAT_PVRTC_RGBA_2BPP;   // VK_FORMAT_PVRTC1_2BPP_(UNORM|SRGB)_BLOCK_IMG
+        case 1000054001: case 1000054005: return SG_PIXELFORMAT_PVRTC_RGBA_4BPP;   // VK_FORMAT_PVRTC1_4BPP_(UNORM|SRGB)_BLOCK_IMG
+        default: return SG_PIXELFORMAT_NONE;
+    }
+}
+
+static stexf_texture_t _stexf_parse_ktx2(const uint8_t* ptr, size_t size) {
+    stexf_texture_t tex = { 0 };
+    tex.container = STEXF_CONTAINER_KTX2;
+    if (size < _STEXF_KTX2_HEADER_SIZE) {
+        return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+    }
+    const uint8_t* hdr = ptr + _STEXF_KTX_IDENTIFIER_SIZE;
+    const uint32_t vk_format = _stexf_u32(hdr);
+    const uint32_t width = _stexf_u32(hdr + 8);
+    const uint32_t height = _stexf_u32(hdr + 12);
+    const uint32_t depth = _stexf_u32(hdr + 16);
+    const uint32_t num_layers = _stexf_u32(hdr + 20);
+    const uint32_t num_faces = _stexf_u32(hdr + 24);
+    const uint32_t num_levels = _stexf_u32(hdr + 28);
+    const uint32_t supercompression = _stexf_u32(hdr + 32);
+    if (supercompression != 0) {
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_SUPERCOMPRESSION);
+    }
+    if (vk_format == 0) {
+        // VK_FORMAT_UNDEFINED is used for Basis Universal payloads
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+    if ((num_faces != 1) && (num_faces != 6)) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    if ((num_faces == 6) && (num_layers > 0)) {
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+    }
+    if ((height == 0) || ((depth > 0) && (num_layers > 0))) {
+        return _stexf_error(tex, STEXF_ERROR_UNSUPPORTED_IMAGE_TYPE);
+    }
+    if ((width > 0x7FFFFFFF) || (height > 0x7FFFFFFF) || (depth > 0x7FFFFFFF) || (num_layers > 0x7FFFFFFF)) {
+        return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+    }
+    tex.pixel_format = _stexf_vk_format(vk_format);
+    tex.width = (int) width;
+    tex.height = (int) height;
+    tex.num_mipmaps = (num_levels == 0) ? 1 : (int) num_levels;
+    if (num_faces == 6) {
+        tex.type = SG_IMAGETYPE_CUBE;
+        tex.num_slices = 1;
+    }
+    else if (depth > 0) {
+        tex.type = SG_IMAGETYPE_3D;
+        tex.num_slices = (int) depth;
+    }
+    else if (num_layers > 0) {
+        tex.type = SG_IMAGETYPE_ARRAY;
+        tex.num_slices = (int) num_layers;
+    }
+    else {
+        tex.type = SG_IMAGETYPE_2D;
+        tex.num_slices = 1;
+    }
+    const stexf_error_t err = _stexf_validate(&tex);
+    if (err != STEXF_ERROR_NO_ERROR) {
+        return _stexf_error(tex, err);
+    }
+    const size_t level_index_size = (size_t)tex.num_mipmaps * _STEXF_KTX2_LEVEL_INDEX_ENTRY_SIZE;
+    if ((_STEXF_KTX2_HEADER_SIZE + level_index_size) > size) {
+        return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+    }
+
+    // KTX2 level index starts with the base level, each level contains all
+    // array layers, cube faces and depth slices tightly packed
+    const uint8_t* level_index = ptr + _STEXF_KTX2_HEADER_SIZE;
+    for (int mip_index = 0; mip_index < tex.num_mipmaps; mip_index++) {
+        const uint8_t* entry = level_index + mip_index * _STEXF_KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        const uint64_t level_offset = _stexf_u64(entry);
+        const uint64_t level_size = _stexf_u64(entry + 8);
+        if ((level_offset > size) || (level_size > (size - level_offset))) {
+            return _stexf_error(tex, STEXF_ERROR_TRUNCATED);
+        }
+        const int mip_width = _stexf_mip_dim(tex.width, mip_index);
+        const int mip_height = _stexf_mip_dim(tex.height, mip_index);
+        int mip_slices = 1;
+        if (tex.type == SG_IMAGETYPE_3D) {
+            mip_slices = _stexf_mip_dim(tex.num_slices, mip_index);
+        }
+        else if (tex.type == SG_IMAGETYPE_ARRAY) {
+            mip_slices = tex.num_slices;
+        }
+        size_t surface_size, faces_size;
+        if (!_stexf_mip_size(tex.pixel_format, mip_width, mip_height, mip_slices, &surface_size) ||
+            !_stexf_mul(surface_size, num_faces, &faces_size) || (level_size != faces_size))
+        {
+            return _stexf_error(tex, STEXF_ERROR_INVALID_HEADER);
+        }
+        for (uint32_t face_index = 0; face_index < num_faces; face_index++) {
+            tex.data.subimage[face_index][mip_index].ptr = ptr + (size_t)level_offset + face_index * surface_size;
+            tex.data.subimage[face_index][mip_index].size = surface_size;
+        }
+    }
+    tex.valid = true;
+    return tex;
+}
+
+/*== PUBLIC API FUNCTIONS ====================================================*/
+SOKOL_API_IMPL stexf_texture_t stexf_parse(const sg_range* data) {
+    SOKOL_ASSERT(data && data->ptr);
+    static const uint8_t ktx1_identifier[_STEXF_KTX_IDENTIFIER_SIZE] = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    static const uint8_t ktx2_identifier[_STEXF_KTX_IDENTIFIER_SIZE] = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+    const uint8_t* ptr = (const uint8_t*) data->ptr;
+    const size_t size = data->size;
+    if ((size >= 4) && (_stexf_u32(ptr) == _STEXF_FOURCC('D','D','S',' '))) {
+        return _stexf_parse_dds(ptr, size);
+    }
+    else if ((size >= _STEXF_KTX_IDENTIFIER_SIZE) && (0 == memcmp(ptr, ktx1_identifier, _STEXF_KTX_IDENTIFIER_SIZE))) {
+        return _stexf_parse_ktx1(ptr, size);
+    }
+    else if ((size >= _STEXF_KTX_IDENTIFIER_SIZE) && (0 == memcmp(ptr, ktx2_identifier, _STEXF_KTX_IDENTIFIER_SIZE))) {
+        return _stexf_parse_ktx2(ptr, size);
+    }
+    else {
+        stexf_texture_t tex = { 0 };
+        return _stexf_error(tex, STEXF_ERROR_UNKNOWN_CONTAINER);
+    }
+}
+
+SOKOL_API_IMPL sg_image_desc stexf_image_desc(const stexf_texture_t* tex) {
+    SOKOL_ASSERT(tex && tex->valid);
+    sg_image_desc desc = { 0 };
+    if (tex->valid) {
+        desc.type = tex->type;
+        desc.width = tex->width;
+        desc.height = tex->height;
+        desc.num_slices = tex->num_slices;
+        desc.num_mipmaps = tex->num_mipmaps;
+        desc.pixel_format = tex->pixel_format;
+        desc.data = tex->data;
+    }
+    return desc;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#endif // SOKOL_TEXFILE_IMPL